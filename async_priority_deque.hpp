@@ -0,0 +1,390 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file async_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    async_priority_deque.hpp provides the class async_priority_deque, a
+//  priority deque that can merge a large batch of elements on a worker thread
+//  while it continues to serve pushes and pops.
+//    The batch is staged in a sequence of its own, and made into an interval
+//  heap by the worker (using threads of its own, if
+//  BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD is true). Until then, the deque
+//  knows only the least and greatest elements of the batch; a removal that
+//  needs one of them waits for the worker. Once ready, the staged heap is
+//  served directly, and is folded into the main heap when that is cheap.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior. The worker thread touches only the staged batch.
+//  @par Exception safety:
+//    As for priority_deque. If arranging a batch fails, the batch is discarded
+//  and the exception is thrown by the operation that waits for it.
+*/
+
+#ifndef BOOST_CONTAINER_ASYNC_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_ASYNC_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error async_priority_deque.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error async_priority_deque.hpp requires C++11 (for std::thread).
+#endif
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//-------------------------Async Priority Deque Class--------------------------|
+/*! @brief Priority deque that arranges merged batches on a worker thread.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param Sequence Underlying sequence container, as for priority_deque.
+ *  @param Compare Comparison class, as for priority_deque.
+ *  @details At most one batch is staged at a time. Operations check whether
+ *  the worker has finished without waiting for it; only removing an extreme
+ *  that belongs to the batch, merging another batch, or wait() will wait.
+ *  @note Elements of a staged batch are not visited by iterators, so none are
+ *  provided.
+ *  @see priority_deque
+ */
+template <typename Type, typename Sequence =std::vector<Type>,
+          typename Compare =::std::less<typename Sequence::value_type> >
+class async_priority_deque
+  : private priority_deque<Type, Sequence, Compare>
+{
+  typedef priority_deque<Type, Sequence, Compare>                   base_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef typename base_type::container_type          container_type;
+  typedef typename base_type::value_type              value_type;
+  typedef typename base_type::value_compare           value_compare;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::const_reference         const_reference;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty priority deque.
+  explicit async_priority_deque       (Compare const & comp =Compare())
+    : base_type(comp), staged_() {}
+  async_priority_deque                (async_priority_deque const &) = delete;
+  async_priority_deque & operator=    (async_priority_deque const &) = delete;
+//! @brief Waits for any staged batch.
+  ~async_priority_deque               (void)
+  {
+    if (staged_ && staged_->worker.joinable())
+      staged_->worker.join();
+  }
+//-----------------------------Restricted Access-------------------------------|
+/** @brief Adds an element to the main heap.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the main heap.
+//  @par  Exception safety:
+//    Strong.
+*/
+  void                    push        (value_type const & value)
+  {
+    poll();
+    base_type::push(value);
+  }
+//!@overload
+  void                    push        (value_type && value)
+  {
+    poll();
+    base_type::push(std::move(value));
+  }
+/** @brief Stages a batch of elements, to be arranged on a worker thread.
+//  @details Waits for any batch already staged. The batch is scanned for its
+//  least and greatest elements before the worker starts.
+//  @post The deque contains its original elements, and those of the batch.
+//  @par  Complexity:
+//    O(k) comparisons on the size of the batch, and no moves. Arranging it
+//  (O(k)) is done by the worker.
+//  @par  Exception safety:
+//    Basic.
+*/
+  void                    merge_async (container_type && batch);
+//! @overload
+  template <typename InputIterator>
+  void                    merge_async (InputIterator first, InputIterator last)
+  {
+    merge_async(container_type(first, last));
+  }
+//! @brief Accesses a maximal element, of the main heap or the staged batch.
+  const_reference         maximum     (void) const;
+//! @brief Accesses a minimal element, of the main heap or the staged batch.
+  const_reference         minimum     (void) const;
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline const_reference  top         (void) const  { return maximum(); }
+/** @brief Removes a maximal element from the deque.
+//  @par  Complexity:
+//    O(log n). If the element belongs to a batch still being arranged, waits
+//  for the worker first.
+*/
+  void                    pop_maximum (void);
+/** @brief Removes a minimal element from the deque.
+//  @par  Complexity:
+//    O(log n). If the element belongs to a batch still being arranged, waits
+//  for the worker first.
+*/
+  void                    pop_minimum (void);
+//! @details Identical to std::priority_queue pop(). @see @a pop_maximum
+  inline void             pop         (void)        { pop_maximum(); }
+//----------------------------------Staging------------------------------------|
+/** @brief Returns true if a batch is still being arranged by the worker.
+//  @details False as soon as the worker finishes, even if the batch has not
+//  yet been folded into the main heap (which the next operation does).
+*/
+  bool                    merging     (void) const
+  {
+    return staged_ && staged_->worker.joinable() &&
+           !staged_->done.load(std::memory_order_acquire);
+  }
+//! @brief Waits for any staged batch, and folds it into the main heap.
+  void                    wait        (void);
+
+//! @brief Returns true if the priority deque is empty, false if it is not.
+  inline bool             empty       (void) const  { return size() == 0; }
+//! @brief Returns the number of elements, including any staged batch.
+  inline size_type        size        (void) const
+  {
+    return base_type::size() + (staged_ ? staged_->size : 0);
+  }
+  using base_type::max_size;
+//! @brief Removes all elements from the priority deque.
+  void                    clear       (void)
+  {
+    discard();
+    base_type::clear();
+  }
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = true;
+  static const bool is_stable             = false;
+  static const bool has_reserve           = false;
+//---------------------------------Private-------------------------------------|
+ private:
+  typedef heap::interval_heap_internal::heap_compare<Compare, Type> adapted;
+//! @brief A batch, and the worker arranging it.
+  struct staging
+  {
+    container_type batch;
+//  Copies of the least and greatest elements, read while the worker runs.
+    container_type extremes;
+    size_type size;
+    std::atomic<bool> done;
+    std::exception_ptr error;
+    std::thread worker;
+  };
+//! @brief Runs in the worker thread.
+  static void             arrange     (staging * stage, value_compare comp)
+  {
+    try {
+      heap::make_interval_heap(stage->batch.begin(), stage->batch.end(), comp);
+    } catch (...) {
+      stage->error = std::current_exception();
+    }
+    stage->done.store(true, std::memory_order_release);
+  }
+  bool                    less        (value_type const & lhs,
+                                       value_type const & rhs) const
+  {
+    return adapted::adapt(base_type::compare())(lhs, rhs);
+  }
+//! @brief Least staged element. The batch must be staged.
+  const_reference         staged_min  (void) const
+  {
+    return staged_->worker.joinable() ? staged_->extremes.front()
+                                      : staged_->batch.front();
+  }
+//! @brief Greatest staged element. The batch must be staged.
+  const_reference         staged_max  (void) const
+  {
+    if (staged_->worker.joinable())
+      return staged_->extremes.back();
+    return (staged_->size > 1) ? *(staged_->batch.begin() + 1)
+                               : staged_->batch.front();
+  }
+//! @brief Folds the staged heap in if the worker has finished. Never waits.
+  void                    poll        (void)
+  {
+    if (staged_ && staged_->worker.joinable() &&
+        staged_->done.load(std::memory_order_acquire))
+      join();
+    if (staged_ && !staged_->worker.joinable())
+      fold(false);
+  }
+//! @brief Waits for the worker, and rethrows any exception it caught.
+  void                    join        (void);
+//! @brief Folds the staged heap into the main heap, if @a forced or cheap.
+  void                    fold        (bool forced);
+//! @brief Waits for the worker, and discards the batch.
+  void                    discard     (void)
+  {
+    if (staged_ && staged_->worker.joinable())
+      staged_->worker.join();
+    staged_.reset();
+  }
+
+  std::unique_ptr<staging> staged_;
+};
+
+//-----------------------------Restricted Access-------------------------------|
+template <typename T, typename S, typename C>
+void async_priority_deque<T, S, C>::merge_async (container_type && batch)
+{
+  if (staged_)
+    wait();
+  if (batch.empty())
+    return;
+  std::unique_ptr<staging> stage (new staging);
+  stage->batch = std::move(batch);
+  stage->size = stage->batch.size();
+  typename container_type::const_iterator least = stage->batch.begin(),
+                                          greatest = least;
+  for (typename container_type::const_iterator it = least + 1;
+       it != stage->batch.end(); ++it)
+  {
+    if (less(*it, *least))
+      least = it;
+    else if (less(*greatest, *it))
+      greatest = it;
+  }
+  stage->extremes.push_back(*least);
+  stage->extremes.push_back(*greatest);
+  stage->done.store(false, std::memory_order_relaxed);
+  stage->worker = std::thread(&arrange, stage.get(), base_type::compare());
+  staged_ = std::move(stage);
+}
+
+template <typename T, typename S, typename C>
+typename async_priority_deque<T, S, C>::const_reference
+  async_priority_deque<T, S, C>::maximum (void) const
+{
+  if (staged_ && (base_type::empty() ||
+                  less(base_type::maximum(), staged_max())))
+    return staged_max();
+  return base_type::maximum();
+}
+
+template <typename T, typename S, typename C>
+typename async_priority_deque<T, S, C>::const_reference
+  async_priority_deque<T, S, C>::minimum (void) const
+{
+  if (staged_ && (base_type::empty() ||
+                  less(staged_min(), base_type::minimum())))
+    return staged_min();
+  return base_type::minimum();
+}
+
+template <typename T, typename S, typename C>
+void async_priority_deque<T, S, C>::pop_maximum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no maximal element. Removal undefined.");
+  poll();
+  if (staged_ && (base_type::empty() ||
+                  less(base_type::maximum(), staged_max()))) {
+    if (staged_->worker.joinable())
+      join();
+    container_type & batch = staged_->batch;
+    heap::pop_interval_heap_max(batch.begin(), batch.end(),
+                                base_type::compare());
+    batch.pop_back();
+    --staged_->size;
+    fold(false);
+  } else
+    base_type::pop_maximum();
+}
+
+template <typename T, typename S, typename C>
+void async_priority_deque<T, S, C>::pop_minimum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no minimal element. Removal undefined.");
+  poll();
+  if (staged_ && (base_type::empty() ||
+                  less(staged_min(), base_type::minimum()))) {
+    if (staged_->worker.joinable())
+      join();
+    container_type & batch = staged_->batch;
+    heap::pop_interval_heap_min(batch.begin(), batch.end(),
+                                base_type::compare());
+    batch.pop_back();
+    --staged_->size;
+    fold(false);
+  } else
+    base_type::pop_minimum();
+}
+
+//----------------------------------Staging------------------------------------|
+template <typename T, typename S, typename C>
+void async_priority_deque<T, S, C>::wait (void)
+{
+  if (!staged_)
+    return;
+  if (staged_->worker.joinable())
+    join();
+  fold(true);
+}
+
+template <typename T, typename S, typename C>
+void async_priority_deque<T, S, C>::join (void)
+{
+  staged_->worker.join();
+  if (staged_->error) {
+    std::exception_ptr error = staged_->error;
+    staged_.reset();
+    std::rethrow_exception(error);
+  }
+}
+
+/*    Folding pushes the elements of the smaller heap into the larger. That
+//  costs O(m log n), for m elements in the smaller heap, and is done
+//  unprompted only while it is no more than the O(n) of rearranging both.
+//  Until then, both heaps are served, each in O(log n).
+*/
+template <typename T, typename S, typename C>
+void async_priority_deque<T, S, C>::fold (bool forced)
+{
+  container_type & batch = staged_->batch;
+  container_type & main = base_type::sequence();
+  const size_type total = batch.size() + main.size();
+  const size_type smaller = (batch.size() < main.size()) ? batch.size()
+                                                         : main.size();
+  size_type log_total = 0;
+  for (size_type n = total; n > 1; n >>= 1)
+    ++log_total;
+  if (smaller * log_total > total) {
+    if (!forced)
+      return;
+//  As in priority_deque::insert.
+    base_type::insert(std::make_move_iterator(batch.begin()),
+                      std::make_move_iterator(batch.end()));
+  } else {
+    if (batch.size() > main.size())
+      main.swap(batch);
+    for (typename container_type::iterator it = batch.begin();
+         it != batch.end(); ++it)
+      base_type::push(std::move(*it));
+  }
+  staged_.reset();
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
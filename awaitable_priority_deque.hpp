@@ -0,0 +1,439 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file awaitable_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    awaitable_priority_deque.hpp provides the class awaitable_priority_deque,
+//  a priority deque from which coroutines may await elements:
+//  @code
+//    std::optional<job> next = co_await jobs.pop_maximum(100ms);
+//  @endcode
+//    A coroutine that finds the deque empty joins a queue of waiters. There
+//  are waiters only while the deque is empty, so a pushed element is then
+//  both the least and the greatest, and is handed to the first waiter
+//  directly, without entering the deque. The producer resumes the waiter
+//  itself, before its push returns.
+//    A wait may be cancelled through a std::stop_token, or given a deadline.
+//  Deadlines are kept in a timer_queue; the deque does not watch the clock,
+//  so the event loop calls expire_until, sleeping until next_deadline.
+//  @par  Thread safety:
+//    All member functions may be called from any thread. A waiter is resumed
+//  on the thread that pushes its element, expires its deadline, or requests
+//  its stop.
+//  @par Exception safety:
+//    As for priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_AWAITABLE_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_AWAITABLE_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error awaitable_priority_deque.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 202002L) || !defined(__cpp_impl_coroutine)
+#error awaitable_priority_deque.hpp requires C++20 (for coroutines).
+#endif
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdint.h>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include "priority_deque.hpp"
+#include "timer_queue.hpp"
+
+namespace boost {
+namespace container {
+//---------------------Awaitable Priority Deque Class--------------------------|
+/*! @brief Priority deque from which coroutines may await elements.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque. Must be movable.
+ *  @param Sequence Underlying sequence container, as for priority_deque.
+ *  @param Compare Comparison class, as for priority_deque.
+ *  @param Clock Clock of deadlines. Defaults to std::chrono::steady_clock.
+ *  @details Waiters are served in the order they began to wait. The deque
+ *  must outlive its waiters.
+ *  @see priority_deque, timer_queue
+ */
+template <typename Type, typename Sequence =std::vector<Type>,
+          typename Compare =::std::less<Type>,
+          typename Clock =::std::chrono::steady_clock>
+class awaitable_priority_deque
+{
+  struct waiter;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef priority_deque<Type, Sequence, Compare>     deque_type;
+  typedef typename deque_type::value_type             value_type;
+  typedef typename deque_type::size_type              size_type;
+  typedef Compare                                     value_compare;
+  typedef Clock                                       clock_type;
+  typedef typename Clock::time_point                  time_point;
+/** @brief Awaitable removal of an extreme element.
+//  @details If @a Optional, co_await yields std::optional<value_type>, which
+//  is empty if the wait was cancelled or timed out. Otherwise, it yields
+//  value_type.
+*/
+  template <bool Optional>
+  class pop_awaiter;
+//-------------------------------Constructors----------------------------------|
+  explicit awaitable_priority_deque   (Compare const & comp =Compare())
+    : deque_(comp), first_(nullptr), last_(nullptr), waiting_(0),
+      handoffs_(0) {}
+  awaitable_priority_deque            (awaitable_priority_deque const &)
+                                                                      =delete;
+  awaitable_priority_deque & operator=(awaitable_priority_deque const &)
+                                                                      =delete;
+//--------------------------------Producers------------------------------------|
+/** @brief Adds an element, or hands it to the first waiter and resumes it.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the number of timed waiters, or on the size of
+//  the deque.
+*/
+  void                    push        (value_type const & value)
+  {
+    emplace(value);
+  }
+//!@overload
+  void                    push        (value_type && value)
+  {
+    emplace(std::move(value));
+  }
+//! @brief As push, but constructs the element in place.
+  template <typename... Args>
+  void                    emplace     (Args &&... args);
+//--------------------------------Consumers------------------------------------|
+/** @brief Awaits a maximal element.
+//  @details co_await yields the element. The wait can be neither cancelled nor
+//  timed out.
+*/
+  pop_awaiter<false>      pop_maximum (void)
+  {
+    return pop_awaiter<false>(*this, true, std::stop_token(), nullptr);
+  }
+//! @brief Awaits a maximal element, unless @a stop is requested first.
+  pop_awaiter<true>       pop_maximum (std::stop_token stop)
+  {
+    return pop_awaiter<true>(*this, true, std::move(stop), nullptr);
+  }
+//! @brief Awaits a maximal element, until @a deadline or until @a stop.
+  pop_awaiter<true>       pop_maximum (time_point const & deadline,
+                                       std::stop_token stop ={})
+  {
+    return pop_awaiter<true>(*this, true, std::move(stop), &deadline);
+  }
+//! @brief Awaits a maximal element, for at most @a timeout.
+  template <typename Rep, typename Period>
+  pop_awaiter<true>       pop_maximum (std::chrono::duration<Rep, Period>
+                                         const & timeout,
+                                       std::stop_token stop ={})
+  {
+    return pop_maximum(deadline_after(timeout), std::move(stop));
+  }
+//! @brief Awaits a minimal element. @see pop_maximum
+  pop_awaiter<false>      pop_minimum (void)
+  {
+    return pop_awaiter<false>(*this, false, std::stop_token(), nullptr);
+  }
+//!@overload
+  pop_awaiter<true>       pop_minimum (std::stop_token stop)
+  {
+    return pop_awaiter<true>(*this, false, std::move(stop), nullptr);
+  }
+//!@overload
+  pop_awaiter<true>       pop_minimum (time_point const & deadline,
+                                       std::stop_token stop ={})
+  {
+    return pop_awaiter<true>(*this, false, std::move(stop), &deadline);
+  }
+//!@overload
+  template <typename Rep, typename Period>
+  pop_awaiter<true>       pop_minimum (std::chrono::duration<Rep, Period>
+                                         const & timeout,
+                                       std::stop_token stop ={})
+  {
+    return pop_minimum(deadline_after(timeout), std::move(stop));
+  }
+/** @brief Removes a maximal element, if there is one, without waiting.
+//  @return True if an element was moved into @a out.
+*/
+  bool                    try_pop_maximum (value_type & out)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (deque_.empty())
+      return false;
+    deque_.pop_maximum_n(1, &out);
+    return true;
+  }
+//! @brief Removes a minimal element, if there is one, without waiting.
+  bool                    try_pop_minimum (value_type & out)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (deque_.empty())
+      return false;
+    deque_.pop_minimum_n(1, &out);
+    return true;
+  }
+//---------------------------------Deadlines-----------------------------------|
+/** @brief Resumes, with nothing, every waiter whose deadline is not after
+//  @a now.
+//  @return The number of waiters resumed.
+//  @par  Complexity:
+//    O(k log n) for k expired waiters, of n timed waiters.
+*/
+  size_type               expire_until(time_point const & now);
+/** @brief Copies the earliest deadline of any waiter into @a out.
+//  @return False if no waiter has a deadline.
+*/
+  bool                    next_deadline   (time_point & out) const
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (timers_.empty())
+      return false;
+    out = timers_.next_deadline();
+    return true;
+  }
+//-----------------------------------Size--------------------------------------|
+//! @brief Returns the number of elements in the deque.
+  size_type               size        (void) const
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    return deque_.size();
+  }
+//! @brief Returns true if the deque holds no elements.
+  bool                    empty       (void) const { return size() == 0; }
+//! @brief Returns the number of coroutines waiting for an element.
+  size_type               waiting     (void) const
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    return waiting_;
+  }
+//! @brief Returns the number of elements handed directly to a waiter.
+  size_type               handoffs    (void) const
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    return handoffs_;
+  }
+//---------------------------------Private-------------------------------------|
+ private:
+  struct waiter
+  {
+    std::coroutine_handle<> handle;
+    std::optional<value_type> result;
+    waiter * previous;
+    waiter * next;
+    uint64_t timer;
+    bool queued;
+    bool cancelled;
+  };
+//  Output iterator that constructs a popped element into a waiter's result,
+//  so that pop_maximum_n and pop_minimum_n can move it there directly.
+  struct result_writer
+  {
+    std::optional<value_type> * result;
+    result_writer & operator* (void) { return *this; }
+    result_writer & operator++ (void) { return *this; }
+    result_writer & operator= (value_type && value)
+    {
+      result->emplace(std::move(value));
+      return *this;
+    }
+    result_writer & operator= (value_type const & value)
+    {
+      result->emplace(value);
+      return *this;
+    }
+  };
+  template <typename Rep, typename Period>
+  static time_point deadline_after (std::chrono::duration<Rep, Period>
+                                      const & timeout)
+  {
+    return Clock::now() + std::chrono::duration_cast<
+                            typename Clock::duration>(timeout);
+  }
+//  These are called with lock_ held.
+  void link (waiter * w)
+  {
+    w->previous = last_;
+    w->next = nullptr;
+    (last_ ? last_->next : first_) = w;
+    last_ = w;
+    w->queued = true;
+    ++waiting_;
+  }
+  void unlink (waiter * w)
+  {
+    (w->previous ? w->previous->next : first_) = w->next;
+    (w->next ? w->next->previous : last_) = w->previous;
+    w->queued = false;
+    --waiting_;
+  }
+  void release_timer (waiter * w)
+  {
+    if (w->timer)
+      timers_.cancel(w->timer);
+    w->timer = 0;
+  }
+//  Stops a wait, if it has not ended. Run by the waiter's stop_callback.
+  void cancel (waiter * w)
+  {
+    std::unique_lock<std::mutex> lock (lock_);
+    w->cancelled = true;
+    if (!w->queued)
+      return;
+    unlink(w);
+    release_timer(w);
+    lock.unlock();
+    w->handle.resume();
+  }
+//  Removes a waiter whose coroutine was destroyed while it waited.
+  void forget (waiter * w)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (w->queued)
+    {
+      unlink(w);
+      release_timer(w);
+    }
+  }
+
+  mutable std::mutex lock_;
+  deque_type deque_;
+  waiter * first_;
+  waiter * last_;
+  size_type waiting_;
+  size_type handoffs_;
+  timer_queue<time_point, waiter *> timers_;
+};
+
+//------------------------------Pop Awaiter------------------------------------|
+template <typename T, typename S, typename C, typename K>
+template <bool Optional>
+class awaitable_priority_deque<T, S, C, K>::pop_awaiter
+{
+  struct canceller
+  {
+    pop_awaiter * self;
+    void operator() (void) const { self->deque_.cancel(&self->waiter_); }
+  };
+ public:
+  pop_awaiter (awaitable_priority_deque & deque, bool maximal,
+               std::stop_token stop, time_point const * deadline)
+    : deque_(deque), stop_(std::move(stop)), maximal_(maximal),
+      timed_(deadline != nullptr), suspended_(false),
+      deadline_(deadline ? *deadline : time_point())
+  {
+    waiter_.previous = waiter_.next = nullptr;
+    waiter_.timer = 0;
+    waiter_.queued = waiter_.cancelled = false;
+  }
+  pop_awaiter (pop_awaiter const &) = delete;
+  pop_awaiter & operator= (pop_awaiter const &) = delete;
+  ~pop_awaiter (void)
+  {
+    stopper_.reset();
+    if (suspended_)
+      deque_.forget(&waiter_);
+  }
+
+  bool await_ready (void) const noexcept { return false; }
+  bool await_suspend (std::coroutine_handle<> handle);
+  auto await_resume (void)
+  {
+    if constexpr (Optional)
+      return std::move(waiter_.result);
+    else
+      return std::move(*waiter_.result);
+  }
+ private:
+  awaitable_priority_deque & deque_;
+  std::stop_token stop_;
+  bool maximal_, timed_, suspended_;
+  time_point deadline_;
+  waiter waiter_;
+//  Constructed before the waiter is queued, so it never resumes the waiter
+//  from within await_suspend.
+  std::optional<std::stop_callback<canceller> > stopper_;
+};
+
+template <typename T, typename S, typename C, typename K>
+template <bool Optional>
+bool awaitable_priority_deque<T, S, C, K>::pop_awaiter<Optional>::await_suspend
+  (std::coroutine_handle<> handle)
+{
+  waiter_.handle = handle;
+  if (stop_.stop_possible())
+    stopper_.emplace(stop_, canceller{ this });
+  std::lock_guard<std::mutex> lock (deque_.lock_);
+  if (!deque_.deque_.empty())
+  {
+    result_writer out { &waiter_.result };
+    if (maximal_)
+      deque_.deque_.pop_maximum_n(1, out);
+    else
+      deque_.deque_.pop_minimum_n(1, out);
+    return false;
+  }
+  if (waiter_.cancelled || (timed_ && (deadline_ <= K::now())))
+    return false;
+  if (timed_)
+    waiter_.timer = deque_.timers_.schedule(deadline_, &waiter_);
+  deque_.link(&waiter_);
+  suspended_ = true;
+  return true;
+}
+
+template <typename T, typename S, typename C, typename K>
+template <typename... Args>
+void awaitable_priority_deque<T, S, C, K>::emplace (Args &&... args)
+{
+  std::unique_lock<std::mutex> lock (lock_);
+  waiter * w = first_;
+  if (!w)
+  {
+    deque_.emplace(std::forward<Args>(args)...);
+    return;
+  }
+  w->result.emplace(std::forward<Args>(args)...);
+  unlink(w);
+  release_timer(w);
+  ++handoffs_;
+  lock.unlock();
+  w->handle.resume();
+}
+
+template <typename T, typename S, typename C, typename K>
+typename awaitable_priority_deque<T, S, C, K>::size_type
+  awaitable_priority_deque<T, S, C, K>::expire_until (time_point const & now)
+{
+  std::vector<waiter *> expired;
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    timers_.expire_until(now, [this, &expired](waiter * w) {
+      w->timer = 0;
+      unlink(w);
+      expired.push_back(w);
+    });
+  }
+//  Each may be destroyed as soon as it is resumed.
+  for (std::size_t i = 0; i < expired.size(); ++i)
+    expired[i]->handle.resume();
+  return expired.size();
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -0,0 +1,243 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file batched_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    batched_priority_deque.hpp provides the class batched_priority_deque, a
+//  priority deque shared by many producer threads and one consumer.
+//    Each producer pushes into a priority deque of its own, which is merged
+//  into the shared deque as a batch once it holds enough elements, or once
+//  its oldest element is old enough. The shared lock is thus taken once per
+//  batch, rather than once per element. The consumer may force every batch
+//  to be published.
+//  @par  Thread safety:
+//    Each producer may be used by one thread at a time. All other operations
+//  may be called from any thread.
+//  @par Exception safety:
+//    As for priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_BATCHED_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_BATCHED_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error batched_priority_deque.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error batched_priority_deque.hpp requires C++11 (for std::mutex).
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//------------------------Batched Priority Deque Class-------------------------|
+/*! @brief Priority deque into which producers publish elements in batches.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param Sequence Underlying sequence container. Must provide random-access
+ *  iterators, %front(), %push_back(Type const &), and %pop_back().
+ *  Defaults to std::vector<Type>.
+ *  @param Compare Comparison class. %Compare(A, B) should return true if %A
+ *  should be placed earlier than %B in a strict weak ordering.
+ *  Defaults to std::less<Type>.
+ *  @details Elements become visible to the consumer when their batch is
+ *  published. The age of a batch is checked when its producer pushes, so an
+ *  idle producer's batch waits for the consumer to call flush.
+ *  @see priority_deque
+ */
+template <typename Type, typename Sequence =std::vector<Type>,
+          typename Compare =::std::less<Type> >
+class batched_priority_deque
+{
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef priority_deque<Type, Sequence, Compare>     deque_type;
+  typedef typename deque_type::value_type             value_type;
+  typedef typename deque_type::size_type              size_type;
+  typedef Compare                                     value_compare;
+  typedef std::chrono::steady_clock                   clock_type;
+//--------------------------------Producers------------------------------------|
+/*! @brief A producer's batch, which is published into a batched deque.
+ *  @details Must not outlive its deque. Publishes its batch when destroyed.
+ */
+  class producer
+  {
+   public:
+    explicit producer                 (batched_priority_deque & target);
+    ~producer                         (void);
+    producer                          (producer const &) = delete;
+    producer & operator=              (producer const &) = delete;
+/** @brief Adds an element to the batch, publishing the batch if it is full
+//  or old.
+//  @par  Complexity:
+//    O(log b) for a batch of b elements, plus the cost of publishing.
+*/
+    void                  push        (value_type const & value)
+    {
+      std::lock_guard<std::mutex> lock (lock_);
+      buffer_.push(value);
+      pushed();
+    }
+//!@overload
+    void                  push        (value_type && value)
+    {
+      std::lock_guard<std::mutex> lock (lock_);
+      buffer_.push(std::move(value));
+      pushed();
+    }
+//! @brief Publishes the batch now.
+    void                  flush       (void)
+    {
+      std::lock_guard<std::mutex> lock (lock_);
+      target_.publish(buffer_);
+    }
+   private:
+    void pushed (void)
+    {
+      const clock_type::time_point now = clock_type::now();
+      if (buffer_.size() == 1)
+        oldest_ = now;
+      if ((buffer_.size() >= target_.batch_size_) ||
+          (now - oldest_ >= target_.max_age_))
+        target_.publish(buffer_);
+    }
+    friend class batched_priority_deque;
+    batched_priority_deque & target_;
+//  Taken by the consumer only to force a flush, so rarely contended.
+    std::mutex lock_;
+    deque_type buffer_;
+    clock_type::time_point oldest_;
+  };
+//-------------------------------Constructors----------------------------------|
+/** @brief Constructs an empty deque.
+//  @param batch_size A batch is published once it holds this many elements.
+//  @param max_age A batch is published once its oldest element is this old.
+*/
+  explicit batched_priority_deque     (size_type batch_size = 64,
+                                       clock_type::duration max_age =
+                                         std::chrono::milliseconds(1),
+                                       Compare const & comp = Compare())
+    : compare_(comp), shared_(comp), batch_size_(batch_size),
+      max_age_(max_age), batches_(0) {}
+  batched_priority_deque              (batched_priority_deque const &) =delete;
+  batched_priority_deque & operator=  (batched_priority_deque const &) =delete;
+//--------------------------------Consumer-------------------------------------|
+/** @brief Removes a maximal published element, if there is one.
+//  @return True if an element was moved into @a out.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the number of published elements.
+*/
+  bool                    try_pop_maximum (value_type & out)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (shared_.empty())
+      return false;
+    shared_.pop_maximum_n(1, &out);
+    return true;
+  }
+//! @brief Removes a minimal published element, if there is one.
+  bool                    try_pop_minimum (value_type & out)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (shared_.empty())
+      return false;
+    shared_.pop_minimum_n(1, &out);
+    return true;
+  }
+/** @brief Removes up to @a n maximal published elements, under one lock.
+//  @see priority_deque::pop_maximum_n
+*/
+  template <typename OutputIterator>
+  OutputIterator          pop_maximum_n   (size_type n, OutputIterator out)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    return shared_.pop_maximum_n(n, out);
+  }
+/** @brief Publishes every producer's batch.
+//  @par  Complexity:
+//    Linear on the number of producers, plus the cost of publishing.
+*/
+  void                    flush       (void);
+//! @brief Returns the number of published elements.
+  size_type               size        (void) const
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    return shared_.size();
+  }
+//! @brief Returns true if no elements have been published, or all have been
+//! removed.
+  bool                    empty       (void) const { return size() == 0; }
+//! @brief Returns the number of batches published (each taking the lock once).
+  size_type               batches     (void) const { return batches_; }
+//---------------------------------Private-------------------------------------|
+ private:
+  void publish (deque_type & buffer)
+  {
+    if (buffer.empty())
+      return;
+    {
+      std::lock_guard<std::mutex> lock (lock_);
+      shared_.merge(std::move(buffer));
+    }
+    ++batches_;
+  }
+
+  Compare compare_;
+  mutable std::mutex lock_;
+  deque_type shared_;
+//  Lock order: registry_lock_, then a producer's lock, then lock_.
+  std::mutex registry_lock_;
+  std::vector<producer *> producers_;
+  size_type batch_size_;
+  clock_type::duration max_age_;
+  std::atomic<size_type> batches_;
+};
+
+template <typename T, typename S, typename C>
+batched_priority_deque<T, S, C>::producer::producer (
+  batched_priority_deque & target)
+  : target_(target), buffer_(target.compare_)
+{
+  std::lock_guard<std::mutex> lock (target_.registry_lock_);
+  target_.producers_.push_back(this);
+}
+
+template <typename T, typename S, typename C>
+batched_priority_deque<T, S, C>::producer::~producer (void)
+{
+  flush();
+  std::lock_guard<std::mutex> lock (target_.registry_lock_);
+  target_.producers_.erase(std::find(target_.producers_.begin(),
+                                     target_.producers_.end(), this));
+}
+
+template <typename T, typename S, typename C>
+void batched_priority_deque<T, S, C>::flush (void)
+{
+  std::lock_guard<std::mutex> registry (registry_lock_);
+  for (std::size_t i = 0; i < producers_.size(); ++i)
+  {
+    std::lock_guard<std::mutex> lock (producers_[i]->lock_);
+    publish(producers_[i]->buffer_);
+  }
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -0,0 +1,265 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file counted_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    counted_priority_deque.hpp provides the class counted_priority_deque, a
+//  priority deque that stores each distinct element once, with a count of its
+//  copies.
+//    When there are many more elements than distinct values, this saves both
+//  memory and time: adding or removing a copy of a value already present
+//  changes only its count.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for unique_priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_COUNTED_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_COUNTED_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error counted_priority_deque.hpp requires a C++ compiler.
+#endif
+
+#include "unique_priority_deque.hpp"
+
+namespace boost {
+namespace container {
+/// \cond false
+namespace counted_priority_deque_internal {
+//! @brief A distinct value, and the number of copies of it.
+template <typename Type>
+struct counted
+{
+  Type value;
+  std::size_t count;
+};
+
+template <typename Type>
+struct value_of
+{
+  Type const & operator() (counted<Type> const & element) const
+  {
+    return element.value;
+  }
+};
+
+template <typename Type, typename Compare>
+struct counted_compare
+{
+  explicit counted_compare (Compare const & comp) : compare(comp) {}
+  bool operator() (counted<Type> const & lhs, counted<Type> const & rhs) const
+  {
+    return compare(lhs.value, rhs.value);
+  }
+  Compare compare;
+};
+} //  Namespace counted_priority_deque_internal
+/// \endcond
+
+//----------------------Counted Priority Deque Class---------------------------|
+/*! @brief Double-ended priority queue storing one entry per distinct value.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param Compare Comparison class.
+ *  @param Hash Hash function for elements. Defaults to std::hash.
+ *  @param KeyEqual Equality of elements. Defaults to std::equal_to. Elements
+ *  that are equal must be equivalent under @a Compare.
+ *  @details Equal elements are indistinguishable: the deque keeps one copy,
+ *  and a count. size() reports the number of elements, counting every copy;
+ *  distinct() reports the number of entries stored.
+ *  @note Since equal elements share storage, minimum and maximum return a
+ *  reference to the single stored copy.
+ *  @see unique_priority_deque, priority_deque
+ */
+template <typename Type, typename Compare =::std::less<Type>,
+          typename Hash =::std::hash<Type>,
+          typename KeyEqual =::std::equal_to<Type> >
+class counted_priority_deque
+  : private unique_priority_deque<
+      counted_priority_deque_internal::counted<Type>,
+      counted_priority_deque_internal::value_of<Type>,
+      counted_priority_deque_internal::counted_compare<Type, Compare>,
+      Hash, KeyEqual>
+{
+  typedef counted_priority_deque_internal::counted<Type>            element;
+  typedef unique_priority_deque<element,
+            counted_priority_deque_internal::value_of<Type>,
+            counted_priority_deque_internal::counted_compare<Type, Compare>,
+            Hash, KeyEqual>                                         base_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Type                                        value_type;
+  typedef Compare                                     value_compare;
+  typedef typename base_type::size_type               size_type;
+  typedef Type const &                                const_reference;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty priority deque.
+  explicit counted_priority_deque     (Compare const & comp =Compare(),
+                                       Hash const & hash =Hash(),
+                                       KeyEqual const & equal =KeyEqual())
+    : base_type(typename counted_priority_deque_internal::counted_compare<
+                  Type, Compare>(comp), typename base_type::key_extractor(),
+                hash, equal),
+      size_(0) {}
+//-----------------------------Restricted Access-------------------------------|
+/** @brief Adds copies of an element to the priority deque.
+//  @param value Element to add.
+//  @param copies Number of copies to add.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(1) on average if an equal element is present; otherwise O(log n) on the
+//  number of distinct elements (amortized).
+//  @par  Exception safety:
+//    Strong.
+*/
+  void                    push        (value_type const & value,
+                                       size_type copies = 1);
+//! @brief Accesses a maximal element in the deque.
+  inline const_reference  maximum     (void) const
+  {
+    return base_type::maximum().value;
+  }
+//! @brief Accesses a minimal element in the deque.
+  inline const_reference  minimum     (void) const
+  {
+    return base_type::minimum().value;
+  }
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline const_reference  top         (void) const  { return maximum(); }
+/** @brief Removes one copy of a maximal element from the deque.
+//  @par  Complexity:
+//    O(1) if other copies remain; otherwise O(log n) on the number of
+//  distinct elements.
+*/
+  void                    pop_maximum (void);
+/** @brief Removes one copy of a minimal element from the deque.
+//  @par  Complexity:
+//    O(1) if other copies remain; otherwise O(log n) on the number of
+//  distinct elements.
+*/
+  void                    pop_minimum (void);
+//! @details Identical to std::priority_queue pop(). @see @a pop_maximum
+  inline void             pop         (void)        { pop_maximum(); }
+//! @brief Returns the number of copies of an element in the deque.
+  size_type               count       (value_type const & value) const
+  {
+    element const * found = base_type::find(value);
+    return found ? found->count : 0;
+  }
+//! @brief Removes every copy of an element. Returns the number removed.
+  size_type               erase       (value_type const & value);
+
+//! @brief Returns true if the priority deque is empty, false if it is not.
+  inline bool             empty       (void) const  { return size_ == 0; }
+//! @brief Returns the number of elements, counting every copy.
+  inline size_type        size        (void) const  { return size_; }
+//! @brief Returns the number of distinct elements stored.
+  inline size_type        distinct    (void) const
+  {
+    return base_type::size();
+  }
+//! @brief Removes all elements from the priority deque.
+  void                    clear       (void)
+  {
+    base_type::clear();
+    size_ = 0;
+  }
+//! @brief Exchanges the elements of two counted priority deques.
+  void                    swap        (counted_priority_deque & other)
+  {
+    using std::swap;
+    base_type::swap(other);
+    swap(size_, other.size_);
+  }
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = false;
+  static const bool is_stable             = false;
+  static const bool has_reserve           = false;
+//---------------------------------Private-------------------------------------|
+ private:
+  size_type size_;
+};
+
+template <typename T, typename C, typename H, typename E>
+void counted_priority_deque<T, C, H, E>::push (value_type const & value,
+                                               size_type copies)
+{
+  if (copies == 0)
+    return;
+  typename base_type::entry_type * found = base_type::find_entry(value);
+  if (found) {
+//  Equal elements are equivalent, so the ordering is unchanged.
+    found->value.count += copies;
+  } else {
+    element added = { value, copies };
+    base_type::push(std::move(added));
+  }
+  size_ += copies;
+}
+
+template <typename T, typename C, typename H, typename E>
+void counted_priority_deque<T, C, H, E>::pop_maximum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no maximal element. Removal undefined.");
+  std::size_t & copies = base_type::maximal_entry().value.count;
+  if (copies > 1)
+    --copies;
+  else
+    base_type::pop_maximum();
+  --size_;
+}
+
+template <typename T, typename C, typename H, typename E>
+void counted_priority_deque<T, C, H, E>::pop_minimum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no minimal element. Removal undefined.");
+  std::size_t & copies = base_type::minimal_entry().value.count;
+  if (copies > 1)
+    --copies;
+  else
+    base_type::pop_minimum();
+  --size_;
+}
+
+template <typename T, typename C, typename H, typename E>
+typename counted_priority_deque<T, C, H, E>::size_type
+  counted_priority_deque<T, C, H, E>::erase (value_type const & value)
+{
+  const size_type copies = count(value);
+  if (copies != 0) {
+    base_type::erase(value);
+    size_ -= copies;
+  }
+  return copies;
+}
+
+/** @brief Swaps the elements of two counted priority deques.
+// @relates counted_priority_deque
+*/
+template <typename T, typename C, typename H, typename E>
+inline void swap (counted_priority_deque<T, C, H, E> & deque1,
+                  counted_priority_deque<T, C, H, E> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -0,0 +1,568 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file cow_vector.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    cow_vector.hpp provides the class cow_vector, a random-access sequence
+//  whose copies share storage until they are modified. As the Sequence of a
+//  priority_deque, it makes priority_deque::snapshot O(1).
+//    Elements are stored in fixed-size chunks, reached through a table of
+//  chunk pointers. Both tables and chunks are reference-counted. A copy
+//  shares the table. Before a shared table is modified, it is copied (one
+//  pointer per chunk), and before a shared chunk is modified, it is copied
+//  (one chunk of elements). A writer whose copy is alive thus pays only for
+//  the chunks it touches.
+//  @par  Thread safety:
+//    Distinct cow_vector objects may be used from distinct threads, even if
+//  they share storage; in particular, a copy may be read while the original
+//  is modified. A single object is as safe as std::vector. Mutable iterators
+//  of one object may be dereferenced from several threads at once, as by the
+//  threaded heap algorithms.
+//  @par Exception safety:
+//    As for std::vector, except that dereferencing a mutable iterator may
+//  throw, if a chunk must be copied.
+*/
+
+#ifndef BOOST_CONTAINER_COW_VECTOR_HPP_
+#define BOOST_CONTAINER_COW_VECTOR_HPP_
+
+#ifndef __cplusplus
+#error cow_vector.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error cow_vector.hpp requires C++11 (for std::atomic).
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace container {
+/// \cond false
+namespace cow_vector_internal {
+//  The largest power of two number of elements that fits in 4 KiB, or 1.
+template <typename Type, std::size_t Size = 1,
+          bool More = (Size * 2 * sizeof(Type) <= 4096)>
+struct default_chunk
+{
+  static const std::size_t value = default_chunk<Type, Size * 2>::value;
+};
+template <typename Type, std::size_t Size>
+struct default_chunk<Type, Size, false>
+{
+  static const std::size_t value = Size;
+};
+
+template <typename Type, std::size_t Size>
+struct chunk
+{
+  std::atomic<std::size_t> refs;
+//  Number of constructed elements, which are at the front.
+  std::size_t count;
+  typename std::aligned_storage<sizeof(Type) * Size,
+                                alignof(Type)>::type storage;
+
+  chunk (void) : refs(1), count(0) {}
+  Type * items (void) { return reinterpret_cast<Type *>(&storage); }
+  Type const * items (void) const
+  {
+    return reinterpret_cast<Type const *>(&storage);
+  }
+  static chunk * copy (chunk const & other)
+  {
+    std::unique_ptr<chunk> result (new chunk);
+    Type * items = result->items();
+    for (; result->count < other.count; ++result->count)
+      ::new (items + result->count) Type(other.items()[result->count]);
+    return result.release();
+  }
+  ~chunk (void)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      items()[i].~Type();
+  }
+  static void release (chunk * c)
+  {
+    if (c->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete c;
+  }
+};
+
+//  One version of the list of chunks.
+template <typename Chunk>
+struct table
+{
+  std::atomic<std::size_t> refs;
+  std::vector<std::atomic<Chunk *> > slots;
+  explicit table (std::size_t capacity) : refs(1), slots(capacity) {}
+//  The first @a count slots of @a other, each now shared.
+  table (table const & other, std::size_t count, std::size_t capacity)
+    : refs(1), slots(capacity)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      Chunk * c = other.slots[i].load(std::memory_order_relaxed);
+      c->refs.fetch_add(1, std::memory_order_relaxed);
+      slots[i].store(c, std::memory_order_relaxed);
+    }
+  }
+  static void release (table * t, std::size_t count)
+  {
+    if (t && (t->refs.fetch_sub(1, std::memory_order_acq_rel) == 1))
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        Chunk::release(t->slots[i].load(std::memory_order_relaxed));
+      delete t;
+    }
+  }
+};
+
+template <typename Vector, bool Const>
+class iterator
+{
+  typedef typename Vector::value_type Type;
+ public:
+  typedef std::random_access_iterator_tag                     iterator_category;
+  typedef Type                                                value_type;
+  typedef std::ptrdiff_t                                      difference_type;
+  typedef typename std::conditional<Const, Type const *, Type *>::type pointer;
+  typedef typename std::conditional<Const, Type const &, Type &>::type
+                                                              reference;
+  typedef typename std::conditional<Const, Vector const *, Vector *>::type
+                                                              owner_pointer;
+
+  iterator (void) : owner_(nullptr), index_(0) {}
+  iterator (owner_pointer owner, std::size_t index)
+    : owner_(owner), index_(index) {}
+//  Mutable iterators convert to const ones.
+  template <bool OtherConst,
+            typename = typename std::enable_if<Const && !OtherConst>::type>
+  iterator (iterator<Vector, OtherConst> const & other)
+    : owner_(other.owner()), index_(other.index()) {}
+
+  reference operator* (void) const { return access(owner_, index_); }
+  pointer operator-> (void) const { return std::addressof(**this); }
+  reference operator[] (difference_type n) const
+  {
+    return access(owner_, index_ + n);
+  }
+  iterator & operator++ (void) { ++index_; return *this; }
+  iterator & operator-- (void) { --index_; return *this; }
+  iterator operator++ (int) { iterator old (*this); ++index_; return old; }
+  iterator operator-- (int) { iterator old (*this); --index_; return old; }
+  iterator & operator+= (difference_type n) { index_ += n; return *this; }
+  iterator & operator-= (difference_type n) { index_ -= n; return *this; }
+  iterator operator+ (difference_type n) const
+  {
+    return iterator(owner_, index_ + n);
+  }
+  friend iterator operator+ (difference_type n, iterator const & it)
+  {
+    return it + n;
+  }
+  iterator operator- (difference_type n) const
+  {
+    return iterator(owner_, index_ - n);
+  }
+//  Friends, so that mutable and const iterators may be mixed.
+  friend difference_type operator- (iterator const & a, iterator const & b)
+  {
+    return static_cast<difference_type>(a.index_) -
+           static_cast<difference_type>(b.index_);
+  }
+  friend bool operator== (iterator const & a, iterator const & b)
+  {
+    return a.index_ == b.index_;
+  }
+  friend bool operator!= (iterator const & a, iterator const & b)
+  {
+    return a.index_ != b.index_;
+  }
+  friend bool operator< (iterator const & a, iterator const & b)
+  {
+    return a.index_ < b.index_;
+  }
+  friend bool operator> (iterator const & a, iterator const & b)
+  {
+    return a.index_ > b.index_;
+  }
+  friend bool operator<= (iterator const & a, iterator const & b)
+  {
+    return a.index_ <= b.index_;
+  }
+  friend bool operator>= (iterator const & a, iterator const & b)
+  {
+    return a.index_ >= b.index_;
+  }
+
+  owner_pointer owner (void) const { return owner_; }
+  std::size_t index (void) const { return index_; }
+ private:
+  static Type const & access (Vector const * v, std::size_t i)
+  {
+    return v->read(i);
+  }
+  static Type & access (Vector * v, std::size_t i) { return v->write(i); }
+
+  owner_pointer owner_;
+  std::size_t index_;
+};
+} //  Namespace cow_vector_internal
+/// \endcond
+
+//-----------------------------Cow Vector Class--------------------------------|
+/*! @brief Random-access sequence whose copies share unmodified chunks.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements. Must be copy-constructible.
+ *  @param ChunkSize Elements per chunk; a power of two. Defaults to as many as
+ *  fit in 4 KiB.
+ *  @details Copying is O(1). The first modification after a copy costs
+ *  O(n / ChunkSize), and each chunk modified costs O(ChunkSize) the first time.
+ *  Mutable iterators copy a chunk when dereferenced, so read-only access
+ *  should go through const iterators. Mutable iterators are invalidated by
+ *  copying the sequence.
+ *  @see priority_deque::snapshot
+ */
+template <typename Type, std::size_t ChunkSize =
+            cow_vector_internal::default_chunk<Type>::value>
+class cow_vector
+{
+  static_assert((ChunkSize & (ChunkSize - 1)) == 0,
+                "Chunk size must be a power of two.");
+  typedef cow_vector_internal::chunk<Type, ChunkSize>   chunk;
+  typedef cow_vector_internal::table<chunk>             table;
+  template <typename, bool> friend class cow_vector_internal::iterator;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Type                                        value_type;
+  typedef std::size_t                                 size_type;
+  typedef std::ptrdiff_t                              difference_type;
+  typedef Type &                                      reference;
+  typedef Type const &                                const_reference;
+  typedef Type *                                      pointer;
+  typedef Type const *                                const_pointer;
+  typedef cow_vector_internal::iterator<cow_vector, false> iterator;
+  typedef cow_vector_internal::iterator<cow_vector, true>  const_iterator;
+//-------------------------------Constructors----------------------------------|
+  cow_vector                          (void)
+    : table_(nullptr), slots_(nullptr), size_(0), copies_(0) {}
+  template <typename InputIterator>
+  cow_vector                          (InputIterator first, InputIterator last)
+    : table_(nullptr), slots_(nullptr), size_(0), copies_(0)
+  {
+    insert(end(), first, last);
+  }
+//! @brief Shares the storage of @a other.
+//! @par  Complexity:
+//!   O(1)
+  cow_vector                          (cow_vector const & other)
+    : table_(other.table_), slots_(other.slots_), size_(other.size_),
+      copies_(0)
+  {
+    if (table_)
+      table_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  cow_vector                          (cow_vector && other) noexcept
+    : table_(other.table_), slots_(other.slots_), size_(other.size_),
+      copies_(0)
+  {
+    other.table_ = nullptr;
+    other.slots_ = nullptr;
+    other.size_ = 0;
+  }
+  cow_vector & operator=              (cow_vector const & other)
+  {
+    cow_vector copy (other);
+    swap(copy);
+    return *this;
+  }
+  cow_vector & operator=              (cow_vector && other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+  ~cow_vector                         (void)
+  {
+    release_retired();
+    table::release(table_, chunks(size_));
+  }
+//--------------------------------Iterators------------------------------------|
+  const_iterator          begin       (void) const
+  {
+    return const_iterator(this, 0);
+  }
+  const_iterator          end         (void) const
+  {
+    return const_iterator(this, size_);
+  }
+  const_iterator          cbegin      (void) const  { return begin(); }
+  const_iterator          cend        (void) const  { return end(); }
+//! @brief Copies the table of chunks, if it is shared.
+  iterator                begin       (void)
+  {
+    own_table(0);
+    return iterator(this, 0);
+  }
+  iterator                end         (void)
+  {
+    own_table(0);
+    return iterator(this, size_);
+  }
+//---------------------------------Access--------------------------------------|
+  const_reference         operator[]  (size_type i) const { return read(i); }
+  reference               operator[]  (size_type i)
+  {
+    own_table(0);
+    return write(i);
+  }
+  const_reference         front       (void) const  { return read(0); }
+  reference               front       (void)        { return (*this)[0]; }
+  const_reference         back        (void) const  { return read(size_ - 1); }
+  reference               back        (void)  { return (*this)[size_ - 1]; }
+  size_type               size        (void) const  { return size_; }
+  bool                    empty       (void) const  { return size_ == 0; }
+  size_type               max_size    (void) const
+  {
+    return std::numeric_limits<difference_type>::max() / sizeof(Type);
+  }
+//! @brief Returns the number of chunks this sequence has copied.
+  size_type               copies      (void) const { return copies_; }
+//! @brief Returns true if any storage is shared with another sequence.
+  bool                    shared      (void) const;
+//--------------------------------Modifiers------------------------------------|
+  void                    push_back   (value_type const & value)
+  {
+    emplace_back(value);
+  }
+  void                    push_back   (value_type && value)
+  {
+    emplace_back(std::move(value));
+  }
+  template <typename... Args>
+  void                    emplace_back(Args &&... args);
+  void                    pop_back    (void);
+  void                    clear       (void)
+  {
+    release_retired();
+    table::release(table_, chunks(size_));
+    table_ = nullptr;
+    slots_ = nullptr;
+    size_ = 0;
+  }
+  template <typename InputIterator>
+  iterator                insert      (const_iterator position,
+                                       InputIterator first, InputIterator last);
+  iterator                erase       (const_iterator first,
+                                       const_iterator last);
+  iterator                erase       (const_iterator position)
+  {
+    return erase(position, position + 1);
+  }
+  void                    swap        (cow_vector & other) noexcept
+  {
+    std::swap(table_, other.table_);
+    std::swap(slots_, other.slots_);
+    std::swap(size_, other.size_);
+  }
+//---------------------------------Private-------------------------------------|
+ private:
+  static size_type chunks (size_type size)
+  {
+    return (size + ChunkSize - 1) / ChunkSize;
+  }
+  Type const & read (size_type i) const
+  {
+    return slots_[i / ChunkSize].load(std::memory_order_acquire)
+                 ->items()[i % ChunkSize];
+  }
+  Type & write (size_type i)
+  {
+    return writable(i / ChunkSize)->items()[i % ChunkSize];
+  }
+  chunk * writable (size_type index)
+  {
+    chunk * c = slots_[index].load(std::memory_order_acquire);
+    if (c->refs.load(std::memory_order_acquire) != 1)
+      c = own_chunk(index);
+    return c;
+  }
+  void own_table (size_type extra);
+  chunk * own_chunk (size_type index);
+//  Each retired chunk holds the reference its slot held, and the one that
+//  own_chunk took to pin it.
+  void release_retired (void)
+  {
+    for (std::size_t i = 0; i < retired_.size(); ++i)
+    {
+      chunk::release(retired_[i]);
+      chunk::release(retired_[i]);
+    }
+    retired_.clear();
+  }
+
+  table * table_;
+//  The slots of table_, saving an indirection.
+  std::atomic<chunk *> * slots_;
+  size_type size_;
+  size_type copies_;
+//  Taken only to copy a chunk, which threads writing one sequence may race to
+//  do. A replaced chunk is pinned with an extra reference and retired, so
+//  that its count stays above 1 (even if every other sharer lets go) until no
+//  such thread can still hold a pointer to it.
+  std::mutex lock_;
+  std::vector<chunk *> retired_;
+};
+
+template <typename T, std::size_t N>
+bool cow_vector<T, N>::shared (void) const
+{
+  if (!table_)
+    return false;
+  if (table_->refs.load(std::memory_order_acquire) != 1)
+    return true;
+  for (size_type i = 0; i < chunks(size_); ++i)
+    if (table_->slots[i].load(std::memory_order_relaxed)
+                        ->refs.load(std::memory_order_acquire) != 1)
+      return true;
+  return false;
+}
+
+//  Makes the table unshared, with room for @a extra more chunks.
+template <typename T, std::size_t N>
+void cow_vector<T, N>::own_table (size_type extra)
+{
+  release_retired();
+  const size_type count = chunks(size_);
+  if (table_ && (table_->refs.load(std::memory_order_acquire) == 1) &&
+      (count + extra <= table_->slots.size()))
+    return;
+  if (!table_ && !extra)
+    return;
+  const size_type capacity = std::max<size_type>(count + extra,
+    (table_ && (table_->refs.load(std::memory_order_acquire) == 1))
+      ? 2 * table_->slots.size() : count);
+  table * replacement = table_ ? new table(*table_, count, capacity)
+                               : new table(capacity);
+  table::release(table_, count);
+  table_ = replacement;
+  slots_ = table_->slots.data();
+}
+
+template <typename T, std::size_t N>
+typename cow_vector<T, N>::chunk * cow_vector<T, N>::own_chunk (size_type index)
+{
+  std::lock_guard<std::mutex> lock (lock_);
+  retired_.reserve(retired_.size() + 1);
+  std::atomic<chunk *> & slot = slots_[index];
+  chunk * c = slot.load(std::memory_order_acquire);
+//    Pin the chunk before deciding. Only another sharer can raise a count, so
+//  once this table's chunk is unshared only the pin does. If the count was 1,
+//  other threads may already be writing to the chunk in place, so keep it.
+//  Otherwise no thread has seen a count of 1, and none will while it is pinned.
+  if (c->refs.fetch_add(1, std::memory_order_acq_rel) == 1)
+  {
+    c->refs.fetch_sub(1, std::memory_order_relaxed);
+    return c;
+  }
+  std::unique_ptr<chunk> copy;
+  try {
+    copy.reset(chunk::copy(*c));
+  } catch (...) {
+    chunk::release(c);
+    throw;
+  }
+  retired_.push_back(c);
+  slot.store(copy.get(), std::memory_order_release);
+  ++copies_;
+  return copy.release();
+}
+
+template <typename T, std::size_t N>
+template <typename... Args>
+void cow_vector<T, N>::emplace_back (Args &&... args)
+{
+  if (size_ % N == 0)
+  {
+    own_table(1);
+    std::unique_ptr<chunk> added (new chunk);
+    ::new (added->items()) T(std::forward<Args>(args)...);
+    added->count = 1;
+    slots_[chunks(size_)].store(added.release(),
+                                       std::memory_order_relaxed);
+  } else {
+    own_table(0);
+    chunk * c = writable(size_ / N);
+    ::new (c->items() + c->count) T(std::forward<Args>(args)...);
+    ++c->count;
+  }
+  ++size_;
+}
+
+template <typename T, std::size_t N>
+void cow_vector<T, N>::pop_back (void)
+{
+  own_table(0);
+  const size_type index = (size_ - 1) / N;
+  if ((size_ - 1) % N == 0)
+  {
+//  The last chunk empties. Its copies need not be made.
+    chunk::release(slots_[index].load(std::memory_order_relaxed));
+    slots_[index].store(nullptr, std::memory_order_relaxed);
+  } else {
+    chunk * c = writable(index);
+    c->items()[--c->count].~T();
+  }
+  --size_;
+}
+
+template <typename T, std::size_t N>
+template <typename InputIterator>
+typename cow_vector<T, N>::iterator
+  cow_vector<T, N>::insert (const_iterator position, InputIterator first,
+                            InputIterator last)
+{
+  const size_type offset = position.index(), old_size = size_;
+  for (; first != last; ++first)
+    emplace_back(*first);
+  if (offset != old_size)
+    std::rotate(begin() + offset, begin() + old_size, end());
+  return begin() + offset;
+}
+
+template <typename T, std::size_t N>
+typename cow_vector<T, N>::iterator
+  cow_vector<T, N>::erase (const_iterator first, const_iterator last)
+{
+  const size_type offset = first.index(), removed = last.index() - offset;
+  if (last.index() != size_)
+    std::move(begin() + last.index(), end(), begin() + offset);
+  for (size_type i = 0; i < removed; ++i)
+    pop_back();
+  return begin() + offset;
+}
+
+template <typename T, std::size_t N>
+inline void swap (cow_vector<T, N> & x, cow_vector<T, N> & y) noexcept
+{
+  x.swap(y);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -0,0 +1,584 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file incremental_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    incremental_priority_deque.hpp provides the class
+//  incremental_priority_deque, a priority deque that arranges bulk insertions a
+//  little at a time, rather than all at once.
+//    Arranging a large range as an interval heap takes time linear in the size
+//  of the deque, and priority_deque::insert takes it all in one call. Here the
+//  work is split into steps of bounded size, made either by calling step(), or
+//  a few at a time by every later push and pop. The extremes remain available
+//  throughout, and may be removed without finishing the build.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_INCREMENTAL_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_INCREMENTAL_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error incremental_priority_deque.hpp requires a C++ compiler.
+#endif
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//------------------------Incremental Priority Deque Class---------------------|
+/*! @brief Priority deque whose bulk insertions are arranged incrementally.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param Sequence Underlying sequence container, as for priority_deque.
+ *  @param Compare Comparison class, as for priority_deque.
+ *  @details insert() appends the new elements, and finds the least and
+ *  greatest of each small block of them, but leaves the rest of the
+ *  arrangement for later. Until it is done, the deque is "building": step()
+ *  continues the arrangement explicitly, and each push or pop continues it by
+ *  a fixed budget.
+ *  @details During a build, the elements are in two parts:
+ *  - A prefix that is a valid interval heap. Arranging an element pushes it
+ *    onto this heap.
+ *  - A tail not yet arranged, split into blocks of about sqrt(k) elements,
+ *    where k is the size of the insertion. Each block keeps its least and
+ *    greatest elements at its end, and the best bounds among the blocks are
+ *    tracked.
+ *
+ *  The extremes of the deque are therefore the best of the heap's root and
+ *  the tracked bounds, and minimum() and maximum() remain constant-time.
+ *  Removing an extreme from the tail rescans only the block that held it and
+ *  the bounds of the other blocks, so no removal has to finish the build.
+ *  @see priority_deque
+ */
+template <typename Type, typename Sequence =std::vector<Type>,
+          typename Compare =::std::less<typename Sequence::value_type> >
+class incremental_priority_deque
+  : private priority_deque<Type, Sequence, Compare>
+{
+  typedef priority_deque<Type, Sequence, Compare>                   base_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef typename base_type::container_type          container_type;
+  typedef typename base_type::value_type              value_type;
+  typedef typename base_type::value_compare           value_compare;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::const_reference         const_reference;
+  typedef typename base_type::const_iterator          const_iterator;
+  typedef typename base_type::difference_type         difference_type;
+//! @brief Number of intervals each push or pop arranges, by default.
+  static const size_type kDefaultPiggyback = 16;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty priority deque.
+  explicit incremental_priority_deque (Compare const & comp =Compare())
+    : base_type(comp), arranged_(0), grid_(0), block_(0), tail_min_(0),
+      tail_max_(0), piggyback_(kDefaultPiggyback) {}
+/** @brief Constructs a priority deque from a range, beginning a build.
+//  @see insert
+*/
+  template <typename InputIterator>
+  incremental_priority_deque          (InputIterator first, InputIterator last,
+                                       Compare const & comp =Compare())
+    : base_type(comp), arranged_(0), grid_(0), block_(0), tail_min_(0),
+      tail_max_(0), piggyback_(kDefaultPiggyback)
+  {
+    insert(first, last);
+  }
+//-----------------------------Restricted Access-------------------------------|
+/** @brief Adds an element to the priority deque.
+//  @details While building, the element joins the last block of the tail.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(log n) if no build is in progress; otherwise O(1), plus the cost of
+//  the piggybacked step (see set_piggyback).
+//  @par  Exception safety:
+//    Strong if no build is in progress; otherwise as for step.
+*/
+  void                    push        (value_type const & value);
+#if (__cplusplus >= 201103L)
+//!@overload
+  void                    push        (value_type && value);
+#endif
+/** @brief Merges a sequence of elements into the priority deque.
+//  @details Finishes any build in progress, appends the elements, and moves
+//  the least and greatest of each block to its end. Arranging them is left
+//  to step() and later pushes and pops.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(k) on the number of new elements, plus the cost of finishing any
+//  earlier build.
+//  @par  Exception safety:
+//    Basic; invariants are maintained. Note that elements may be lost during
+//  exception handling.
+*/
+  template <typename InputIterator>
+  void                    insert      (InputIterator first, InputIterator last);
+//! @overload
+  template <typename InputIterator>
+  void                    merge       (InputIterator first, InputIterator last)
+  {
+    insert(first, last);
+  }
+//! @brief Accesses a maximal element in the deque. O(1), even while building.
+  const_reference         maximum     (void) const;
+//! @brief Accesses a minimal element in the deque. O(1), even while building.
+  const_reference         minimum     (void) const;
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline const_reference  top         (void) const  { return maximum(); }
+/** @brief Removes a maximal element from the deque.
+//  @details While building, the element is taken from the heap or from the
+//  tail, whichever holds it, and the build continues by the piggyback budget.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(log n) if no build is in progress; otherwise O(log n + sqrt(k)), plus
+//  the cost of the piggybacked step.
+//  @par  Exception safety:
+//    Basic while building; invariants are maintained. Note that elements may
+//  be lost during exception handling.
+*/
+  void                    pop_maximum (void);
+/** @brief Removes a minimal element from the deque.
+//  @see pop_maximum
+*/
+  void                    pop_minimum (void);
+//! @details Identical to std::priority_queue pop(). @see @a pop_maximum
+  inline void             pop         (void)        { pop_maximum(); }
+//------------------------------Incremental Build------------------------------|
+/** @brief Continues the build in progress, if any.
+//  @param budget Maximum number of intervals (pairs of elements) to arrange.
+//  @return True if the build is still in progress.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(budget * log n + sqrt(k)). Most elements cost O(1) to arrange.
+//  @par  Exception safety:
+//    Basic; invariants are maintained. Note that elements may be lost during
+//  exception handling.
+*/
+  bool                    step        (size_type budget);
+/** @brief Completes the build in progress, if any.
+//  @par  Complexity:
+//    O(min(n, k * log n)), on the number of elements not yet arranged.
+*/
+  void                    finish      (void);
+//! @brief Returns true if a bulk insertion is still being arranged.
+  inline bool             building    (void) const  { return block_ != 0; }
+//! @brief Sets the number of intervals each push or pop arranges while building.
+  inline void             set_piggyback (size_type budget)
+  {
+    piggyback_ = budget;
+  }
+
+  using base_type::empty;
+  using base_type::size;
+  using base_type::max_size;
+  using base_type::begin;
+  using base_type::end;
+//! @brief Removes all elements from the priority deque.
+  void                    clear       (void)
+  {
+    base_type::clear();
+    block_ = 0;
+  }
+//! @brief Exchanges the elements of two incremental priority deques.
+  void                    swap        (incremental_priority_deque & other)
+  {
+    using std::swap;
+    base_type::swap(other);
+    swap(arranged_, other.arranged_);
+    swap(grid_, other.grid_);
+    swap(block_, other.block_);
+    swap(tail_min_, other.tail_min_);
+    swap(tail_max_, other.tail_max_);
+    swap(piggyback_, other.piggyback_);
+  }
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = true;
+  static const bool is_stable             = false;
+  static const bool has_reserve           = false;
+//---------------------------------Private-------------------------------------|
+ private:
+  typedef heap::interval_heap_internal::heap_compare<Compare, Type> adapted;
+//! @brief Compares the elements at two offsets.
+  bool                    less        (difference_type lhs,
+                                       difference_type rhs) const
+  {
+    container_type const & seq = base_type::sequence();
+    return adapted::adapt(base_type::compare())(*(seq.begin() + lhs),
+                                                *(seq.begin() + rhs));
+  }
+//! @brief Exchanges the elements at two offsets.
+  void                    exchange    (difference_type lhs, difference_type rhs)
+  {
+    using std::swap;
+    container_type & seq = base_type::sequence();
+    swap(*(seq.begin() + lhs), *(seq.begin() + rhs));
+  }
+//! @brief Number of elements, as an offset.
+  difference_type         extent      (void) const
+  {
+    return base_type::sequence().end() - base_type::sequence().begin();
+  }
+//! @brief First offset of the tail block holding an element.
+  difference_type         block_begin (difference_type index) const
+  {
+    const difference_type start = grid_ + (index - grid_) / block_ * block_;
+    return (start < arranged_) ? arranged_ : start;
+  }
+//! @brief One past the last offset of the tail block holding an element.
+  difference_type         block_end   (difference_type index) const
+  {
+    const difference_type stop = grid_ + ((index - grid_) / block_ + 1) * block_;
+    return (stop < extent()) ? stop : extent();
+  }
+//! @brief Moves the bounds of a tail block to its end. O(sqrt(k)).
+  void                    refresh     (difference_type index);
+//! @brief Finds the best bounds among the tail blocks. O(sqrt(k)).
+  void                    rescan      (void);
+//! @brief Arranges the first element of the tail.
+  void                    absorb      (void);
+//! @brief Replaces a tail element by the last element, and removes it.
+  void                    remove_tail (difference_type index);
+//! @brief Fixes the last block and the tracked bounds after a push.
+  void                    settle_push (void);
+//! @brief Clears the deque if a build fails partway.
+  struct BuildGuard
+  {
+    incremental_priority_deque * deque_;
+#if (__cplusplus >= 201103L)
+    BuildGuard (incremental_priority_deque & deque) noexcept
+      : deque_(std::addressof(deque)) {}
+#else
+    BuildGuard (incremental_priority_deque & deque) : deque_(&deque) {}
+#endif
+    BuildGuard (BuildGuard const &);
+    BuildGuard & operator= (BuildGuard const &);
+    ~BuildGuard (void)
+    {
+//  As in priority_deque::insert, the heap invariant can no longer be trusted.
+      if (deque_)
+        deque_->clear();
+    }
+  };
+
+//  Number of elements in the arranged prefix.
+  difference_type arranged_;
+//  Offset from which the tail is divided into blocks.
+  difference_type grid_;
+//  Size of each tail block, or 0 if no build is in progress.
+  difference_type block_;
+//  Offsets of the best bounds among the tail blocks.
+  difference_type tail_min_, tail_max_;
+  size_type piggyback_;
+};
+
+template <typename T, typename S, typename C>
+const typename incremental_priority_deque<T, S, C>::size_type
+  incremental_priority_deque<T, S, C>::kDefaultPiggyback;
+
+//-----------------------------Restricted Access-------------------------------|
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::push (value_type const & value)
+{
+  if (!building()) {
+    base_type::push(value);
+    return;
+  }
+  base_type::sequence().push_back(value);
+  BuildGuard guard (*this);
+  settle_push();
+  guard.deque_ = 0;
+  step(piggyback_);
+}
+
+#if (__cplusplus >= 201103L)
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::push (value_type && value)
+{
+  if (!building()) {
+    base_type::push(std::move(value));
+    return;
+  }
+  base_type::sequence().push_back(std::move(value));
+  BuildGuard guard (*this);
+  settle_push();
+  guard.deque_ = nullptr;
+  step(piggyback_);
+}
+#endif
+
+template <typename T, typename S, typename C>
+template <typename InputIterator>
+void incremental_priority_deque<T, S, C>::insert (InputIterator first,
+                                                  InputIterator last)
+{
+  finish();
+  container_type & seq = base_type::sequence();
+  const difference_type old_size = seq.end() - seq.begin();
+  BuildGuard guard (*this);
+  seq.insert(seq.end(), first, last);
+  const difference_type index_end = seq.end() - seq.begin();
+//  A single new element is simply pushed.
+  if (index_end - old_size < 2) {
+    if (index_end > old_size)
+      heap::push_interval_heap(seq.begin(), seq.end(), base_type::compare());
+    guard.deque_ = 0;
+    return;
+  }
+//  Blocks of about sqrt(k) elements balance the cost of rescanning one block
+//  against that of rescanning the bounds of all of them.
+  difference_type block = 1;
+  while ((block + 1) * (block + 1) <= index_end - old_size)
+    ++block;
+  arranged_ = grid_ = old_size;
+  block_ = block;
+  for (difference_type index = old_size; index < index_end; index += block)
+    refresh(index);
+  rescan();
+  guard.deque_ = 0;
+}
+
+template <typename T, typename S, typename C>
+typename incremental_priority_deque<T, S, C>::const_reference
+  incremental_priority_deque<T, S, C>::maximum (void) const
+{
+  if (!building())
+    return base_type::maximum();
+  difference_type best = tail_max_;
+  if (arranged_ > 0) {
+    const difference_type heap_max = (arranged_ > 1) ? 1 : 0;
+    if (less(best, heap_max))
+      best = heap_max;
+  }
+  return *(base_type::sequence().begin() + best);
+}
+
+template <typename T, typename S, typename C>
+typename incremental_priority_deque<T, S, C>::const_reference
+  incremental_priority_deque<T, S, C>::minimum (void) const
+{
+  if (!building())
+    return base_type::minimum();
+  difference_type best = tail_min_;
+  if ((arranged_ > 0) && less(0, best))
+    best = 0;
+  return *(base_type::sequence().begin() + best);
+}
+
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::pop_maximum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no maximal element. Removal impossible.");
+  if (!building()) {
+    base_type::pop_maximum();
+    return;
+  }
+  container_type & seq = base_type::sequence();
+  BuildGuard guard (*this);
+  const difference_type heap_max = (arranged_ > 1) ? 1 : 0;
+  if ((arranged_ > 0) && !less(heap_max, tail_max_)) {
+//  The hole left at the end of the heap is filled from the end of the tail.
+    heap::pop_interval_heap_max(seq.begin(), seq.begin() + arranged_,
+                                base_type::compare());
+    remove_tail(arranged_ - 1);
+  } else
+    remove_tail(tail_max_);
+  guard.deque_ = 0;
+  step(piggyback_);
+}
+
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::pop_minimum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no minimal element. Removal impossible.");
+  if (!building()) {
+    base_type::pop_minimum();
+    return;
+  }
+  container_type & seq = base_type::sequence();
+  BuildGuard guard (*this);
+  if ((arranged_ > 0) && !less(tail_min_, 0)) {
+    heap::pop_interval_heap_min(seq.begin(), seq.begin() + arranged_,
+                                base_type::compare());
+    remove_tail(arranged_ - 1);
+  } else
+    remove_tail(tail_min_);
+  guard.deque_ = 0;
+  step(piggyback_);
+}
+
+//------------------------------Incremental Build------------------------------|
+template <typename T, typename S, typename C>
+bool incremental_priority_deque<T, S, C>::step (size_type budget)
+{
+  if (!building())
+    return false;
+  BuildGuard guard (*this);
+  for (; (budget > 0) && building(); --budget) {
+    absorb();
+    if (building())
+      absorb();
+  }
+  guard.deque_ = 0;
+  return building();
+}
+
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::finish (void)
+{
+  if (!building())
+    return;
+  container_type & seq = base_type::sequence();
+  BuildGuard guard (*this);
+//  As in priority_deque::merge, a large tail is cheaper to arrange anew.
+  const difference_type total = seq.end() - seq.begin();
+  difference_type log_total = 0;
+  for (difference_type n = total; n > 1; n >>= 1)
+    ++log_total;
+  if ((total - arranged_) * log_total > total) {
+    heap::make_interval_heap(seq.begin(), seq.end(), base_type::compare());
+    block_ = 0;
+  } else {
+    while (building())
+      absorb();
+  }
+  guard.deque_ = 0;
+}
+
+/*    Finds the least and greatest elements of the block, and moves them to its
+//  last two offsets (least first). A block of one element is its own bounds.
+*/
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::refresh (difference_type index)
+{
+  const difference_type first = block_begin(index), last = block_end(index);
+  if (last - first < 2)
+    return;
+  difference_type least = first, greatest = first;
+  for (difference_type i = first + 1; i < last; ++i) {
+    if (less(i, least))
+      least = i;
+    else if (less(greatest, i))
+      greatest = i;
+  }
+  exchange(last - 2, least);
+  if (greatest == last - 2)
+    greatest = least;
+  exchange(last - 1, greatest);
+}
+
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::rescan (void)
+{
+  const difference_type index_end = extent();
+  tail_min_ = tail_max_ = index_end - 1;
+  for (difference_type first = arranged_; first < index_end; ) {
+    const difference_type last = block_end(first);
+    const difference_type lower = (last - first > 1) ? (last - 2) : (last - 1);
+    if (less(lower, tail_min_))
+      tail_min_ = lower;
+    if (less(tail_max_, last - 1))
+      tail_max_ = last - 1;
+    first = last;
+  }
+}
+
+/*    The first element of the tail is a bound of its block only if the block
+//  has at most two elements. Only then can the tracked bounds move.
+*/
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::absorb (void)
+{
+  container_type & seq = base_type::sequence();
+  heap::push_interval_heap(seq.begin(), seq.begin() + (arranged_ + 1),
+                           base_type::compare());
+  ++arranged_;
+  if (arranged_ == extent())
+    block_ = 0;
+  else if ((tail_min_ < arranged_) || (tail_max_ < arranged_))
+    rescan();
+}
+
+/*    The last element of the sequence takes the place of the one removed. If
+//  the hole is at the end of the heap, the heap then takes that element in.
+//  Both affected blocks are refreshed, and the tracked bounds rescanned.
+*/
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::remove_tail (difference_type index)
+{
+  container_type & seq = base_type::sequence();
+  exchange(index, extent() - 1);
+  seq.pop_back();
+  const difference_type index_end = extent();
+  if (index < arranged_)
+    heap::push_interval_heap(seq.begin(), seq.begin() + arranged_,
+                             base_type::compare());
+  if (arranged_ == index_end) {
+    block_ = 0;
+    return;
+  }
+  refresh(index_end - 1);
+  if ((index >= arranged_) && (index < index_end))
+    refresh(index);
+  rescan();
+}
+
+/*    The new element joins the last block, or starts a block of its own. The
+//  bounds of a block of several elements sit at its last two offsets, so the
+//  new element is rotated in among them in constant time.
+*/
+template <typename T, typename S, typename C>
+void incremental_priority_deque<T, S, C>::settle_push (void)
+{
+  const difference_type last = extent() - 1;
+  const difference_type first = block_begin(last);
+  if (last - first == 1) {
+    if (less(last, first))
+      exchange(first, last);
+  } else if (last - first > 1) {
+    if (less(last, last - 2))
+      exchange(last - 1, last);
+    else if (less(last - 1, last))
+      exchange(last - 2, last - 1);
+    else {
+      exchange(last - 2, last);
+      exchange(last - 1, last);
+    }
+  }
+//  The bounds of the last block only improved, so other blocks are unaffected.
+  const difference_type lower = (last > first) ? (last - 1) : last;
+  if ((tail_min_ >= first) || less(lower, tail_min_))
+    tail_min_ = lower;
+  if ((tail_max_ >= first) || less(tail_max_, last))
+    tail_max_ = last;
+}
+
+/** @brief Swaps the elements of two incremental priority deques.
+// @relates incremental_priority_deque
+*/
+template <typename T, typename S, typename C>
+inline void swap (incremental_priority_deque<T, S, C> & deque1,
+                  incremental_priority_deque<T, S, C> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -29,14 +29,29 @@
 #error interval_heap.hpp requires a C++ compiler.
 #endif
 
-//  Grab std::swap and std::move (if available), while avoiding extra baggage.
+//  Grab std::swap and std::move (if available).
 #if (__cplusplus >= 201103L)
 #include <utility>
-#else
+#endif
+//  Grab std::reverse and std::rotate, for rearranging sorted input.
 #include <algorithm>
+#if (__cplusplus >= 201103L)
+//  Scratch space for rearranging sorted input, if it can be allocated.
+#include <vector>
+#include <new>
 #endif
 //  Grab iterator data, for better use of templates.
 #include <iterator>
+//  Recognize the standard comparisons (std::less, std::greater).
+#include <functional>
+#if (__cplusplus >= 201103L)
+//  Recognize arithmetic types, which can be ordered without branching.
+#include <type_traits>
+#endif
+#if (__cplusplus > 201703L)
+//  Recognize the results of three-way comparisons.
+#include <compare>
+#endif
 
 //  Bulk-loading operation is well-suited to threading.
 #ifndef BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD
@@ -52,10 +67,16 @@ namespace heap {
 //! @brief Moves elements in [first,last) to form an interval heap.
 template <typename Iterator, typename Compare>
 void make_interval_heap (Iterator first, Iterator last, Compare compare);
+//! @brief Moves sorted elements in [first,last) to form an interval heap.
+template <typename Iterator>
+void make_interval_heap_from_sorted (Iterator first, Iterator last);
+//! @brief Converts an interval heap to one under the reversed comparison.
+template <typename Iterator>
+void reverse_interval_heap (Iterator first, Iterator last);
 
 //! @brief Expands the interval heap to include the element at last-1.
 template <typename Iterator, typename Compare>
-void push_interval_heap (Iterator first, Iterator last, Compare compare);
+bool push_interval_heap (Iterator first, Iterator last, Compare compare);
 
 //!@{
 //! @brief Moves a minimal element to the back of the range for popping.
@@ -80,6 +101,10 @@ void update_interval_heap (Iterator first, Iterator last,
 //! @brief Sorts an interval heap in ascending order.
 template <typename Iterator, typename Compare>
 void sort_interval_heap (Iterator first, Iterator last, Compare compare);
+//! @brief Sorts an interval heap, removing elements from both ends.
+template <typename Iterator, typename Compare>
+void sort_interval_heap_double_ended (Iterator first, Iterator last,
+                                      Compare compare);
 //! @brief Finds the largest subrange that qualifies as an interval heap.
 template <typename Iterator, typename Compare>
 Iterator is_interval_heap_until (Iterator first, Iterator last,Compare compare);
@@ -87,6 +112,20 @@ Iterator is_interval_heap_until (Iterator first, Iterator last,Compare compare);
 template <typename Iterator, typename Compare>
 bool is_interval_heap (Iterator first, Iterator last, Compare compare);
 
+/*! @brief Whether @a Compare is a three-way comparison of @a Value objects.
+//    A three-way comparison returns a value that is less than, equal to, or
+//  greater than 0 when its first argument is, respectively, less than,
+//  equivalent to, or greater than its second (as do operator<=> and
+//  std::compare_three_way). Every interval-heap function accepts three-way
+//  comparisons, and uses the extra information to stop sifting an element once
+//  it ties with its neighbors.
+//    Comparisons returning std::strong_ordering, std::weak_ordering, or
+//  std::partial_ordering are recognized automatically. Specialize this trait
+//  to mark others (such as comparisons returning int, in the style of strcmp).
+*/
+template <typename Compare, typename Value>
+struct is_three_way_compare;
+
 
 //-------------------------------Book-Keeping-----------------------------------
 /// \cond false
@@ -110,28 +149,282 @@ void make_block (Iterator, Iterator, Compare, Offset, Offset, unsigned int);
 //! @brief Internal function for single-threaded bulk-load.
 template <typename Iterator, typename Compare>
 void make_full (Iterator first, Iterator last, Compare compare);
+//! @brief Minimum heap size for which a double-ended sort is used.
+static const int kDoubleEndedSortMin = 1 << 4;
+/*! @brief Levels a pushed element climbs before it is compared with the root.
+//  Few elements of random input climb this far, so they rarely pay for the
+//  comparison; elements of increasing or decreasing input all do.
+*/
+static const int kRootCheckDepth = 2;
+//! @brief Implements make_interval_heap for a "less-than" comparison.
+template <typename Iterator, typename Compare>
+void make_with_less (Iterator first, Iterator last, Compare compare);
+//! @brief Implements is_interval_heap_until for a "less-than" comparison.
+template <typename Iterator, typename Compare>
+Iterator heap_until_with_less (Iterator first, Iterator last, Compare compare);
+//! @brief Finds a sorted prefix, reversing it if it is in descending order.
+template <typename Iterator, typename Compare>
+Iterator make_sorted_prefix (Iterator first, Iterator last, Compare compare);
+//! @brief Interleaves the two halves of a range, starting with the second.
+template <typename Iterator>
+void in_shuffle (Iterator first, Iterator last);
+//! @brief Reverses in_shuffle.
+template <typename Iterator>
+void in_unshuffle (Iterator first, Iterator last);
+
+//! @brief Whether elements may be moved without risk of losing any.
+template <typename Value>
+struct is_nothrow_movable
+{
+#if (__cplusplus >= 201103L)
+  static const bool value = std::is_nothrow_move_constructible<Value>::value &&
+                            std::is_nothrow_move_assignable<Value>::value;
+#else
+  static const bool value = false;
+#endif
+};
+
+/*! @brief Interleaves the two halves of a range, or separates them again.
+//    The in-place shuffles jump across the whole range, so they are much slower
+//  than streaming through scratch space. Scratch space is only used when
+//  elements can be moved without throwing, and only if it can be allocated.
+*/
+template <bool buffered>
+struct bound_interleaver
+{
+//! @brief Rearranges [ a0 .. an, b0 .. bn ) as [ a0 b0 a1 b1 .. an bn ).
+//! @pre [ @a first, @a middle) and [ @a middle, @a last) have equal length.
+  template <typename Iterator>
+  static void interleave (Iterator first, Iterator middle, Iterator last)
+  {
+//  The first and last elements are already in place.
+    if (middle - first > 1)
+      in_shuffle<Iterator>(first + 1, last - 1);
+  }
+//! @brief Rearranges [ a0 b0 a1 b1 .. an bn ) as [ a0 .. an, b0 .. bn ).
+//! @pre [ @a first, @a middle) and [ @a middle, @a last) have equal length.
+  template <typename Iterator>
+  static void deinterleave (Iterator first, Iterator middle, Iterator last)
+  {
+    if (middle - first > 1)
+      in_unshuffle<Iterator>(first + 1, last - 1);
+  }
+};
+#if (__cplusplus >= 201103L)
+template <>
+struct bound_interleaver<true>
+{
+  template <typename Iterator>
+  static void interleave (Iterator first, Iterator middle, Iterator last)
+  {
+    typedef typename std::iterator_traits<Iterator>::value_type Value;
+    typedef typename std::iterator_traits<Iterator>::difference_type Offset;
+    std::vector<Value> upper;
+    try {
+      upper.reserve(last - middle);
+    } catch (std::bad_alloc &) {
+      bound_interleaver<false>::interleave(first, middle, last);
+      return;
+    }
+    upper.insert(upper.end(), std::make_move_iterator(middle),
+                 std::make_move_iterator(last));
+//  Working backward, each element of the lower half moves to a position
+//  already vacated.
+    for (Offset index = middle - first; index--;) {
+      if (index != 0)
+        *(first + 2 * index) = std::move(*(first + index));
+      *(first + (2 * index + 1)) = std::move(upper[index]);
+    }
+  }
+
+  template <typename Iterator>
+  static void deinterleave (Iterator first, Iterator middle, Iterator last)
+  {
+    typedef typename std::iterator_traits<Iterator>::value_type Value;
+    typedef typename std::iterator_traits<Iterator>::difference_type Offset;
+    const Offset half = middle - first;
+    std::vector<Value> upper;
+    try {
+      upper.reserve(half);
+    } catch (std::bad_alloc &) {
+      bound_interleaver<false>::deinterleave(first, middle, last);
+      return;
+    }
+    for (Offset index = 0; index < half; ++index)
+      upper.push_back(std::move(*(first + (2 * index + 1))));
+//  Working forward, each element moves to a position already vacated.
+    for (Offset index = 1; index < half; ++index)
+      *(first + index) = std::move(*(first + 2 * index));
+    std::move(upper.begin(), upper.end(), middle);
+  }
+};
+#endif
+//! @brief Orders the bounds of each leaf interval in a range.
+template <typename Iterator, typename Offset, typename Compare>
+void make_leaves (Iterator first, Offset index_begin, Offset index_end,
+                  Compare compare);
+
+/*! @brief Whether elements may be ordered by selection instead of by swapping.
+//    Selection performs the comparison twice, but contains no branches, so the
+//  compiler may use packed min/max instructions. This is only worthwhile for
+//  cheap, non-throwing copies and comparisons: built-in types compared by
+//  std::less or std::greater.
+*/
+template <typename Value, typename Compare>
+struct is_branchless_order
+{
+  static const bool value = false;
+};
+#if (__cplusplus >= 201103L)
+template <typename Value>
+struct is_branchless_order<Value, std::less<Value> >
+{
+  static const bool value = std::is_arithmetic<Value>::value ||
+                            std::is_pointer<Value>::value;
+};
+template <typename Value>
+struct is_branchless_order<Value, std::greater<Value> >
+{
+  static const bool value = std::is_arithmetic<Value>::value ||
+                            std::is_pointer<Value>::value;
+};
+#endif
 
 //! @brief Restores the interval-heap property if one leaf element violates it.
 template <typename Iterator, typename Compare>
-void sift_leaf (Iterator first, Iterator last,
+bool sift_leaf (Iterator first, Iterator last,
                 typename std::iterator_traits<Iterator>::difference_type index,
                 Compare compare);
-//! @brief Moves an element up the interval heap.
+/*! @brief Moves an element up the interval heap.
+//  @param check_root If set, an element that climbs kRootCheckDepth levels is
+//  compared with the root, and placed there without further comparisons if it
+//  belongs there.
+//  @return true if the element was placed at the root by that check.
+*/
 template <bool left_bound, typename Iterator, typename Offset, typename Compare>
-void sift_up (Iterator first, Offset index, Compare compare,Offset limit_child);
+bool sift_up (Iterator first, Offset index, Compare compare,Offset limit_child,
+              bool check_root = false);
 //! @brief Moves an element between min/max bounds, and up the interval heap.
 template <typename Iterator, typename Offset, typename Compare>
-void sift_leaf_max (Iterator first, Iterator last, Offset index,
-                    Compare compare, Offset limit_child);
+bool sift_leaf_max (Iterator first, Iterator last, Offset index,
+                    Compare compare, Offset limit_child,
+                    bool check_root = false);
 //! @brief Moves an element between min/max bounds, and up the interval heap.
 template <typename Iterator, typename Offset, typename Compare>
-void sift_leaf_min (Iterator first, Iterator last, Offset index,
-                    Compare compare, Offset limit_child);
+bool sift_leaf_min (Iterator first, Iterator last, Offset index,
+                    Compare compare, Offset limit_child,
+                    bool check_root = false);
 //! @brief Restores the interval-heap property if one element violates it.
 template <bool left_bound, typename Iterator, typename Offset, typename Compare>
 void sift_down (Iterator first, Iterator last, Offset index, Compare compare,
                 Offset limit_child);
 
+//! @brief Whether a comparison result is one of the standard orderings.
+template <typename Result>
+struct is_ordering
+{
+  static const bool value = false;
+};
+#if (__cplusplus > 201703L)
+template <>
+struct is_ordering<std::strong_ordering>
+{
+  static const bool value = true;
+};
+template <>
+struct is_ordering<std::weak_ordering>
+{
+  static const bool value = true;
+};
+template <>
+struct is_ordering<std::partial_ordering>
+{
+  static const bool value = true;
+};
+
+//! @brief The result of a comparison, or void if it cannot be called.
+template <typename Compare, typename Value, typename = void>
+struct comparison_result
+{
+  typedef void type;
+};
+template <typename Compare, typename Value>
+struct comparison_result<Compare, Value,
+          std::void_t<std::invoke_result_t<Compare &, Value const &,
+                                           Value const &> > >
+{
+  typedef std::remove_cvref_t<std::invoke_result_t<Compare &, Value const &,
+                                                   Value const &> > type;
+};
+#endif
+
+//! @brief Presents a three-way comparison as a "less-than" comparison.
+template <typename Compare>
+struct three_way_less
+{
+  explicit three_way_less (Compare const & comp) : compare(comp) {}
+  template <typename Value>
+  bool operator() (Value const & lhs, Value const & rhs) const
+  {
+    return compare(lhs, rhs) < 0;
+  }
+//! @brief Returns -1, 0, or 1 as @a lhs is less than, ties, or exceeds @a rhs.
+  template <typename Value>
+  int order (Value const & lhs, Value const & rhs) const
+  {
+    return sign(compare(lhs, rhs));
+  }
+  template <typename Result>
+  static int sign (Result const & result)
+  {
+    return (result < 0) ? -1 : ((0 < result) ? 1 : 0);
+  }
+  Compare compare;
+};
+
+//! @brief Whether a comparison can report ties without a second call.
+template <typename Compare>
+struct reports_ties
+{
+  static const bool value = false;
+};
+template <typename Compare>
+struct reports_ties<three_way_less<Compare> >
+{
+  static const bool value = true;
+};
+
+/*! @brief Returns -1, 0, or 1 as @a lhs is less than, ties, or exceeds @a rhs.
+//    Only used where reports_ties holds; a "less-than" comparison would need to
+//  be called twice.
+*/
+template <typename Compare, typename Value>
+int tie_order (Compare & compare, Value const & lhs, Value const & rhs)
+{
+  return compare(lhs, rhs) ? -1 : (compare(rhs, lhs) ? 1 : 0);
+}
+template <typename Compare, typename Value>
+int tie_order (three_way_less<Compare> & compare, Value const & lhs,
+               Value const & rhs)
+{
+  return compare.order(lhs, rhs);
+}
+
+//! @brief Selects the "less-than" comparison with which the heap is arranged.
+template <typename Compare, typename Value,
+          bool three_way = is_three_way_compare<Compare, Value>::value>
+struct heap_compare
+{
+  typedef Compare type;
+  static Compare const & adapt (Compare const & compare) { return compare; }
+};
+template <typename Compare, typename Value>
+struct heap_compare<Compare, Value, true>
+{
+  typedef three_way_less<Compare> type;
+  static type adapt (Compare const & compare) { return type(compare); }
+};
+
 template<class T>
 struct RAIISwapper
 {
@@ -161,6 +454,20 @@ struct RAIISwapper
 } //  Namespace interval_heap_internal
 /// \endcond
 
+template <typename Compare, typename Value>
+struct is_three_way_compare
+{
+#if (__cplusplus > 201703L)
+  static const bool value = interval_heap_internal::is_ordering<
+    typename interval_heap_internal::comparison_result<Compare,
+                                                       Value>::type>::value;
+#else
+  static const bool value = false;
+#endif
+};
+template <typename Compare, typename Value>
+const bool is_three_way_compare<Compare, Value>::value;
+
 /*! @details This function restores the interval-heap property violated by the
 //  specified element.
 //  @param first,last A range of random-access iterators.
@@ -185,10 +492,15 @@ void update_interval_heap (Iterator first, Iterator last,
   using namespace std;
   using interval_heap_internal::sift_down;
   typedef typename iterator_traits<Iterator>::difference_type Offset;
+  typedef interval_heap_internal::heap_compare<Compare,
+            typename iterator_traits<Iterator>::value_type> adapted;
+  typedef typename adapted::type Less;
   if (index & 1)
-    sift_down<false, Iterator, Offset, Compare>(first, last, index, compare,2);
+    sift_down<false, Iterator, Offset, Less>(first, last, index,
+                                             adapted::adapt(compare), 2);
   else
-    sift_down<true, Iterator, Offset, Compare>(first, last, index, compare, 2);
+    sift_down<true, Iterator, Offset, Less>(first, last, index,
+                                            adapted::adapt(compare), 2);
 }
 
 /*! @details This function expands an interval heap from [ @a first, @a last -
@@ -196,19 +508,28 @@ void update_interval_heap (Iterator first, Iterator last,
 //  typically used to add a new element to the interval heap.
 //  @param first,last A range of random-access iterators.
 //  @param compare A comparison object.
+//  @return true if the new element was beyond an end of the heap (for example,
+//  a new maximum), and so was moved to the root without being compared with
+//  each bound along the way.
 //  @pre [ @a first, @a last - 1) is a valid interval heap.
 //  @post [ @a first, @a last) is a valid interval heap.
 //  @invariant No element is added to or removed from the range.
 //  @par  Complexity:
-//    O(log n) - Logarithmic on the size of the heap.
+//    O(log n) - Logarithmic on the size of the heap. An element that climbs
+//  a few levels is compared with the root; if it belongs there, it is placed
+//  with O(1) comparisons in total. Increasing or decreasing input (such as
+//  timestamps) therefore needs only a few comparisons per push.
 //  @par  Exception safety:
 //    Strong (rollback) if move/copy/swap (depending on C++ year) do not throw
 //  exceptions.
 */
 template <typename Iterator, typename Compare>
-void push_interval_heap (Iterator first, Iterator last, Compare compare) {
+bool push_interval_heap (Iterator first, Iterator last, Compare compare) {
   using interval_heap_internal::sift_leaf;
-  sift_leaf<Iterator, Compare>(first, last, (last - first) - 1, compare);
+  typedef interval_heap_internal::heap_compare<Compare,
+            typename std::iterator_traits<Iterator>::value_type> adapted;
+  return sift_leaf<Iterator, typename adapted::type>(first, last,
+                              (last - first) - 1, adapted::adapt(compare));
 }
 
 /*! @details This function moves a specified element to the end of the range of
@@ -280,7 +601,10 @@ void pop_interval_heap_min (Iterator first, Iterator last, Compare compare) {
 #else
     guard_t scope_guard (&(*first), &(*last));
 #endif
-    sift_down<true, Iterator, Offset, Compare>(first, last, 0, compare, 2);
+    typedef interval_heap_internal::heap_compare<Compare,
+              typename iterator_traits<Iterator>::value_type> adapted;
+    sift_down<true, Iterator, Offset, typename adapted::type>(first, last, 0,
+                                                adapted::adapt(compare), 2);
     scope_guard.disable();
   }
 }
@@ -317,7 +641,10 @@ void pop_interval_heap_max (Iterator first, Iterator last, Compare compare) {
   guard_t scope_guard (&(*(first + 1)), &(*last));
 #endif
   swap(*scope_guard.ptr1_, *scope_guard.ptr2_);
-  sift_down<false, Iterator, Offset, Compare>(first, last, 1, compare, 2);
+  typedef interval_heap_internal::heap_compare<Compare,
+            typename iterator_traits<Iterator>::value_type> adapted;
+  sift_down<false, Iterator, Offset, typename adapted::type>(first, last, 1,
+                                                adapted::adapt(compare), 2);
   scope_guard.disable();
 }
 
@@ -343,6 +670,57 @@ void sort_interval_heap (Iterator first, Iterator last, Compare compare) {
   }
 }
 
+/*! @details This function takes an interval heap and sorts its elements in
+//  ascending order. Minimal and maximal elements are removed alternately, so
+//  that both the left and right bounds are drawn down evenly. The removed
+//  elements are interleaved at the back of the range, and are separated
+//  without comparisons once the heap is exhausted. Small heaps, for which the
+//  separation step does not pay for itself, are sorted by sort_interval_heap.
+//  @param first,last A range of random-access iterators.
+//  @param compare A comparison object.
+//  @pre [ @a first, @a last) is a valid interval heap.
+//  @post [ @a first, @a last) is sorted in ascending order.
+//  @invariant No element is added to or removed from the range.
+//  @par  Complexity:
+//    O(n log n) - Linearithmic on the size of the heap.
+//  @par  Exception safety:
+///   Basic - Elements are not added to or removed from the range.
+*/
+template <typename Iterator, typename Compare>
+void sort_interval_heap_double_ended (Iterator first, Iterator last,
+                                      Compare compare)
+{
+  using namespace std;
+  typedef typename iterator_traits<Iterator>::difference_type Offset;
+  typedef typename iterator_traits<Iterator>::value_type Value;
+
+  const Offset size = last - first;
+  if (size < interval_heap_internal::kDoubleEndedSortMin) {
+    sort_interval_heap<Iterator, Compare>(first, last, compare);
+    return;
+  }
+//  An odd-sized heap leaves its median at the front.
+  bool take_maximum = true;
+  for (Iterator cursor = last; cursor - first > 1; --cursor) {
+//  If this throws, anything I do to try to fix it is also likely to throw.
+    if (take_maximum)
+      pop_interval_heap_max<Iterator, Compare>(first, cursor, compare);
+    else
+      pop_interval_heap_min<Iterator, Compare>(first, cursor, compare);
+    take_maximum = !take_maximum;
+  }
+//  Lesser elements are at even offsets (descending), greater at odd offsets
+//  (ascending).
+  const Iterator removed = first + (size & 1);
+  const Iterator middle = removed + (size / 2);
+  interval_heap_internal::bound_interleaver<
+    interval_heap_internal::is_nothrow_movable<Value>::value>::deinterleave(
+      removed, middle, last);
+  reverse(removed, middle);
+  if (size & 1)
+    rotate(first, removed, middle);
+}
+
 //! @brief Finds the largest subrange that forms a valid interval heap.
 /// @par  Complexity:
 ///   O(n) - Linear on the size of the heap.
@@ -351,37 +729,11 @@ void sort_interval_heap (Iterator first, Iterator last, Compare compare) {
 template <typename Iterator, typename Compare>
 Iterator is_interval_heap_until (Iterator first, Iterator last, Compare compare)
 {
-  using namespace std;
-  typedef typename iterator_traits<Iterator>::difference_type Offset;
-
-  Offset index = static_cast<Offset>(0);
-
-  try {
-    Offset index_end = last - first;
-    while (index < index_end) {
-      Iterator cursor = first + index;
-//  Check whether it is a valid interval.
-      if ((index & 1) && compare(*cursor, *(cursor - 1)))
-        return cursor;
-      if (index >= 2) {
-//  If there exists a parent interval, check for containment.
-        Iterator parent = first + ((index / 2 - 1) | 1);
-        if (index & 1) {
-          if (compare(*parent, *cursor))
-            return cursor;
-        } else {
-          if (compare(*parent, *cursor))
-            return cursor;
-          if (compare(*cursor, *(parent - 1)))
-            return cursor;
-        }
-      }
-      ++index;
-    }
-  } catch (...) {
-    return first + index;
-  }
-  return last;
+//  Three-way comparisons are checked through their "less-than" adaptor.
+  typedef interval_heap_internal::heap_compare<Compare,
+            typename std::iterator_traits<Iterator>::value_type> adapted;
+  return interval_heap_internal::heap_until_with_less<Iterator,
+           typename adapted::type>(first, last, adapted::adapt(compare));
 }
 
 //! @brief Checks whether the range is a valid interval heap.
@@ -409,13 +761,107 @@ bool is_interval_heap (Iterator first, Iterator last, Compare compare) {
 /// @par  Exception safety:
 ///   Basic - Elements are not added to or removed from the range.
 //  @remark Threaded.
+//  @remark Input that is sorted (in either direction) is detected, and is
+//  arranged without further comparisons. If only a short tail is out of order,
+//  the sorted prefix is arranged and the tail is inserted element-by-element.
 */
 template <typename Iterator, typename Compare>
 void make_interval_heap (Iterator first, Iterator last, Compare compare) {
-  using namespace interval_heap_internal;
+//  Three-way comparisons are used through their "less-than" adaptor.
+  typedef interval_heap_internal::heap_compare<Compare,
+            typename std::iterator_traits<Iterator>::value_type> adapted;
+  interval_heap_internal::make_with_less<Iterator, typename adapted::type>(
+                                        first, last, adapted::adapt(compare));
+}
+
+/*! @details This function moves the elements of a sorted range to form an
+//  interval heap. The lesser half of the elements become left bounds, in
+//  ascending order, and the greater half become right bounds, in descending
+//  order. No comparisons are performed.
+//  @param first,last A range of random-access iterators.
+//  @pre [ @a first, @a last) is sorted in ascending order with respect to the
+//  comparison object with which the interval heap will be used.
+//  @post [ @a first, @a last) is a valid interval heap.
+//  @invariant No element is added to or removed from the range.
+//  @par  Complexity:
+//    O(n) - Linear on the size of the heap. Only swaps are performed.
+//  @par  Exception safety:
+//    Basic - Elements are not added to or removed from the range.
+*/
+template <typename Iterator>
+void make_interval_heap_from_sorted (Iterator first, Iterator last) {
+  using namespace std;
+  typedef typename iterator_traits<Iterator>::difference_type Offset;
+
+  const Offset half = (last - first) / 2;
+  if (half == 0)
+    return;
+  Iterator middle = first + half;
+//  The median is a singleton; it belongs at the end.
+  if ((last - first) & 1) {
+    rotate(middle, middle + 1, last);
+    --last;
+  }
+//  Right bounds descend.
+  reverse(middle, last);
+  typedef typename iterator_traits<Iterator>::value_type Value;
+  interval_heap_internal::bound_interleaver<
+    interval_heap_internal::is_nothrow_movable<Value>::value>::interleave(
+      first, middle, last);
+}
+
+/** @brief Converts an interval heap to one under the reversed comparison.
+//  @param first,last A range of random-access iterators.
+//  @pre [ @a first, @a last) is a valid interval heap with respect to some
+//  comparison object.
+//  @post [ @a first, @a last) is a valid interval heap with respect to the
+//  reverse of that comparison object (for example, std::greater instead of
+//  std::less).
+//  @details Each interval's bounds are exchanged; the minimum heap becomes the
+//  maximum heap, and vice-versa. Because each interval is handled
+//  independently, any subrange that begins at an even offset from the start
+//  of the heap may be reversed separately (for example, by another thread).
+//  @par  Complexity:
+//    O(n) - Linear on the size of the heap. Only swaps are performed.
+//  @par  Exception safety:
+//    Basic - Elements are not added to or removed from the range.
+*/
+template <typename Iterator>
+void reverse_interval_heap (Iterator first, Iterator last) {
+  using namespace std;
+//  A trailing singleton is both bounds of its interval.
+  if ((last - first) & 1)
+    --last;
+  for (; first != last; first += 2)
+    iter_swap(first, first + 1);
+}
+
+namespace interval_heap_internal {
+//! @brief Bulk-loads with a "less-than" comparison; see make_interval_heap.
+template <typename Iterator, typename Compare>
+void make_with_less (Iterator first, Iterator last, Compare compare) {
+  typedef typename std::iterator_traits<Iterator>::difference_type Offset;
 //  Double-heap property holds vacuously.
   if (last - first < 2)
     return;
+//  Random input leaves the sorted prefix after only a few comparisons.
+  const Iterator sorted_end = make_sorted_prefix<Iterator, Compare>(first, last,
+                                                                    compare);
+  if (sorted_end == last) {
+    make_interval_heap_from_sorted<Iterator>(first, last);
+    return;
+  }
+//    Each insertion costs at most about log2(n) comparisons. Use insertion only
+//  if that bounds the total by about n, which is less than a full bulk-load.
+  Offset log_size = 0;
+  for (Offset size = last - first; size > 1; size >>= 1)
+    ++log_size;
+  if ((last - sorted_end) * log_size <= last - first) {
+    make_interval_heap_from_sorted<Iterator>(first, sorted_end);
+    for (Iterator cursor = sorted_end; cursor != last;)
+      push_interval_heap<Iterator, Compare>(first, ++cursor, compare);
+    return;
+  }
 #if (BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD == true)
   typedef typename std::iterator_traits<Iterator>::difference_type Offset;
   unsigned int threads = ((last - first) > kThreadMin)?
@@ -429,7 +875,43 @@ void make_interval_heap (Iterator first, Iterator last, Compare compare) {
 #endif
 }
 
-namespace interval_heap_internal {
+//! @brief Checks with a "less-than" comparison; see is_interval_heap_until.
+template <typename Iterator, typename Compare>
+Iterator heap_until_with_less (Iterator first, Iterator last, Compare compare)
+{
+  using namespace std;
+  typedef typename iterator_traits<Iterator>::difference_type Offset;
+
+  Offset index = static_cast<Offset>(0);
+
+  try {
+    Offset index_end = last - first;
+    while (index < index_end) {
+      Iterator cursor = first + index;
+//  Check whether it is a valid interval.
+      if ((index & 1) && compare(*cursor, *(cursor - 1)))
+        return cursor;
+      if (index >= 2) {
+//  If there exists a parent interval, check for containment.
+        Iterator parent = first + ((index / 2 - 1) | 1);
+        if (index & 1) {
+          if (compare(*parent, *cursor))
+            return cursor;
+        } else {
+          if (compare(*parent, *cursor))
+            return cursor;
+          if (compare(*cursor, *(parent - 1)))
+            return cursor;
+        }
+      }
+      ++index;
+    }
+  } catch (...) {
+    return first + index;
+  }
+  return last;
+}
+
 #if (BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD == true)
 /*    This parallel version of the heap-maker uses divide-and-conquer methods to
 //  distribute the task amongst the cores.
@@ -490,13 +972,8 @@ void make_block (Iterator first, Iterator last, Compare compare,
 /*    Make this layer of the interval heap; we assume that all lower layers are
 //  already OK.
 */
-    for (Offset index = block_end - 2; (index > block_begin); index -= 2) {
-      const Offset coindex = index | 1; //  = index + 1
-//  If compare throws, heap property cannot be verified or enforced.
-//  If swap throws, heap property is violated and cannot be enforced.
-      if (compare(*(first + coindex), *(first + index)))
-        swap(*(first + coindex), *(first + index));
-    }
+    make_leaves<Iterator, Offset, Compare>(first, block_begin + 2, block_end,
+                                           compare);
     const Offset coindex = block_begin | 1;
     if (coindex < block_end) {
 //  If compare throws, heap property cannot be verified or enforced.
@@ -524,16 +1001,11 @@ void make_full (Iterator first, Iterator last, Compare compare) {
   const Offset index_end = last - first;
 //  Prevents overflow when number of elements approaches maximum possible index.
   const Offset end_parent = index_end / 2 - 1;
-//  If the final interval is a singleton, it's already OK. Skip it.
-  Offset index = (index_end ^ (index_end & 1)) - 2;
-//  Make all leaf nodes.
-  while (index > end_parent) {
-    const Offset coindex = index | 1; //  = index + 1
-    if (compare(*(first + coindex), *(first + index)))
-      swap(*(first + coindex), *(first + index));
-    index -= 2;
-  }
-  index += 2;
+//  First leaf node (the smallest even index greater than end_parent).
+  Offset index = (end_parent | 1) + 1;
+//  Make all leaf nodes. If the final interval is a singleton, it's already OK.
+  make_leaves<Iterator, Offset, Compare>(first, index,
+                                         index_end ^ (index_end & 1), compare);
   do {
     const Offset coindex = --index; //  = index + 1
     --index;
@@ -548,9 +1020,145 @@ void make_full (Iterator first, Iterator last, Compare compare) {
   } while (index >= 2);
 }
 
+//! @pre [ @a first, @a last) contains at least two elements.
+//! @remark Exception safety: Basic. Elements are only reordered by swapping.
+template <typename Iterator, typename Compare>
+Iterator make_sorted_prefix (Iterator first, Iterator last, Compare compare)
+{
+  using namespace std;
+  Iterator cursor = first + 1;
+//  Ascending (non-strictly).
+  while ((cursor != last) && !compare(*cursor, *(cursor - 1)))
+    ++cursor;
+  if (cursor - first > 1)
+    return cursor;
+//  Strictly descending; reversing a non-strict sequence would be pointless.
+  while ((cursor != last) && compare(*cursor, *(cursor - 1)))
+    ++cursor;
+  reverse(first, cursor);
+  return cursor;
+}
+
+/*    In-place in-shuffle by the cycle-leader algorithm of P. Jain, "A Simple
+//  In-Place Algorithm for In-Shuffle" (2004). For a prefix of length 3^k - 1,
+//  the permutation decomposes into cycles led by 1, 3, ..., 3^(k-1).
+*/
+//! @pre The range has even length.
+//! @remark Exception safety: Basic. Elements are only reordered by swapping.
+template <typename Iterator>
+void in_shuffle (Iterator first, Iterator last)
+{
+  using namespace std;
+  typedef typename iterator_traits<Iterator>::difference_type Offset;
+
+  Offset half = (last - first) / 2;
+  while (half > 0) {
+//  Largest power of 3 not exceeding 2 * half + 1.
+    Offset power = 1;
+    while (power <= (2 * half + 1) / 3)
+      power *= 3;
+    const Offset prefix_half = (power - 1) / 2;
+//  Gather the first prefix_half elements of each half into the prefix.
+    rotate(first + prefix_half, first + half, first + (half + prefix_half));
+//  Position p (one-based) moves to 2p mod 3^k.
+    for (Offset leader = 1; leader < power; leader *= 3) {
+      for (Offset index = (leader * 2) % power; index != leader;
+           index = (index * 2) % power)
+        swap(*(first + (leader - 1)), *(first + (index - 1)));
+    }
+    first += prefix_half * 2;
+    half -= prefix_half;
+  }
+}
+
+//! @pre The range has even length.
+//! @remark Exception safety: Basic. Elements are only reordered by swapping.
+template <typename Iterator>
+void in_unshuffle (Iterator first, Iterator last)
+{
+  using namespace std;
+  typedef typename iterator_traits<Iterator>::difference_type Offset;
+
+  const Offset half = (last - first) / 2;
+  if (half == 0)
+    return;
+//  Undo the steps of in_shuffle in reverse order, starting with the last.
+  Offset power = 1;
+  while (power <= (2 * half + 1) / 3)
+    power *= 3;
+  const Offset prefix_half = (power - 1) / 2;
+  in_unshuffle<Iterator>(first + prefix_half * 2, last);
+//  Position p (one-based) moves to p/2 mod 3^k.
+  for (Offset leader = 1; leader < power; leader *= 3) {
+    Offset index = (leader + power) / 2;  //  Leaders are odd.
+    while (index != leader) {
+      swap(*(first + (leader - 1)), *(first + (index - 1)));
+      index = (index & 1) ? ((index + power) / 2) : (index / 2);
+    }
+  }
+  rotate(first + prefix_half, first + prefix_half * 2,
+         first + (half + prefix_half));
+}
+
+//  Orders leaf intervals one at a time. Works for any element type.
+template <bool branchless>
+struct leaf_maker
+{
+  template <typename Iterator, typename Offset, typename Compare>
+  static void make (Iterator first, Offset index_begin, Offset index_end,
+                    Compare compare)
+  {
+    using namespace std;
+    for (Offset index = index_begin; index < index_end; index += 2) {
+      const Offset coindex = index | 1; //  = index + 1
+//  If compare throws, heap property cannot be verified or enforced.
+//  If swap throws, heap property is violated and cannot be enforced.
+      if (compare(*(first + coindex), *(first + index)))
+        swap(*(first + coindex), *(first + index));
+    }
+  }
+};
+
+//  Orders leaf intervals by selecting the lower and upper bound of each. With
+//  no branch in the loop body, compilers emit packed min/max instructions.
+template <>
+struct leaf_maker<true>
+{
+  template <typename Iterator, typename Offset, typename Compare>
+  static void make (Iterator first, Offset index_begin, Offset index_end,
+                    Compare compare)
+  {
+    typedef typename std::iterator_traits<Iterator>::value_type Value;
+//  Note: "index + 1" rather than "index | 1", so that the access pattern is
+//  recognizably linear.
+    for (Offset index = index_begin; index < index_end; index += 2) {
+      const Value left = *(first + index);
+      const Value right = *(first + index + 1);
+//  Both values are computed before either is stored, to permit vectorization.
+      const Value lower = compare(right, left) ? right : left;
+      const Value upper = compare(right, left) ? left : right;
+      *(first + index) = lower;
+      *(first + index + 1) = upper;
+    }
+  }
+};
+
+//! @pre @a index_begin and @a index_end are even.
+//! @pre No element in [ @a index_begin, @a index_end) has a child.
+template <typename Iterator, typename Offset, typename Compare>
+void make_leaves (Iterator first, Offset index_begin, Offset index_end,
+                  Compare compare)
+{
+  typedef typename std::iterator_traits<Iterator>::value_type Value;
+  leaf_maker<is_branchless_order<Value, Compare>::value>::make(first,
+                                        index_begin, index_end, compare);
+}
+
 //! @remark Exception safety: Strong if move/swap doesn't throw.
+//! @pre If @a check_root is set, @a limit_child is 2.
 template <bool left_bound, typename Iterator, typename Offset, typename Compare>
-void sift_up (Iterator first, Offset origin, Compare compare,Offset limit_child)
+bool sift_up (Iterator first, Offset origin, Compare compare,Offset limit_child,
+              bool check_root)
 {
 //  Use the most specialized available functions.
   using namespace std;
@@ -561,6 +1169,9 @@ void sift_up (Iterator first, Offset origin, Compare compare,Offset limit_child)
 //  Float element in limbo while sifting it up the heap.
   Value limbo = std::move_if_noexcept(*(first + index));
 #endif
+//  Whether the element was found to belong at the root, and placed there.
+  bool shortcut = false;
+  int climbed = 0;
 //  Provides strong exception-safety guarantee (rollback), unless move throws.
   try {
     while (index >= limit_child) {
@@ -577,6 +1188,34 @@ void sift_up (Iterator first, Offset origin, Compare compare,Offset limit_child)
         index = parent;
       } else
         break;
+/*    Increasing (or decreasing) keys, such as timestamps, climb all the way to
+//  the root. One comparison with the root finds them; the remaining bounds on
+//  the path then move down a level each without being compared. Elements that
+//  stop early (most elements, for random input) never pay for the check.
+*/
+      if (check_root && (++climbed == kRootCheckDepth)) {
+        check_root = false;
+        const Offset root = left_bound ? 0 : 1;
+        if (index >= limit_child &&
+#if (__cplusplus >= 201103L)  //  C++11
+            compare((left_bound ? limbo : *(first + root)),
+                    (left_bound ? *(first + root) : limbo))) {
+#else
+            compare(*(first + (left_bound ? index : root)),
+                    *(first + (left_bound ? root : index)))) {
+#endif
+          while (index >= limit_child) {
+            const Offset parent = ((index / 2 - 1) | 1) ^ (left_bound ? 1 : 0);
+#if (__cplusplus >= 201103L)  //  C++11
+            *(first + index) = std::move_if_noexcept(*(first + parent));
+#else
+            swap(*(first + index), *(first + parent));
+#endif
+            index = parent;
+          }
+          shortcut = true;
+        }
+      }
     }
   } catch (...) { //  Provides strong exception-safety guarantee.
 //  I need limbo because elements are being moved in the direction of travel.
@@ -595,13 +1234,14 @@ void sift_up (Iterator first, Offset origin, Compare compare,Offset limit_child)
 //  Done sifting. Get the element out of limbo.
   *(first + index) = std::move_if_noexcept(limbo);
 #endif
+  return shortcut;
 }
 
 //! @remark Exception safety: As strong as sift_up.
 //! @pre @a index refers to a leaf node of the heap.
 template <typename Iterator, typename Offset, typename Compare>
-void sift_leaf_max (Iterator first, Iterator last, Offset index,
-                    Compare compare, Offset limit_child)
+bool sift_leaf_max (Iterator first, Iterator last, Offset index,
+                    Compare compare, Offset limit_child, bool check_root)
 {
 //  Use the most specialized swap function.
   using namespace std;
@@ -619,19 +1259,20 @@ void sift_leaf_max (Iterator first, Iterator last, Offset index,
     guard_t scope_guard (&(*(first + index)), &(*(first + co_index)));
 #endif
     swap(*scope_guard.ptr1_, *scope_guard.ptr2_);
-    sift_up<true, Iterator, Offset, Compare>(first, co_index, compare,
-                                             limit_child);
+    const bool shortcut = sift_up<true, Iterator, Offset, Compare>(first,
+                                    co_index, compare, limit_child, check_root);
     scope_guard.disable();
+    return shortcut;
   } else
-    sift_up<false, Iterator, Offset, Compare>(first, index, compare,
-                                              limit_child);
+    return sift_up<false, Iterator, Offset, Compare>(first, index, compare,
+                                                     limit_child, check_root);
 }
 
 //! @remark Exception safety: As strong as sift_up.
 //! @pre @a index refers to a leaf node of the heap.
 template <typename Iterator, typename Offset, typename Compare>
-void sift_leaf_min (Iterator first, Iterator last, Offset index,
-                    Compare compare, Offset limit_child)
+bool sift_leaf_min (Iterator first, Iterator last, Offset index,
+                    Compare compare, Offset limit_child, bool check_root)
 {
 //  Use the most specialized swap function.
   using namespace std;
@@ -643,7 +1284,7 @@ void sift_leaf_min (Iterator first, Iterator last, Offset index,
   if (co_index >= index_end) {
 //  Only one element.
     if (co_index == 1)
-      return;
+      return false;
     co_index = (co_index / 2 - 1) | 1;
   }
   if (compare(*(first + co_index), *(first + index))) {
@@ -654,11 +1295,13 @@ void sift_leaf_min (Iterator first, Iterator last, Offset index,
     guard_t scope_guard (&(*(first + index)), &(*(first + co_index)));
 #endif
     swap(*scope_guard.ptr1_, *scope_guard.ptr2_);
-    sift_up<false, Iterator, Offset, Compare>(first, co_index, compare,
-                                              limit_child);
+    const bool shortcut = sift_up<false, Iterator, Offset, Compare>(first,
+                                    co_index, compare, limit_child, check_root);
     scope_guard.disable();
+    return shortcut;
   } else
-    sift_up<true, Iterator, Offset, Compare>(first, index, compare,limit_child);
+    return sift_up<true, Iterator, Offset, Compare>(first, index, compare,
+                                                    limit_child, check_root);
 }
 
 //! @remark Exception safety: As strong as sift_up.
@@ -680,6 +1323,8 @@ void sift_down (Iterator first, Iterator last, Offset origin, Compare compare,
 //  One past the last element with two children.
   const Offset end_parent = index_end / 2 -
                               ((left_bound && ((index_end & 3) == 0)) ? 2 : 1);
+//  Whether the moving element has found its place before reaching a leaf.
+  bool settled = false;
   try { //  This try-catch block rolls back after exceptions.
     while (index < end_parent) {
       Offset child = index * 2 + (left_bound ? 2 : 1);
@@ -688,6 +1333,21 @@ void sift_down (Iterator first, Iterator last, Offset origin, Compare compare,
         if (compare(*(first + child + (left_bound ? 2 : 0)),
                     *(first + child + (left_bound ? 0 : 2))))
           child += 2;
+/*    A three-way comparison tells, in a single call, whether the moving element
+//  ties with the better child. If it does (or if it is better still), the
+//  descent stops here. With many equal elements, this usually happens long
+//  before a leaf is reached.
+*/
+        if (interval_heap_internal::reports_ties<Compare>::value) {
+#if (__cplusplus >= 201103L)  //  C++11
+          Value const & moving = limbo;
+#else
+          typename iterator_traits<Iterator>::value_type const & moving =
+                                                            *(first + index);
+#endif
+          settled = (left_bound ? tie_order(compare, moving, *(first + child))
+                          : tie_order(compare, *(first + child), moving)) <= 0;
+        }
       } catch (...) {
 #if (__cplusplus >= 201103L)  //  C++11
 //  Pull the moving element out of limbo, to avoid leaks.
@@ -695,6 +1355,8 @@ void sift_down (Iterator first, Iterator last, Offset origin, Compare compare,
 #endif
         throw;  //  Re-throw the current exception.
       }
+      if (settled)
+        break;
 #if (__cplusplus >= 201103L)  //  C++11
       *(first + index) = std::move_if_noexcept(*(first + child));
 #else
@@ -702,6 +1364,18 @@ void sift_down (Iterator first, Iterator last, Offset origin, Compare compare,
 #endif
       index = child;
     }
+/*    Below the origin, the element is known to belong beneath its parent. At
+//  the origin itself, it may yet need to rise.
+*/
+    if (settled) {
+#if (__cplusplus >= 201103L)  //  C++11
+      *(first + index) = std::move_if_noexcept(limbo);
+#endif
+      if (index == origin)
+        sift_up<left_bound, Iterator, Offset, Compare>(first, index, compare,
+                                                       limit_child);
+      return;
+    }
 //  Special case when index has exactly one child.
     if (index <= end_parent + (left_bound ? 0 : 1)) {
       Offset child = index * 2 + (left_bound ? 2 : 1);
@@ -765,16 +1439,18 @@ void sift_down (Iterator first, Iterator last, Offset origin, Compare compare,
 
 //! @remark Exception safety: As strong as sift_up.
 template <typename Iterator, typename Compare>
-void sift_leaf (Iterator first, Iterator last,
+bool sift_leaf (Iterator first, Iterator last,
                 typename std::iterator_traits<Iterator>::difference_type index,
                 Compare compare)
 {
   using namespace std;
   typedef typename iterator_traits<Iterator>::difference_type Offset;
   if (index & 1)
-    sift_leaf_max<Iterator, Offset, Compare>(first, last, index, compare, 2);
+    return sift_leaf_max<Iterator, Offset, Compare>(first, last, index,
+                                                    compare, 2, true);
   else
-    sift_leaf_min<Iterator, Offset, Compare>(first, last, index, compare, 2);
+    return sift_leaf_min<Iterator, Offset, Compare>(first, last, index,
+                                                    compare, 2, true);
 }
 } //  Namespace interval_heap_internal
 } //  Namespace heap
@@ -0,0 +1,340 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file normalized_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    normalized_priority_deque.hpp provides order-preserving encodings of
+//  common key types as unsigned integers, and the class
+//  normalized_priority_deque, which stores its elements so encoded.
+//    Unsigned integers compare in a single instruction, and permit the
+//  branch-free kernels of interval_heap.hpp, even when the original keys
+//  (floating-point numbers, signed integers, or pairs) do not.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for priority_deque. Encoding and decoding do not throw.
+*/
+
+#ifndef BOOST_CONTAINER_NORMALIZED_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_NORMALIZED_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error normalized_priority_deque.hpp requires a C++ compiler.
+#endif
+
+//  Grab std::numeric_limits, to find the width and sign of integral types.
+#include <limits>
+//  Grab std::memcpy, to reinterpret floating-point numbers.
+#include <cstring>
+//  Fixed-width encodings.
+#include <stdint.h>
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+/// \cond false
+namespace key_normalizer_internal {
+//! @brief Smallest unsigned integer with at least the specified number of bits.
+template <int bits, bool fits8 = (bits <= 8), bool fits16 = (bits <= 16),
+          bool fits32 = (bits <= 32)>
+struct unsigned_of { typedef uint64_t type; };
+template <int bits>
+struct unsigned_of<bits, true, true, true> { typedef uint8_t type; };
+template <int bits>
+struct unsigned_of<bits, false, true, true> { typedef uint16_t type; };
+template <int bits>
+struct unsigned_of<bits, false, false, true> { typedef uint32_t type; };
+
+//! @brief Encoding of integral types. Undefined for other types.
+template <typename Integer, bool is_integer>
+struct integer_normalizer;
+template <typename Integer>
+struct integer_normalizer<Integer, true>
+{
+  static const int bits = std::numeric_limits<Integer>::digits +
+                          (std::numeric_limits<Integer>::is_signed ? 1 : 0);
+  typedef typename unsigned_of<bits>::type normalized_type;
+//  Flipping the sign bit maps the least value to zero, and the greatest to
+//  the greatest.
+  static normalized_type sign_bit (void)
+  {
+    return std::numeric_limits<Integer>::is_signed ?
+           static_cast<normalized_type>(static_cast<normalized_type>(1) <<
+                                        (bits - 1)) : 0;
+  }
+  static normalized_type encode (Integer value)
+  {
+    return static_cast<normalized_type>(static_cast<normalized_type>(value) ^
+                                        sign_bit());
+  }
+  static Integer decode (normalized_type key)
+  {
+    return static_cast<Integer>(static_cast<normalized_type>(key ^ sign_bit()));
+  }
+};
+
+//! @brief Encoding of IEEE 754 floating-point types.
+//! @details Positive numbers have their sign bit set; negative numbers have
+//! every bit inverted, so that greater magnitudes become smaller keys.
+template <typename Float, typename Unsigned>
+struct float_normalizer
+{
+  static const int bits = static_cast<int>(sizeof(Unsigned)) * 8;
+  typedef Unsigned normalized_type;
+//  Compile-time assertion that the type is the expected width.
+  typedef char size_matches[(sizeof(Float) == sizeof(Unsigned) &&
+                             std::numeric_limits<Float>::is_iec559) ? 1 : -1];
+  static normalized_type sign_bit (void)
+  {
+    return static_cast<Unsigned>(1) << (bits - 1);
+  }
+  static normalized_type encode (Float value)
+  {
+    Unsigned key;
+    std::memcpy(&key, &value, sizeof(key));
+    return (key & sign_bit()) ? static_cast<Unsigned>(~key)
+                              : static_cast<Unsigned>(key | sign_bit());
+  }
+  static Float decode (normalized_type key)
+  {
+    key = (key & sign_bit()) ? static_cast<Unsigned>(key ^ sign_bit())
+                             : static_cast<Unsigned>(~key);
+    Float value;
+    std::memcpy(&value, &key, sizeof(value));
+    return value;
+  }
+};
+} //  Namespace key_normalizer_internal
+/// \endcond
+
+//----------------------------Key Normalization--------------------------------|
+/*! @brief Order-preserving encoding of a type as an unsigned integer.
+ *  @details For all a and b of type T, a < b implies
+ *  encode(a) < encode(b), and decode(encode(a)) is a.
+ *  Specializations are provided for integral types, float, double, and pairs
+ *  of normalizable types that together fit in 64 bits (which are ordered
+ *  lexicographically). Other types may be supported by specializing this
+ *  template, providing @a bits, @a normalized_type, @a encode, and @a decode.
+ *  @note Floating-point numbers are ordered as by std::less, except that -0 is
+ *  ordered before +0. NaNs are ordered beyond the infinities, according to
+ *  their sign bits.
+ *  @see normalize_prefix
+ */
+template <typename T, bool is_integer = std::numeric_limits<T>::is_integer>
+struct key_normalizer
+  : public key_normalizer_internal::integer_normalizer<T, is_integer>
+{
+};
+
+//! @brief Single-precision floating-point numbers.
+template <>
+struct key_normalizer<float, false>
+  : public key_normalizer_internal::float_normalizer<float, uint32_t>
+{
+};
+//! @brief Double-precision floating-point numbers.
+template <>
+struct key_normalizer<double, false>
+  : public key_normalizer_internal::float_normalizer<double, uint64_t>
+{
+};
+
+//! @brief Pairs, ordered lexicographically. The first element occupies the
+//! high bits.
+template <typename First, typename Second>
+struct key_normalizer<std::pair<First, Second>, false>
+{
+  typedef key_normalizer<First>  first_normalizer;
+  typedef key_normalizer<Second> second_normalizer;
+  static const int bits = first_normalizer::bits + second_normalizer::bits;
+  typedef typename key_normalizer_internal::unsigned_of<bits>::type
+                                                          normalized_type;
+  typedef char fits[(bits <= 64) ? 1 : -1];
+
+  static normalized_type encode (std::pair<First, Second> const & value)
+  {
+    return static_cast<normalized_type>((static_cast<normalized_type>(
+      first_normalizer::encode(value.first)) << second_normalizer::bits) |
+      static_cast<normalized_type>(second_normalizer::encode(value.second)));
+  }
+  static std::pair<First, Second> decode (normalized_type key)
+  {
+    typedef typename second_normalizer::normalized_type second_key;
+    return std::pair<First, Second>(
+      first_normalizer::decode(static_cast<typename
+        first_normalizer::normalized_type>(key >> second_normalizer::bits)),
+      second_normalizer::decode(static_cast<second_key>(key &
+        ((static_cast<normalized_type>(1) << second_normalizer::bits) - 1))));
+  }
+};
+
+/** @brief Encodes the first 8 bytes of a string as an unsigned integer.
+//  @param str,length String to encode. Need not be null-terminated.
+//  @return Big-endian integer of the first 8 bytes, padded with zeros.
+//  @details Preserves the lexicographic order of unsigned bytes (the order of
+//  std::string::compare and std::memcmp) non-strictly: if a < b, then
+//  normalize_prefix(a) <= normalize_prefix(b). Strings with equal prefixes
+//  must be compared in full.
+//  @par Complexity:
+//    O(1) - Reads at most 8 bytes.
+*/
+inline uint64_t normalize_prefix (const char * str, std::size_t length)
+{
+  uint64_t key = 0;
+  const std::size_t count = (length < 8) ? length : 8;
+  for (std::size_t i = 0; i < count; ++i)
+    key |= static_cast<uint64_t>(static_cast<unsigned char>(str[i])) <<
+           (56 - 8 * i);
+  return key;
+}
+
+//--------------------------Normalized Priority Deque--------------------------|
+/// \cond false
+namespace key_normalizer_internal {
+//! @brief Comparison of normalized keys equivalent to a standard comparison.
+//! Only std::less and std::greater are supported.
+template <typename Type, typename Compare, typename Key>
+struct normalized_compare;
+template <typename Type, typename Key>
+struct normalized_compare<Type, std::less<Type>, Key>
+{
+  typedef std::less<Key> type;
+};
+template <typename Type, typename Key>
+struct normalized_compare<Type, std::greater<Type>, Key>
+{
+  typedef std::greater<Key> type;
+};
+} //  Namespace key_normalizer_internal
+/// \endcond
+
+/*! @brief Double-ended priority queue that stores normalized keys.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque. Must have a
+ *  specialization of key_normalizer.
+ *  @param Compare Either std::less<Type> (the default) or std::greater<Type>.
+ *  @details Elements are encoded when added, and decoded when accessed. All
+ *  comparisons are between unsigned integers, so bulk operations use the
+ *  branch-free kernels of interval_heap.hpp.
+ *  @note Elements are decoded on access, so minimum and maximum return by
+ *  value rather than by reference, and no iterators are provided.
+ *  @see priority_deque, key_normalizer
+ */
+template <typename Type, typename Compare =::std::less<Type> >
+class normalized_priority_deque
+  : private priority_deque<typename key_normalizer<Type>::normalized_type,
+      std::vector<typename key_normalizer<Type>::normalized_type>,
+      typename key_normalizer_internal::normalized_compare<Type, Compare,
+                typename key_normalizer<Type>::normalized_type>::type>
+{
+  typedef key_normalizer<Type>                                normalizer;
+  typedef typename normalizer::normalized_type                key_type;
+  typedef priority_deque<key_type, std::vector<key_type>,
+    typename key_normalizer_internal::normalized_compare<Type, Compare,
+                                                  key_type>::type> base_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Type                                        value_type;
+  typedef Compare                                     value_compare;
+  typedef typename base_type::size_type               size_type;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty priority deque.
+  normalized_priority_deque           (void) {}
+/** @brief Constructs a new priority deque from a sequence of elements.
+//  @param first,last Range of elements.
+//  @post Deque contains all elements in [ @a first, @a last).
+//
+//  @par Complexity:
+//    O(n) - Linear on the number of elements.
+//  @par Exception safety:
+//    Strong.
+*/
+  template <typename InputIterator>
+  normalized_priority_deque           (InputIterator first, InputIterator last)
+  {
+    insert(first, last);
+  }
+//-----------------------------Restricted Access-------------------------------|
+//! @brief Encodes an element, and adds it to the priority deque.
+//! @see priority_deque::push
+  inline void             push        (value_type const & value)
+  {
+    base_type::push(normalizer::encode(value));
+  }
+//! @brief Decodes a maximal element.
+//! @pre  Priority deque contains one or more elements.
+  inline value_type       maximum     (void) const
+  {
+    return normalizer::decode(base_type::maximum());
+  }
+//! @brief Decodes a minimal element.
+//! @pre  Priority deque contains one or more elements.
+  inline value_type       minimum     (void) const
+  {
+    return normalizer::decode(base_type::minimum());
+  }
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline value_type       top         (void) const  { return maximum(); }
+
+  using base_type::pop_maximum;
+  using base_type::pop_minimum;
+  using base_type::pop;
+  using base_type::empty;
+  using base_type::size;
+  using base_type::max_size;
+  using base_type::clear;
+//! @brief Exchanges the elements of two normalized priority deques.
+  inline void             swap        (normalized_priority_deque & other)
+  {
+    base_type::swap(other);
+  }
+/** @brief Merges a sequence of elements into the priority deque.
+//  @param first,last Input iterators bounding the range [ @a first, @a last)
+//  @see priority_deque::insert
+*/
+  template <typename InputIterator>
+  void                    insert      (InputIterator first, InputIterator last);
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = true;
+  static const bool is_stable             = false;
+  static const bool has_reserve           = false;
+};
+
+template <typename T, typename C>
+template <typename InputIterator>
+void normalized_priority_deque<T, C>::insert (InputIterator first,
+                                              InputIterator last)
+{
+  std::vector<key_type> keys;
+  for (; first != last; ++first)
+    keys.push_back(normalizer::encode(*first));
+  base_type::insert(keys.begin(), keys.end());
+}
+
+/** @brief Swaps the elements of two normalized priority deques.
+// @relates normalized_priority_deque
+*/
+template <typename T, typename C>
+inline void swap (normalized_priority_deque<T, C> & deque1,
+                  normalized_priority_deque<T, C> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -43,6 +43,11 @@
 //  Manage Internal heap structure.
 #include "interval_heap.hpp"
 
+#if (BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD == true)
+//  Grab std::exception_ptr, to report failures in worker threads.
+#include <exception>
+#endif
+
 //  Choose the best available version of the assert macro.
 #ifdef BOOST_ASSERT_MSG
 #define BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(x,m) BOOST_ASSERT_MSG(x,m)
@@ -59,6 +64,15 @@ template <typename Type, typename Sequence =std::vector<Type>,
           typename Compare =::std::less<typename Sequence::value_type> >
 class priority_deque;
 
+//! @brief Tag type indicating that constructor input is already sorted.
+struct sorted_range_t {};
+//! @brief Tag indicating that constructor input is already sorted.
+static const sorted_range_t sorted_range = sorted_range_t();
+//! @brief Tag type selecting construction in the reverse of another's order.
+struct reverse_order_t {};
+//! @brief Tag selecting the constructor that reverses another deque's order.
+static const reverse_order_t reverse_order = reverse_order_t();
+
 /** @brief Swaps the elements of two priority deques.
 // @relates priority_deque
 //  @param deque1,deque2 Priority deques.
@@ -85,7 +99,10 @@ void swap (priority_deque<Type, Sequence, Compare>& deque1,
  *  Defaults to std::vector<Type>.
  *  @param Compare Comparison class. %Compare(A, B) should return true if %A
  *  should be placed earlier than %B in a strict weak ordering.
- *  Defaults to std::less<Type>, which encapsulates operator<.
+ *  Defaults to std::less<Type>, which encapsulates operator<. A three-way
+ *  comparison (such as std::compare_three_way, or any comparison for which
+ *  boost::heap::is_three_way_compare holds) may be used instead; it lets
+ *  elements stop moving as soon as they tie with their neighbors.
  *  @details Priority deques are adaptors, designed to provide efficient
  *  insertion and access to both ends of a weakly-ordered list of elements.
  *  As a container adaptor, priority_deque is implemented on top of another
@@ -182,6 +199,69 @@ class priority_deque {
                                        Compare const & =Compare(),
                                        Sequence const & =Sequence());
 #endif
+/** @brief Constructs a new priority deque from a sorted sequence of elements.
+//  @param first,last Range of elements.
+//  @param comp Instance of comparison class.
+//  @param seq Instance of container class.
+//  @pre The elements of @a seq, followed by those in [ @a first, @a last), are
+//  sorted in ascending order with respect to @a comp.
+//  @post Deque contains copies of all elements in @a sequence (if specified)
+//  and in the range [ @a first, @a last).
+//
+//  @par  Complexity:
+//    O(n) - Linear on the size of the deque. No comparisons are performed.
+//  @par  Exception safety:
+//    None.
+*/
+#if (__cplusplus >= 201103L)
+  template <typename InputIterator>
+  priority_deque                      (sorted_range_t,
+                                       InputIterator first, InputIterator last,
+                                       Compare const & =Compare(),
+                                       Sequence && =Sequence());
+//! @overload
+  template <typename InputIterator>
+  priority_deque                      (sorted_range_t,
+                                       InputIterator first, InputIterator last,
+                                       Compare const &,
+                                       Sequence const &);
+#else
+  template <typename InputIterator>
+  priority_deque                      (sorted_range_t,
+                                       InputIterator first, InputIterator last,
+                                       Compare const & =Compare(),
+                                       Sequence const & =Sequence());
+#endif
+/** @brief Constructs a new priority deque from the elements of another, which
+//  has the reverse order.
+//  @param other Priority deque whose elements are taken.
+//  @param comp Instance of comparison class.
+//  @param threads Maximum number of threads to use. Ignored unless
+//  BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD is true.
+//  @pre @a comp orders elements in the reverse of the order of @a other (for
+//  example, std::greater if @a other uses std::less).
+//  @post Deque contains the elements previously in @a other, which is empty.
+//
+//  @par  Complexity:
+//    O(n) - Linear on the size of the deque. No comparisons are performed.
+//  @par  Exception safety:
+//    Basic.
+*/
+#if (__cplusplus >= 201103L)
+  template <typename OtherCompare>
+  priority_deque                      (reverse_order_t,
+                                       priority_deque<Type, Sequence,
+                                                      OtherCompare> && other,
+                                       Compare const & =Compare(),
+                                       unsigned int threads = 1);
+#else
+  template <typename OtherCompare>
+  priority_deque                      (reverse_order_t,
+                                       priority_deque<Type, Sequence,
+                                                      OtherCompare> & other,
+                                       Compare const & =Compare(),
+                                       unsigned int threads = 1);
+#endif
 //-----------------------------Restricted Access-------------------------------|
 /** @brief Copies an element into the priority deque.
 //  @param value Element to insert into the priority deque.
@@ -272,6 +352,84 @@ class priority_deque {
   void                    pop_minimum (void);
 //! @details Identical to std::priority_queue pop(). @see @a pop_maximum
   inline void             pop         (void)        { pop_maximum(); }
+
+/** @brief Removes minimal elements for as long as they satisfy a predicate.
+//  @param pred Unary predicate. If pred(b) holds, pred(a) must hold for every
+//  @a a not ordered after @a b; for example, "is older than a cutoff".
+//  @param out Output iterator, to which removed elements are moved.
+//  @return @a out, advanced past the removed elements.
+//  @post No element of the deque satisfies @a pred.
+//  @post All iterators and references are invalidated.
+//  @details Elements are popped one at a time, and written in order, until
+//  about n / log n have been removed. If more remain, the rest are removed in
+//  a single partitioning pass and the heap is rebuilt; those are written in
+//  no particular order.
+//  @see pop_maximum_while, pop_minimum_until
+//
+//  @par  Complexity:
+//    O(min(k log n, n)) for k removed elements.
+//  @par  Exception safety:
+//    Basic; the heap property is restored, or, if restoring it throws, the
+//  deque is cleared. If writing to @a out throws, the elements already
+//  written are no longer in the deque, and the element being written may be
+//  lost.
+*/
+  template <typename Predicate, typename OutputIterator>
+  OutputIterator          pop_minimum_while (Predicate pred,
+                                             OutputIterator out)
+  {
+    return pop_while(pred, out, false);
+  }
+/** @brief Removes maximal elements for as long as they satisfy a predicate.
+//  @param pred Unary predicate. If pred(a) holds, pred(b) must hold for every
+//  @a b not ordered before @a a.
+//  @see pop_minimum_while
+*/
+  template <typename Predicate, typename OutputIterator>
+  OutputIterator          pop_maximum_while (Predicate pred,
+                                             OutputIterator out)
+  {
+    return pop_while(pred, out, true);
+  }
+/** @brief Removes every element ordered before @a bound.
+//  @param bound Elements ordered before it are removed. Need not be in the
+//  deque.
+//  @param out Output iterator, to which removed elements are moved.
+//  @return @a out, advanced past the removed elements.
+//  @details Suited to sweeping out expired entries, whose bound is the current
+//  time. @see pop_minimum_while
+*/
+  template <typename OutputIterator>
+  OutputIterator          pop_minimum_until (value_type const & bound,
+                                             OutputIterator out);
+/** @brief Removes the @a n minimal elements, or all if there are fewer.
+//  @param out Output iterator, to which removed elements are moved.
+//  @return @a out, advanced past the removed elements.
+//  @post All iterators and references are invalidated.
+//  @details Up to about n / log n elements are popped one at a time, and
+//  written in order. More are chosen in a single selection pass (as by
+//  std::nth_element), and written in no particular order.
+//  @see pop_maximum_n
+//
+//  @par  Complexity:
+//    O(min(k log n, n)) for k removed elements.
+//  @par  Exception safety:
+//    Basic; the heap property is restored, or, if restoring it throws, the
+//  deque is cleared. If writing to @a out throws, the elements already
+//  written are no longer in the deque, and the element being written may be
+//  lost.
+*/
+  template <typename OutputIterator>
+  OutputIterator          pop_minimum_n (size_type n, OutputIterator out)
+  {
+    return pop_n(n, out, false);
+  }
+//! @brief Removes the @a n maximal elements. @see pop_minimum_n
+  template <typename OutputIterator>
+  OutputIterator          pop_maximum_n (size_type n, OutputIterator out)
+  {
+    return pop_n(n, out, true);
+  }
 //! @}
 
 //--------------------------------Deque Size-----------------------------------|
@@ -296,6 +454,19 @@ class priority_deque {
   inline size_type        max_size    (void) const  {
     return sequence_.max_size();
   }
+/** @brief Returns the number of pushes that took the monotone fast path.
+//    A pushed element that is beyond either end of the deque (a new maximum or
+//  minimum, as with increasing timestamps) is moved to the root with only a few
+//  comparisons. This counts such pushes since the deque was constructed, so
+//  that a workload can be checked for the pattern.
+//  @par  Complexity:
+//    O(1) - Does not on the size of the deque.
+//  @par  Exception safety:
+//    No-throw.
+*/
+  inline size_type        monotone_pushes (void) const {
+    return monotone_pushes_;
+  }
 //! @}
 
 //--------------------------Whole-Deque Operations-----------------------------|
@@ -315,6 +486,19 @@ class priority_deque {
 */
   void                    swap        (priority_deque<Type, Sequence,Compare>&);
 
+/** @brief Returns a copy of the deque, for reading while this one changes.
+//  @details With a copy-on-write Sequence, such as cow_vector, the copy shares
+//  storage with this deque; each chunk is copied only if one of the two deques
+//  modifies it while the other is alive. A snapshot may then be iterated in
+//  another thread while this deque is modified.
+//  @par  Complexity:
+//    O(1) with a copy-on-write Sequence. Otherwise, linear on the size of the
+//  deque.
+//  @par  Exception safety:
+//    Strong.
+*/
+  priority_deque          snapshot    (void) const  { return *this; }
+
 //!@{
 /** @brief Merges a sequence of elements into the priority deque.
 //  @param first,last Input iterators bounding the range [ @a first, @a last)
@@ -344,8 +528,64 @@ class priority_deque {
   {
     insert(source.begin(), source.end());
   }
+#if (__cplusplus >= 201103L)
+/** @brief Moves the elements of another priority deque into this one.
+//  @param other Deque with the same ordering. It is left empty.
+//  @details Both deques are already heaps, so the smaller is pushed into the
+//  larger, element by element, when that costs less than rearranging both;
+//  otherwise, as for insert.
+//
+//  @par Complexity:
+//    O(min(m log n, n)), for m elements in the smaller deque.
+//  @par Exception safety:
+//    Basic; invariants are maintained. Note that elements may be lost during
+//    exception handling.
+*/
+  void                    merge       (priority_deque && other);
+#endif
 //!@}
 
+/** @brief Applies an order-preserving function to every element.
+//  @param f Unary function. For all elements a and b, if b is not ordered
+//  before a, f(b) must not be ordered before f(a); for example, adding a
+//  constant, or multiplying by a positive constant.
+//  @param threads Maximum number of threads to use. Ignored unless
+//  BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD is true. Each thread uses its own
+//  copy of @a f.
+//  @post Each element @a x is replaced by f(x).
+//  @post All iterators and references are invalidated.
+//  @details Because @a f preserves the order of elements, the interval heap
+//  property is preserved, and no comparisons are made.
+//
+//  @par Complexity:
+//    O(n) - Linear on the size of the deque.
+//  @par Exception safety:
+//    Basic; if @a f throws, some elements may have been transformed and others
+//  not, and the heap property is restored. If restoring it throws, the deque
+//  is cleared, so elements may be lost.
+*/
+  template <typename UnaryFunction>
+  void                    transform_monotone (UnaryFunction f,
+                                              unsigned int threads = 1);
+
+/** @brief Reverses the order of the deque, adopting a new comparison.
+//  @param comp Comparison object to adopt.
+//  @param threads Maximum number of threads to use. Ignored unless
+//  BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD is true.
+//  @pre @a comp orders elements in the reverse of the current order. For
+//  example, a comparison with a run-time direction flag, set to the opposite
+//  direction.
+//  @post Minimal elements are now maximal, and vice-versa.
+//  @post All iterators and references are invalidated.
+//
+//  @par Complexity:
+//    O(n) - Linear on the size of the deque. No comparisons are performed.
+//  @par Exception safety:
+//    Basic.
+*/
+  void                    reverse     (value_compare const & comp,
+                                       unsigned int threads = 1);
+
 //-------------------------------Random Access---------------------------------|
 //!@{
 //! @brief Returns a const iterator at the beginning of the sequence.
@@ -416,37 +656,49 @@ class priority_deque {
   inline const  value_compare&  compare   (void) const  { return compare_; }
 //---------------------------------Private-------------------------------------|
  private:
+//  Permits the sequence of a deque to be taken by a deque of the reverse order.
+  template <typename, typename, typename> friend class priority_deque;
   void pop_back_or_rollback (void);
+  size_type pop_budget (void) const;
+  template <typename OutputIterator>
+  OutputIterator pop_to (OutputIterator, bool maximal);
+  template <typename Arrange, typename OutputIterator>
+  OutputIterator remove_back (Arrange, OutputIterator);
+  template <typename Predicate, typename OutputIterator>
+  OutputIterator pop_while (Predicate &, OutputIterator, bool maximal);
+  template <typename OutputIterator>
+  OutputIterator pop_n (size_type, OutputIterator, bool maximal);
   Sequence sequence_;
   Compare compare_;
+  size_type monotone_pushes_;
 };
 
 //-------------------------------Constructors----------------------------------|
 //----------------------------Default Constructor------------------------------|
 template <typename T, typename S, typename C>
 priority_deque<T, S, C>::priority_deque (void)
-  : sequence_(), compare_()
+  : sequence_(), compare_(), monotone_pushes_(0)
 {
 //  Note: A "Container" is required to be empty when constructed.
 }
 
 template <typename T, typename S, typename C>
 priority_deque<T, S, C>::priority_deque (C const & comp)
-  : sequence_(), compare_(comp)
+  : sequence_(), compare_(comp), monotone_pushes_(0)
 {
 //  Note: A "Container" is required to be empty when constructed.
 }
 
 template <typename T, typename S, typename C>
 priority_deque<T, S, C>::priority_deque (C const & comp, S const & seq)
-  : sequence_(seq), compare_(comp)
+  : sequence_(seq), compare_(comp), monotone_pushes_(0)
 {
   heap::make_interval_heap(sequence_.begin(), sequence_.end(), compare_);
 }
 #if (__cplusplus >= 201103L)
 template <typename T, typename S, typename C>
 priority_deque<T, S, C>::priority_deque (const C& comp, S&& seq)
-  : sequence_(std::move(seq)), compare_(comp)
+  : sequence_(std::move(seq)), compare_(comp), monotone_pushes_(0)
 {
   heap::make_interval_heap(sequence_.begin(), sequence_.end(), compare_);
 }
@@ -457,7 +709,7 @@ template <typename T, typename S, typename C>
 template <typename InputIterator>
 priority_deque<T, S, C>::priority_deque (InputIterator first,InputIterator last,
                                          C const & comp, S const & seq)
-: sequence_(seq), compare_(comp)
+: sequence_(seq), compare_(comp), monotone_pushes_(0)
 {
   sequence_.insert(sequence_.end(), first, last);
   heap::make_interval_heap(sequence_.begin(), sequence_.end(), compare_);
@@ -467,13 +719,43 @@ template <typename T, typename S, typename C>
 template <typename InputIterator>
 priority_deque<T, S, C>::priority_deque (InputIterator first,InputIterator last,
                                          const C& comp, S&& seq)
-: sequence_(std::move(seq)), compare_(comp)
+: sequence_(std::move(seq)), compare_(comp), monotone_pushes_(0)
 {
   sequence_.insert(sequence_.end(), first, last);
   heap::make_interval_heap(sequence_.begin(), sequence_.end(), compare_);
 }
 #endif
 
+//------------------------Create from Sorted Iterators-------------------------|
+template <typename T, typename S, typename C>
+template <typename InputIterator>
+priority_deque<T, S, C>::priority_deque (sorted_range_t,
+                                         InputIterator first,InputIterator last,
+                                         C const & comp, S const & seq)
+: sequence_(seq), compare_(comp), monotone_pushes_(0)
+{
+  sequence_.insert(sequence_.end(), first, last);
+  heap::make_interval_heap_from_sorted(sequence_.begin(), sequence_.end());
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(heap::is_interval_heap(
+    sequence_.begin(), sequence_.end(), compare_),
+    "Input to sorted-range constructor was not sorted.");
+}
+#if (__cplusplus >= 201103L)
+template <typename T, typename S, typename C>
+template <typename InputIterator>
+priority_deque<T, S, C>::priority_deque (sorted_range_t,
+                                         InputIterator first,InputIterator last,
+                                         const C& comp, S&& seq)
+: sequence_(std::move(seq)), compare_(comp), monotone_pushes_(0)
+{
+  sequence_.insert(sequence_.end(), first, last);
+  heap::make_interval_heap_from_sorted(sequence_.begin(), sequence_.end());
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(heap::is_interval_heap(
+    sequence_.begin(), sequence_.end(), compare_),
+    "Input to sorted-range constructor was not sorted.");
+}
+#endif
+
 //-----------------------------Restricted Access-------------------------------|
 //------------------------------Insert / Emplace-------------------------------|
 template <typename T, typename Sequence, typename Compare>
@@ -494,7 +776,8 @@ void priority_deque<T, Sequence, Compare>::push (value_type const & value) {
 #else
   guard.ptr = &sequence_;
 #endif
-  heap::push_interval_heap(sequence_.begin(), sequence_.end(), compare_);
+  if (heap::push_interval_heap(sequence_.begin(), sequence_.end(), compare_))
+    ++monotone_pushes_;
 #if (__cplusplus >= 201103L)
   guard.ptr = nullptr;
 #else
@@ -515,7 +798,8 @@ void priority_deque<T, Sequence, Compare>::push (value_type&& value) {
     }
   } guard;
   guard.ptr = std::addressof(sequence_);
-  heap::push_interval_heap(sequence_.begin(), sequence_.end(), compare_);
+  if (heap::push_interval_heap(sequence_.begin(), sequence_.end(), compare_))
+    ++monotone_pushes_;
   guard.ptr = nullptr;
 }
 
@@ -533,7 +817,8 @@ void priority_deque<T, Sequence, Compare>::emplace (Args&&... args) {
     }
   } guard;
   guard.ptr = std::addressof(sequence_);
-  heap::push_interval_heap(sequence_.begin(), sequence_.end(), compare_);
+  if (heap::push_interval_heap(sequence_.begin(), sequence_.end(), compare_))
+    ++monotone_pushes_;
   guard.ptr = nullptr;
 }
 #endif
@@ -611,6 +896,28 @@ void priority_deque<T, S, C>::insert (InputIterator first, InputIterator last) {
 #endif
 }
 
+#if (__cplusplus >= 201103L)
+template <typename T, typename S, typename C>
+void priority_deque<T, S, C>::merge (priority_deque<T, S, C> && other) {
+  if (this == &other)
+    return;
+  if (other.sequence_.size() > sequence_.size())
+    sequence_.swap(other.sequence_);
+  const size_type total = sequence_.size() + other.sequence_.size();
+  size_type log_total = 0;
+  for (size_type n = total; n > 1; n >>= 1)
+    ++log_total;
+  if (other.sequence_.size() * log_total > total)
+    insert(std::make_move_iterator(other.sequence_.begin()),
+           std::make_move_iterator(other.sequence_.end()));
+  else
+    for (typename S::iterator it = other.sequence_.begin();
+         it != other.sequence_.end(); ++it)
+      push(std::move(*it));
+  other.sequence_.clear();
+}
+#endif
+
 //----------------------------Swap Specialization------------------------------|
 template <typename T, typename S, typename C>
 inline void priority_deque<T, S, C>::swap (priority_deque<T, S, C>& other) {
@@ -619,6 +926,7 @@ inline void priority_deque<T, S, C>::swap (priority_deque<T, S, C>& other) {
   if (this != &other) {
     swap(compare_, other.compare_);
     sequence_.swap(other.sequence_);
+    swap(monotone_pushes_, other.monotone_pushes_);
   }
 }
 
@@ -629,6 +937,391 @@ inline void swap (priority_deque<T, S, C>& deque1,
   deque1.swap(deque2);
 }
 
+//-------------------------------Chunked Passes--------------------------------|
+/// \cond false
+namespace priority_deque_internal {
+//! @brief Replaces each element of a range with its image under a function.
+template <typename UnaryFunction>
+struct transformer
+{
+  UnaryFunction f;
+  explicit transformer (UnaryFunction const & function) : f(function) {}
+  template <typename Iterator>
+  void operator() (Iterator first, Iterator last)
+  {
+    for (; first != last; ++first)
+      *first = f(*first);
+  }
+};
+//! @brief Exchanges the bounds of each interval of a range.
+struct reverser
+{
+  template <typename Iterator>
+  void operator() (Iterator first, Iterator last) const
+  {
+    heap::reverse_interval_heap(first, last);
+  }
+};
+#if (BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD == true)
+//  Runs in a worker thread. Exceptions are carried back to the calling thread.
+template <typename Iterator, typename Task>
+void run_caught (Iterator first, Iterator last, Task task,
+                 std::exception_ptr * error)
+{
+  try {
+    task(first, last);
+  } catch (...) {
+    *error = std::current_exception();
+  }
+}
+#endif
+/** @brief Applies a task to contiguous chunks of a range.
+//  @details Every chunk begins at an even offset, so that no interval is
+//  split between chunks. If threads are enabled, up to @a threads chunks are
+//  processed at once, each with its own copy of @a task.
+*/
+template <typename Iterator, typename Task>
+void for_each_chunk (Iterator first, Iterator last, Task task,
+                     unsigned int threads)
+{
+#if (BOOST_HEAP_INTERVAL_HEAP_USE_STD_THREAD == true)
+  typedef typename std::iterator_traits<Iterator>::difference_type Offset;
+  using heap::interval_heap_internal::kThreadMin;
+  const Offset size = last - first;
+  if ((threads > 1) && (size > kThreadMin)) {
+    if (static_cast<Offset>(threads) > size / kThreadMin)
+      threads = static_cast<unsigned int>(size / kThreadMin);
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors (threads);
+    workers.reserve(threads - 1);
+//  If a thread cannot be started, those already running must finish first.
+    struct RAIIJoiner
+    {
+      std::vector<std::thread> & workers_;
+      ~RAIIJoiner (void)
+      {
+        for (std::size_t i = 0; i < workers_.size(); ++i)
+          if (workers_[i].joinable())
+            workers_[i].join();
+      }
+    } joiner = { workers };
+    Iterator chunk_begin = first;
+    for (unsigned int i = 1; i < threads; ++i) {
+      const Iterator chunk_end = first + ((size * i / threads) & ~Offset(1));
+      workers.push_back(std::thread(&run_caught<Iterator, Task>, chunk_begin,
+                                    chunk_end, task, &errors[i]));
+      chunk_begin = chunk_end;
+    }
+    run_caught<Iterator, Task>(chunk_begin, last, task, &errors[0]);
+    for (std::size_t i = 0; i < workers.size(); ++i)
+      workers[i].join();
+    for (std::size_t i = 0; i < errors.size(); ++i)
+      if (errors[i])
+        std::rethrow_exception(errors[i]);
+    return;
+  }
+#else
+  (void)threads;
+#endif
+  task(first, last);
+}
+} //  Namespace priority_deque_internal
+/// \endcond
+
+//------------------------------Monotone Transform-----------------------------|
+template <typename T, typename S, typename C>
+template <typename UnaryFunction>
+void priority_deque<T, S, C>::transform_monotone (UnaryFunction f,
+                                                  unsigned int threads)
+{
+  struct RAIIGuard
+  {
+    container_type * seq_;
+    value_compare & comp_;
+    RAIIGuard (container_type & seq, value_compare & comp)
+#if (__cplusplus >= 201103L)
+      noexcept : seq_(std::addressof(seq)), comp_(comp)
+#else
+      : seq_(&seq), comp_(comp)
+#endif
+    {
+    }
+    RAIIGuard (RAIIGuard const &);
+    RAIIGuard & operator= (RAIIGuard const &);
+    ~RAIIGuard (void)
+    {
+//  Some elements were transformed and others were not, which may break the
+//  heap property. Restore it; if even that fails, clear the sequence, as
+//  insert does, rather than throw from a destructor.
+      if (seq_) {
+        try {
+          heap::make_interval_heap(seq_->begin(), seq_->end(), comp_);
+        } catch (...) {
+          seq_->clear();
+        }
+      }
+    }
+  } guard (sequence_, compare_);
+  priority_deque_internal::for_each_chunk(sequence_.begin(), sequence_.end(),
+    priority_deque_internal::transformer<UnaryFunction>(f), threads);
+#if (__cplusplus >= 201103L)
+  guard.seq_ = nullptr;
+#else
+  guard.seq_ = NULL;
+#endif
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(heap::is_interval_heap(
+    sequence_.begin(), sequence_.end(), compare_),
+    "Function passed to transform_monotone does not preserve order.");
+}
+
+//---------------------------------Reversal------------------------------------|
+template <typename T, typename S, typename C>
+void priority_deque<T, S, C>::reverse (value_compare const & comp,
+                                       unsigned int threads)
+{
+  priority_deque_internal::for_each_chunk(sequence_.begin(), sequence_.end(),
+                                    priority_deque_internal::reverser(), threads);
+  compare_ = comp;
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(heap::is_interval_heap(
+    sequence_.begin(), sequence_.end(), compare_),
+    "Comparison passed to reverse is not the reverse of the deque's order.");
+}
+
+#if (__cplusplus >= 201103L)
+template <typename T, typename S, typename C>
+template <typename OtherCompare>
+priority_deque<T, S, C>::priority_deque (reverse_order_t,
+                                priority_deque<T, S, OtherCompare> && other,
+                                C const & comp, unsigned int threads)
+: sequence_(std::move(other.sequence_)), compare_(comp), monotone_pushes_(0)
+{
+  other.sequence_.clear();
+  priority_deque_internal::for_each_chunk(sequence_.begin(), sequence_.end(),
+                                    priority_deque_internal::reverser(), threads);
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(heap::is_interval_heap(
+    sequence_.begin(), sequence_.end(), compare_),
+    "Comparison is not the reverse of the source deque's order.");
+}
+#else
+template <typename T, typename S, typename C>
+template <typename OtherCompare>
+priority_deque<T, S, C>::priority_deque (reverse_order_t,
+                                priority_deque<T, S, OtherCompare> & other,
+                                C const & comp, unsigned int threads)
+: sequence_(), compare_(comp), monotone_pushes_(0)
+{
+  sequence_.swap(other.sequence_);
+  priority_deque_internal::for_each_chunk(sequence_.begin(), sequence_.end(),
+                                    priority_deque_internal::reverser(), threads);
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(heap::is_interval_heap(
+    sequence_.begin(), sequence_.end(), compare_),
+    "Comparison is not the reverse of the source deque's order.");
+}
+#endif
+
+//-------------------------------Batch Removal---------------------------------|
+/// \cond false
+namespace priority_deque_internal {
+//! @brief True for elements that do not satisfy a predicate.
+template <typename Predicate>
+struct negation
+{
+  Predicate & pred;
+  explicit negation (Predicate & p) : pred(p) {}
+  template <typename Value>
+  bool operator() (Value const & x) const { return !pred(x); }
+};
+//! @brief True for elements ordered before a bound.
+template <typename Less, typename Value>
+struct ordered_before
+{
+  Less less_than;
+  Value bound;
+  ordered_before (Less const & less, Value const & value)
+    : less_than(less), bound(value) {}
+  bool operator() (Value const & x) const { return less_than(x, bound); }
+};
+//! @brief Moves the elements that satisfy a predicate to the back of a range.
+template <typename Predicate>
+struct partitioner
+{
+  Predicate & pred;
+  explicit partitioner (Predicate & p) : pred(p) {}
+  template <typename Iterator>
+  Iterator operator() (Iterator first, Iterator last) const
+  {
+    return std::partition(first, last, negation<Predicate>(pred));
+  }
+};
+//! @brief Orders elements ascending or, to put the least last, descending.
+template <typename Less>
+struct ordering
+{
+  Less less_than;
+  bool ascending;
+  ordering (Less const & less, bool up) : less_than(less), ascending(up) {}
+  template <typename Value>
+  bool operator() (Value const & lhs, Value const & rhs) const
+  {
+    return ascending ? less_than(lhs, rhs) : less_than(rhs, lhs);
+  }
+};
+//! @brief Moves the @a count least (or greatest) elements to the back.
+template <typename Less>
+struct selector
+{
+  ordering<Less> order;
+  std::size_t count;
+  selector (Less const & less, std::size_t n, bool greatest)
+    : order(less, greatest), count(n) {}
+  template <typename Iterator>
+  Iterator operator() (Iterator first, Iterator last) const
+  {
+    const Iterator middle = last - count;
+    std::nth_element(first, middle, last, order);
+    return middle;
+  }
+};
+} //  Namespace priority_deque_internal
+/// \endcond
+
+template <typename T, typename S, typename C>
+template <typename OutputIterator>
+OutputIterator priority_deque<T, S, C>::pop_minimum_until (
+  value_type const & bound, OutputIterator out)
+{
+  typedef heap::interval_heap_internal::heap_compare<C, T> adapted;
+  priority_deque_internal::ordered_before<typename adapted::type, T>
+    pred (adapted::adapt(compare_), bound);
+  return pop_while(pred, out, false);
+}
+
+//    Popping k elements costs about k log n; selecting them and rebuilding the
+//  heap costs about n. Pop while the first is cheaper.
+template <typename T, typename S, typename C>
+typename priority_deque<T, S, C>::size_type
+  priority_deque<T, S, C>::pop_budget (void) const
+{
+  size_type log_n = 1;
+  for (size_type n = sequence_.size() >> 1; n > 1; n >>= 1)
+    ++log_n;
+  return sequence_.size() / log_n;
+}
+
+template <typename T, typename S, typename C>
+template <typename OutputIterator>
+OutputIterator priority_deque<T, S, C>::pop_to (OutputIterator out,
+                                                bool maximal)
+{
+  if (maximal)
+    heap::pop_interval_heap_max(sequence_.begin(), sequence_.end(), compare_);
+  else
+    heap::pop_interval_heap_min(sequence_.begin(), sequence_.end(), compare_);
+#if (__cplusplus >= 201103L)
+  value_type removed (std::move(sequence_.back()));
+  pop_back_or_rollback();
+  *out = std::move(removed);
+#else
+  value_type removed (sequence_.back());
+  pop_back_or_rollback();
+  *out = removed;
+#endif
+  return ++out;
+}
+
+template <typename T, typename S, typename C>
+template <typename Arrange, typename OutputIterator>
+OutputIterator priority_deque<T, S, C>::remove_back (Arrange arrange,
+                                                     OutputIterator out)
+{
+  struct RAIIGuard
+  {
+    container_type * seq_;
+    value_compare & comp_;
+    RAIIGuard (container_type & seq, value_compare & comp)
+#if (__cplusplus >= 201103L)
+      noexcept : seq_(std::addressof(seq)), comp_(comp)
+#else
+      : seq_(&seq), comp_(comp)
+#endif
+    {
+    }
+    RAIIGuard (RAIIGuard const &);
+    RAIIGuard & operator= (RAIIGuard const &);
+    ~RAIIGuard (void)
+    {
+//  The elements have been permuted, so the heap property must be restored.
+//  The comparison may be what threw; if it throws again, clear the sequence,
+//  as insert does, rather than throw from a destructor.
+      if (seq_) {
+        try {
+          heap::make_interval_heap(seq_->begin(), seq_->end(), comp_);
+        } catch (...) {
+          seq_->clear();
+        }
+      }
+    }
+  } guard (sequence_, compare_);
+  typename container_type::iterator middle = arrange(sequence_.begin(),
+                                                     sequence_.end());
+  typename container_type::iterator cursor = middle;
+  try {
+    for (; cursor != sequence_.end(); ++cursor, ++out)
+#if (__cplusplus >= 201103L)
+      *out = std::move(*cursor);
+#else
+      *out = *cursor;
+#endif
+  } catch (...) {
+//  Elements already written must not stay behind (as moved-from shells).
+    sequence_.erase(middle, cursor + 1);
+    throw;
+  }
+  sequence_.erase(middle, sequence_.end());
+  heap::make_interval_heap(sequence_.begin(), sequence_.end(), compare_);
+#if (__cplusplus >= 201103L)
+  guard.seq_ = nullptr;
+#else
+  guard.seq_ = NULL;
+#endif
+  return out;
+}
+
+template <typename T, typename S, typename C>
+template <typename Predicate, typename OutputIterator>
+OutputIterator priority_deque<T, S, C>::pop_while (Predicate & pred,
+                                                   OutputIterator out,
+                                                   bool maximal)
+{
+  for (size_type budget = pop_budget(); ; --budget) {
+    if (empty() || !pred(maximal ? maximum() : minimum()))
+      return out;
+    if (budget == 0)
+      break;
+    out = pop_to(out, maximal);
+  }
+  return remove_back(priority_deque_internal::partitioner<Predicate>(pred),
+                     out);
+}
+
+template <typename T, typename S, typename C>
+template <typename OutputIterator>
+OutputIterator priority_deque<T, S, C>::pop_n (size_type count,
+                                               OutputIterator out,
+                                               bool maximal)
+{
+  if (count > size())
+    count = size();
+  if (count <= pop_budget()) {
+    for (; count; --count)
+      out = pop_to(out, maximal);
+    return out;
+  }
+  typedef heap::interval_heap_internal::heap_compare<C, T> adapted;
+  return remove_back(priority_deque_internal::selector<typename adapted::type>(
+                       adapted::adapt(compare_), count, maximal), out);
+}
+
 //---------------------------Random-Access Mutators----------------------------|
 template <typename T, typename S, typename C>
 void priority_deque<T, S, C>::update (const_iterator random_it,
@@ -0,0 +1,459 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file projected_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    projected_priority_deque.hpp provides the class projected_priority_deque,
+//  a priority deque ordered by a key extracted from each element.
+//    Optionally, the key is computed once, when the element is added, and
+//  stored beside it (the "decorate-sort-undecorate" idiom). Comparisons then
+//  touch only the stored keys, which is much faster when the key is reached
+//  through one or more indirections.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for priority_deque. The projection may throw; if it does, the deque is
+//  left unchanged.
+*/
+
+#ifndef BOOST_CONTAINER_PROJECTED_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_PROJECTED_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error projected_priority_deque.hpp requires a C++ compiler.
+#endif
+
+//  Grab std::decay and std::declval, to deduce the key type.
+#if (__cplusplus >= 201103L)
+#include <type_traits>
+#include <utility>
+#endif
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+/// \cond false
+namespace projected_priority_deque_internal {
+//! @brief Type of key extracted by a projection.
+//! @details In C++03, Projection must define result_type.
+template <typename Type, typename Projection>
+struct key_of
+{
+#if (__cplusplus >= 201103L)
+  typedef typename std::decay<decltype(std::declval<Projection const &>()(
+                                       std::declval<Type const &>()))>::type
+    type;
+#else
+  typedef typename Projection::result_type type;
+#endif
+};
+
+//! @brief Elements with their keys cached beside them.
+template <typename Type, typename Key, typename Projection, typename KeyCompare,
+          bool cached>
+struct entry_traits
+{
+  struct element_type
+  {
+    Key key;
+    Type value;
+  };
+  struct element_compare
+  {
+    element_compare (Projection const &, KeyCompare const & comp)
+      : compare(comp) {}
+    bool operator() (element_type const & lhs, element_type const & rhs) const
+    {
+      return compare(lhs.key, rhs.key);
+    }
+    KeyCompare compare;
+  };
+  static element_type make (Type const & value, Projection const & projection)
+  {
+    element_type result = { projection(value), value };
+    return result;
+  }
+#if (__cplusplus >= 201103L)
+//  Braced initializers are evaluated in order, so the key is projected before
+//  the value is moved.
+  static element_type make (Type && value, Projection const & projection)
+  {
+    element_type result = { projection(value), std::move(value) };
+    return result;
+  }
+#endif
+  static Type const & value (element_type const & element)
+  {
+    return element.value;
+  }
+  static void refresh (element_type & element, Projection const & projection)
+  {
+    element.key = projection(element.value);
+  }
+};
+
+//! @brief Elements alone; keys are projected on every comparison.
+template <typename Type, typename Key, typename Projection, typename KeyCompare>
+struct entry_traits<Type, Key, Projection, KeyCompare, false>
+{
+  typedef Type element_type;
+  struct element_compare
+  {
+    element_compare (Projection const & proj, KeyCompare const & comp)
+      : projection(proj), compare(comp) {}
+    bool operator() (element_type const & lhs, element_type const & rhs) const
+    {
+      return compare(projection(lhs), projection(rhs));
+    }
+    Projection projection;
+    KeyCompare compare;
+  };
+  static element_type const & make (Type const & value, Projection const &)
+  {
+    return value;
+  }
+#if (__cplusplus >= 201103L)
+  static element_type && make (Type && value, Projection const &)
+  {
+    return std::move(value);
+  }
+#endif
+  static Type const & value (element_type const & element)
+  {
+    return element;
+  }
+  static void refresh (element_type &, Projection const &) {}
+};
+
+//! @brief Random-access iterator that hides cached keys.
+template <typename Type, typename BaseIterator, typename Traits>
+class const_iterator
+{
+ public:
+  typedef std::random_access_iterator_tag                 iterator_category;
+  typedef Type                                            value_type;
+  typedef typename std::iterator_traits<BaseIterator>::difference_type
+                                                          difference_type;
+  typedef Type const *                                    pointer;
+  typedef Type const &                                    reference;
+
+  const_iterator (void) : it_() {}
+  explicit const_iterator (BaseIterator it) : it_(it) {}
+
+  reference operator* (void) const { return Traits::value(*it_); }
+  pointer operator-> (void) const { return &Traits::value(*it_); }
+  reference operator[] (difference_type n) const
+  {
+    return Traits::value(it_[n]);
+  }
+
+  const_iterator & operator++ (void) { ++it_; return *this; }
+  const_iterator & operator-- (void) { --it_; return *this; }
+  const_iterator operator++ (int) { return const_iterator(it_++); }
+  const_iterator operator-- (int) { return const_iterator(it_--); }
+  const_iterator & operator+= (difference_type n) { it_ += n; return *this; }
+  const_iterator & operator-= (difference_type n) { it_ -= n; return *this; }
+  const_iterator operator+ (difference_type n) const
+  {
+    return const_iterator(it_ + n);
+  }
+  const_iterator operator- (difference_type n) const
+  {
+    return const_iterator(it_ - n);
+  }
+  difference_type operator- (const_iterator const & other) const
+  {
+    return it_ - other.it_;
+  }
+
+  bool operator== (const_iterator const & o) const { return it_ == o.it_; }
+  bool operator!= (const_iterator const & o) const { return it_ != o.it_; }
+  bool operator< (const_iterator const & o) const { return it_ < o.it_; }
+  bool operator> (const_iterator const & o) const { return it_ > o.it_; }
+  bool operator<= (const_iterator const & o) const { return it_ <= o.it_; }
+  bool operator>= (const_iterator const & o) const { return it_ >= o.it_; }
+
+  BaseIterator base (void) const { return it_; }
+ private:
+  BaseIterator it_;
+};
+} //  Namespace projected_priority_deque_internal
+/// \endcond
+
+//----------------------Projected Priority Deque Class-------------------------|
+/*! @brief Double-ended priority queue ordered by a projection of its elements.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param Projection Key extractor. %Projection(A) returns the key by which
+ *  %A is ordered. In C++03, it must define result_type.
+ *  @param KeyCompare Comparison class for keys. Defaults to std::less.
+ *  @param CacheKeys If true (the default), each key is computed once, when its
+ *  element is added, and stored beside the element. If false, the key is
+ *  re-computed for every comparison.
+ *  @details If an element is modified so that its key changes (for example,
+ *  if elements are pointers, and the pointed-to object changes), call
+ *  @a update on it to restore the ordering.
+ *  @note With cached keys, comparisons never call the projection, so elements
+ *  that are pointers are never dereferenced during sifting.
+ *  @see priority_deque
+ */
+template <typename Type, typename Projection,
+          typename KeyCompare = ::std::less<
+            typename projected_priority_deque_internal::key_of<Type,
+                                                           Projection>::type>,
+          bool CacheKeys = true>
+class projected_priority_deque
+  : private priority_deque<
+      typename projected_priority_deque_internal::entry_traits<Type,
+        typename projected_priority_deque_internal::key_of<Type,
+                                                           Projection>::type,
+        Projection, KeyCompare, CacheKeys>::element_type,
+      std::vector<typename projected_priority_deque_internal::entry_traits<
+        Type, typename projected_priority_deque_internal::key_of<Type,
+                                                           Projection>::type,
+        Projection, KeyCompare, CacheKeys>::element_type>,
+      typename projected_priority_deque_internal::entry_traits<Type,
+        typename projected_priority_deque_internal::key_of<Type,
+                                                           Projection>::type,
+        Projection, KeyCompare, CacheKeys>::element_compare>
+{
+ public:
+  typedef typename projected_priority_deque_internal::key_of<Type,
+                                                  Projection>::type key_type;
+ private:
+  typedef projected_priority_deque_internal::entry_traits<Type, key_type,
+                                    Projection, KeyCompare, CacheKeys> traits;
+  typedef priority_deque<typename traits::element_type,
+                         std::vector<typename traits::element_type>,
+                         typename traits::element_compare>          base_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Type                                        value_type;
+  typedef Projection                                  projection_type;
+  typedef KeyCompare                                  key_compare;
+  typedef typename base_type::size_type               size_type;
+  typedef typename base_type::difference_type         difference_type;
+  typedef Type const &                                const_reference;
+  typedef projected_priority_deque_internal::const_iterator<Type,
+                  typename base_type::const_iterator, traits> const_iterator;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty priority deque.
+  explicit projected_priority_deque   (Projection const & =Projection(),
+                                       KeyCompare const & =KeyCompare());
+/** @brief Constructs a new priority deque from a sequence of elements.
+//  @param first,last Range of elements.
+//  @param proj Instance of projection class.
+//  @param comp Instance of key comparison class.
+//  @post Deque contains copies of all elements in [ @a first, @a last).
+//
+//  @par Complexity:
+//    O(n) - Linear on the number of elements. Each element is projected once,
+//  if keys are cached.
+//  @par Exception safety:
+//    Strong.
+*/
+  template <typename InputIterator>
+  projected_priority_deque            (InputIterator first, InputIterator last,
+                                       Projection const & =Projection(),
+                                       KeyCompare const & =KeyCompare());
+//-----------------------------Restricted Access-------------------------------|
+/** @brief Copies an element into the priority deque.
+//  @param value Element to insert into the priority deque.
+//  @post Priority deque contains @a value or a copy of @a value.
+//  @post All iterators and references are invalidated.
+//
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the deque.
+//  @par  Exception safety:
+//    Strong - If an exception is thrown, the deque is restored to the state it
+//  had before push was called.
+*/
+  void                    push        (value_type const &);
+#if (__cplusplus >= 201103L)
+//!@overload
+  void                    push        (value_type &&);
+#endif
+//! @brief Accesses a maximal element in the deque.
+  const_reference         maximum     (void) const;
+//! @brief Accesses a minimal element in the deque.
+  const_reference         minimum     (void) const;
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline const_reference  top         (void) const  { return maximum(); }
+
+  using base_type::pop_maximum;
+  using base_type::pop_minimum;
+  using base_type::pop;
+  using base_type::empty;
+  using base_type::size;
+  using base_type::max_size;
+  using base_type::clear;
+//! @brief Exchanges the elements of two projected priority deques.
+  void                    swap        (projected_priority_deque &);
+//-------------------------------Random Access---------------------------------|
+//! @brief Returns a const iterator at the beginning of the sequence.
+  inline const_iterator   begin       (void) const
+  {
+    return const_iterator(base_type::begin());
+  }
+//! @brief Returns a const iterator past the end of the sequence.
+  inline const_iterator   end         (void) const
+  {
+    return const_iterator(base_type::end());
+  }
+/** @brief Modifies a specified element of the deque.
+//  @param  random_it A valid iterator in the range [begin, end).
+//  @param  value The new value.
+//  @post The element at @a random_it is set to @a value, and its key is
+//  re-computed.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the deque.
+//  @par  Exception safety:
+//    Basic if const reference is passed, strong if rvalue reference is passed.
+*/
+  void                    update      (const_iterator, value_type const &);
+#if (__cplusplus >= 201103L)
+//!@overload
+  void                    update      (const_iterator, value_type &&);
+#endif
+/** @brief Re-computes the key of a specified element.
+//  @param  random_it A valid iterator in the range [begin, end).
+//  @post The element at @a random_it is ordered by its current key.
+//  @post All iterators and references are invalidated.
+//  @details Use when the key of an element has changed without the element
+//  itself changing; for example, when the element is a pointer.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the deque.
+//  @par  Exception safety:
+//    Basic.
+*/
+  void                    update      (const_iterator);
+//! @brief Removes a specified element from the deque.
+  void                    erase       (const_iterator random_it)
+  {
+    base_type::erase(random_it.base());
+  }
+//! @brief Returns the key extractor.
+  inline const Projection& projection (void) const  { return projection_; }
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = false;
+  static const bool is_stable             = false;
+  static const bool has_reserve           = false;
+//---------------------------------Private-------------------------------------|
+ private:
+  Projection projection_;
+};
+
+template <typename T, typename P, typename K, bool CK>
+projected_priority_deque<T, P, K, CK>::projected_priority_deque
+  (P const & proj, K const & comp)
+  : base_type(typename traits::element_compare(proj, comp)), projection_(proj)
+{
+}
+
+template <typename T, typename P, typename K, bool CK>
+template <typename InputIterator>
+projected_priority_deque<T, P, K, CK>::projected_priority_deque
+  (InputIterator first, InputIterator last, P const & proj, K const & comp)
+  : base_type(typename traits::element_compare(proj, comp)), projection_(proj)
+{
+  typename base_type::container_type & seq = base_type::sequence();
+  for (; first != last; ++first)
+    seq.push_back(traits::make(*first, projection_));
+  heap::make_interval_heap(seq.begin(), seq.end(), base_type::compare());
+}
+
+//------------------------------------Insert-----------------------------------|
+template <typename T, typename P, typename K, bool CK>
+void projected_priority_deque<T, P, K, CK>::push (value_type const & value)
+{
+  base_type::push(traits::make(value, projection_));
+}
+#if (__cplusplus >= 201103L)
+template <typename T, typename P, typename K, bool CK>
+void projected_priority_deque<T, P, K, CK>::push (value_type && value)
+{
+  base_type::push(traits::make(std::move(value), projection_));
+}
+#endif
+
+//---------------------------Observe Maximum/Minimum---------------------------|
+template <typename T, typename P, typename K, bool CK>
+typename projected_priority_deque<T, P, K, CK>::const_reference
+  projected_priority_deque<T, P, K, CK>::maximum (void) const
+{
+  return traits::value(base_type::maximum());
+}
+
+template <typename T, typename P, typename K, bool CK>
+typename projected_priority_deque<T, P, K, CK>::const_reference
+  projected_priority_deque<T, P, K, CK>::minimum (void) const
+{
+  return traits::value(base_type::minimum());
+}
+
+//--------------------------Whole-Deque Operations-----------------------------|
+template <typename T, typename P, typename K, bool CK>
+void projected_priority_deque<T, P, K, CK>::swap (projected_priority_deque &
+                                                                        other)
+{
+  using std::swap;
+  base_type::swap(other);
+  swap(projection_, other.projection_);
+}
+
+//-------------------------------Random Access---------------------------------|
+template <typename T, typename P, typename K, bool CK>
+void projected_priority_deque<T, P, K, CK>::update (const_iterator random_it,
+                                                    value_type const & value)
+{
+  base_type::update(random_it.base(), traits::make(value, projection_));
+}
+#if (__cplusplus >= 201103L)
+template <typename T, typename P, typename K, bool CK>
+void projected_priority_deque<T, P, K, CK>::update (const_iterator random_it,
+                                                    value_type && value)
+{
+  base_type::update(random_it.base(),
+                    traits::make(std::move(value), projection_));
+}
+#endif
+
+template <typename T, typename P, typename K, bool CK>
+void projected_priority_deque<T, P, K, CK>::update (const_iterator random_it)
+{
+  typename base_type::container_type & seq = base_type::sequence();
+  const difference_type ind = random_it - begin();
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT((0 <= ind) &&
+    (ind < end() - begin()), "Iterator out of bounds; can't update element.");
+  traits::refresh(*(seq.begin() + ind), projection_);
+  heap::update_interval_heap(seq.begin(), seq.end(), ind, base_type::compare());
+}
+
+/** @brief Swaps the elements of two projected priority deques.
+// @relates projected_priority_deque
+*/
+template <typename T, typename P, typename K, bool CK>
+inline void swap (projected_priority_deque<T, P, K, CK> & deque1,
+                  projected_priority_deque<T, P, K, CK> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
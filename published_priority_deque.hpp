@@ -0,0 +1,279 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file published_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    published_priority_deque.hpp provides the class published_priority_deque,
+//  a priority deque shared by threads that modify it and threads that only
+//  need to know its extremes.
+//    Modifications are made under a mutex. After each one, the size and the
+//  keys of the least and greatest elements are published through a sequence
+//  lock: the writer makes the sequence odd, stores the snapshot, and makes it
+//  even again. A reader copies the snapshot between two reads of the
+//  sequence, and retries if they differ. Readers never block the writer, nor
+//  each other, and write nothing that the writer reads.
+//  @par  Thread safety:
+//    All member functions may be called from any thread.
+//  @par Exception safety:
+//    As for priority_deque. If a modification throws, the state it leaves is
+//  published.
+*/
+
+#ifndef BOOST_CONTAINER_PUBLISHED_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_PUBLISHED_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error published_priority_deque.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error published_priority_deque.hpp requires C++11 (for std::atomic).
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "priority_deque.hpp"
+//  Grab identity_key and key_of, shared with unique_priority_deque.
+#include "unique_priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//-----------------------Published Priority Deque Class------------------------|
+/*! @brief Priority deque whose extremes may be read without taking its lock.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param KeyOf Key extractor. %KeyOf(A) returns the key published for
+ *  element %A. The key must be trivially copyable. Defaults to identity_key,
+ *  for small elements that may be published whole.
+ *  @param Sequence Underlying sequence container, as for priority_deque.
+ *  @param Compare Comparison class, as for priority_deque.
+ *  @details A snapshot is consistent: its size and keys were all true at one
+ *  moment. It may be stale by the time it is used, so it suits decisions that
+ *  tolerate a race anyway, such as admission control.
+ *  @see priority_deque
+ */
+template <typename Type, typename KeyOf = identity_key,
+          typename Sequence =std::vector<Type>,
+          typename Compare =::std::less<Type> >
+class published_priority_deque
+{
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef priority_deque<Type, Sequence, Compare>     deque_type;
+  typedef typename deque_type::value_type             value_type;
+  typedef typename deque_type::size_type              size_type;
+  typedef Compare                                     value_compare;
+  typedef KeyOf                                       key_extractor;
+  typedef typename unique_priority_deque_internal::key_of<Type, KeyOf>::type
+                                                      key_type;
+//! @brief The published state. If @a size is 0, the keys are meaningless.
+  struct extremes
+  {
+    size_type size;
+    key_type minimum;
+    key_type maximum;
+  };
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty deque, and publishes that it is empty.
+  explicit published_priority_deque   (Compare const & comp =Compare(),
+                                       KeyOf const & key =KeyOf())
+    : deque_(comp), key_(key), sequence_(0)
+  {
+    for (std::size_t i = 0; i < kWords; ++i)
+      words_[i].store(0, std::memory_order_relaxed);
+    publish();
+  }
+  published_priority_deque            (published_priority_deque const &)
+                                                                      =delete;
+  published_priority_deque & operator=(published_priority_deque const &)
+                                                                      =delete;
+//---------------------------------Readers-------------------------------------|
+/** @brief Returns the most recently published state, without locking.
+//  @par  Complexity:
+//    O(1), though a reader retries while the writer is publishing.
+*/
+  extremes                peek        (void) const;
+/** @brief Copies the key of a minimal element into @a out, without locking.
+//  @return False if the deque was empty.
+*/
+  bool                    peek_minimum(key_type & out) const
+  {
+    const extremes seen = peek();
+    if (seen.size)
+      out = seen.minimum;
+    return seen.size != 0;
+  }
+//! @brief Copies the key of a maximal element into @a out, without locking.
+  bool                    peek_maximum(key_type & out) const
+  {
+    const extremes seen = peek();
+    if (seen.size)
+      out = seen.maximum;
+    return seen.size != 0;
+  }
+//! @brief Returns the published number of elements, without locking.
+  size_type               size        (void) const { return peek().size; }
+//! @brief Returns true if the deque was empty when last published.
+  bool                    empty       (void) const { return size() == 0; }
+//---------------------------------Writers-------------------------------------|
+/** @brief Adds an element, and publishes.
+//  @par  Complexity:
+//    O(log n)
+*/
+  void                    push        (value_type const & value)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    published guard (*this);
+    deque_.push(value);
+  }
+//!@overload
+  void                    push        (value_type && value)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    published guard (*this);
+    deque_.push(std::move(value));
+  }
+/** @brief Removes a maximal element, if there is one, and publishes.
+//  @return True if an element was moved into @a out.
+//  @par  Complexity:
+//    O(log n)
+*/
+  bool                    try_pop_maximum (value_type & out)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (deque_.empty())
+      return false;
+    published guard (*this);
+    deque_.pop_maximum_n(1, &out);
+    return true;
+  }
+//! @brief Removes a minimal element, if there is one, and publishes.
+  bool                    try_pop_minimum (value_type & out)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    if (deque_.empty())
+      return false;
+    published guard (*this);
+    deque_.pop_minimum_n(1, &out);
+    return true;
+  }
+//! @brief Removes every element, and publishes.
+  void                    clear       (void)
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    published guard (*this);
+    deque_.clear();
+  }
+/** @brief Calls @a f(deque) under the lock, then publishes once.
+//  @details For operations not wrapped here, such as merging or batch removal.
+//  @return Whatever @a f returns.
+*/
+  template <typename Function>
+  auto                    modify      (Function f)
+    -> decltype(f(std::declval<deque_type &>()))
+  {
+    std::lock_guard<std::mutex> lock (lock_);
+    published guard (*this);
+    return f(deque_);
+  }
+//! @brief Returns the number of times a state has been published.
+  uint64_t                publications(void) const
+  {
+    return sequence_.load(std::memory_order_relaxed) / 2;
+  }
+//---------------------------------Private-------------------------------------|
+ private:
+  static_assert(std::is_trivially_copyable<key_type>::value,
+                "Published keys must be trivially copyable.");
+  static const std::size_t kWords = (sizeof(extremes) + sizeof(uint64_t) - 1)
+                                  / sizeof(uint64_t);
+//  Publishes when the modification ends, whether or not it throws.
+  struct published
+  {
+    published_priority_deque & self;
+    explicit published (published_priority_deque & s) : self(s) {}
+    ~published (void) { self.publish(); }
+  };
+//  Called with lock_ held, so there is one writer at a time.
+  void publish (void);
+
+  deque_type deque_;
+  KeyOf key_;
+  std::mutex lock_;
+//  The snapshot is stored in words, each atomic, so that a reader racing with
+//  the writer sees torn data (and retries) rather than undefined behavior.
+//  Readers touch only this line.
+  alignas(64) std::atomic<uint64_t> sequence_;
+  std::atomic<uint64_t> words_ [kWords];
+};
+
+template <typename T, typename K, typename S, typename C>
+const std::size_t published_priority_deque<T, K, S, C>::kWords;
+
+template <typename T, typename K, typename S, typename C>
+void published_priority_deque<T, K, S, C>::publish (void)
+{
+  uint64_t buffer [kWords] = {};
+  extremes state;
+  state.size = deque_.size();
+  if (state.size)
+  {
+    state.minimum = key_(deque_.minimum());
+    state.maximum = key_(deque_.maximum());
+  } else {
+    std::memset(static_cast<void *>(&state), 0, sizeof(state));
+  }
+  std::memcpy(buffer, &state, sizeof(state));
+
+  const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+//  The odd sequence must be visible before any word of the new snapshot is.
+  std::atomic_thread_fence(std::memory_order_release);
+  for (std::size_t i = 0; i < kWords; ++i)
+    words_[i].store(buffer[i], std::memory_order_relaxed);
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+template <typename T, typename K, typename S, typename C>
+typename published_priority_deque<T, K, S, C>::extremes
+  published_priority_deque<T, K, S, C>::peek (void) const
+{
+  uint64_t buffer [kWords];
+  for (;;)
+  {
+    const uint64_t before = sequence_.load(std::memory_order_acquire);
+//  The writer is publishing. It holds no lock a reader could wait on, so yield.
+    if (before & 1)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    for (std::size_t i = 0; i < kWords; ++i)
+      buffer[i] = words_[i].load(std::memory_order_relaxed);
+//  The words must be read before the sequence is checked again.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) == before)
+      break;
+  }
+  extremes state;
+  std::memcpy(static_cast<void *>(&state), buffer, sizeof(state));
+  return state;
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
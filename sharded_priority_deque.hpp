@@ -0,0 +1,431 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file sharded_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    sharded_priority_deque.hpp provides the class sharded_priority_deque, a
+//  priority deque whose elements are split among several priority deques
+//  (shards), so that the shards may be loaded or updated by separate threads.
+//    Two tournament trees over the shards (one of their minima, one of their
+//  maxima) give the global extremes in O(1). Removing one costs O(log n/N) in
+//  its shard and O(log N) to replay its tournaments, for n elements in N
+//  shards.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior. Functions that take a thread count synchronize their own threads.
+//  @par Exception safety:
+//    As for priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_SHARDED_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_SHARDED_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error sharded_priority_deque.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error sharded_priority_deque.hpp requires C++11 (for std::thread).
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <stdint.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//-----------------------------Shard Assignment--------------------------------|
+//! @brief Assigns elements to shards by std::hash. The default.
+struct hash_shard
+{
+  template <typename Value>
+  std::size_t operator() (Value const & value, std::size_t shards) const
+  {
+//  Fibonacci hashing spreads hashes that are identities, as for integers.
+    const uint64_t mixed = static_cast<uint64_t>(std::hash<Value>()(value)) *
+                           UINT64_C(0x9E3779B97F4A7C15);
+    return static_cast<std::size_t>((mixed >> 32) % shards);
+  }
+};
+
+/*! @brief Assigns elements to shards by range.
+//  @details Given bounds b[0] < b[1] < ..., shard 0 takes the elements ordered
+//  before b[0], shard i those not before b[i-1] and before b[i], and the last
+//  shard the rest. Extra shards stay empty; excess bounds are ignored.
+*/
+template <typename Type, typename Compare =::std::less<Type> >
+struct range_shard
+{
+  explicit range_shard (std::vector<Type> const & b,
+                        Compare const & comp = Compare())
+    : bounds(b), compare(comp) {}
+  std::size_t operator() (Type const & value, std::size_t shards) const
+  {
+    const std::size_t index = std::upper_bound(bounds.begin(), bounds.end(),
+                                               value, compare) - bounds.begin();
+    return (index < shards) ? index : (shards - 1);
+  }
+  std::vector<Type> bounds;
+  Compare compare;
+};
+
+//------------------------Sharded Priority Deque Class-------------------------|
+/*! @brief Priority deque split among shards, with exact global extremes.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param Sharding Assigns elements to shards. %Sharding(A, N) returns the
+ *  shard, in [0, N), of element %A. Defaults to hash_shard.
+ *  @param Sequence Underlying sequence container of each shard. Defaults to
+ *  std::vector<Type>.
+ *  @param Compare Comparison class. Defaults to std::less<Type>.
+ *  @see priority_deque
+ */
+template <typename Type, typename Sharding = hash_shard,
+          typename Sequence =std::vector<Type>,
+          typename Compare =::std::less<Type> >
+class sharded_priority_deque
+{
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef priority_deque<Type, Sequence, Compare>     shard_type;
+  typedef typename shard_type::value_type             value_type;
+  typedef typename shard_type::const_reference        const_reference;
+  typedef typename shard_type::size_type              size_type;
+  typedef Compare                                     value_compare;
+  typedef Sharding                                    shard_assignment;
+//-------------------------------Constructors----------------------------------|
+/** @brief Constructs an empty deque with @a shards shards.
+//  @pre @a shards is at least 1.
+*/
+  explicit sharded_priority_deque     (size_type shards,
+                                       Sharding const & sharding = Sharding(),
+                                       Compare const & comp = Compare());
+//-----------------------------Restricted Access-------------------------------|
+/** @brief Inserts an element into its shard.
+//  @par  Complexity:
+//    O(log n/N + log N) - Logarithmic on the size of a shard, and on the
+//  number of shards.
+//  @par  Exception safety:
+//    Strong, if comparisons do not throw.
+*/
+  void                    push        (value_type const & value)
+  {
+    const size_type index = shard_of(value);
+    shards_[index].push(value);
+    ++size_;
+    replay(index);
+  }
+//!@overload
+  void                    push        (value_type && value)
+  {
+    const size_type index = shard_of(value);
+    shards_[index].push(std::move(value));
+    ++size_;
+    replay(index);
+  }
+/** @brief Accesses a maximal element.
+//  @pre  Priority deque contains one or more elements.
+//  @par  Complexity:
+//    O(1) - Does not depend on the size of the deque.
+*/
+  const_reference         maximum     (void) const
+  {
+    BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+      "Empty priority deque has no maximal element. Reference undefined.");
+    return shards_[max_tree_[1]].maximum();
+  }
+//! @brief Accesses a minimal element. @see maximum
+  const_reference         minimum     (void) const
+  {
+    BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+      "Empty priority deque has no minimal element. Reference undefined.");
+    return shards_[min_tree_[1]].minimum();
+  }
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  const_reference         top         (void) const  { return maximum(); }
+/** @brief Removes a maximal element.
+//  @pre  Priority deque contains one or more elements.
+//  @par  Complexity:
+//    O(log n/N + log N) - Logarithmic on the size of a shard, and on the
+//  number of shards.
+//  @par  Exception safety:
+//    Strong, if comparisons do not throw.
+*/
+  void                    pop_maximum (void)
+  {
+    BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+      "Empty priority deque has no maximal element. Removal impossible.");
+    const size_type index = max_tree_[1];
+    shards_[index].pop_maximum();
+    --size_;
+    replay(index);
+  }
+//! @brief Removes a minimal element. @see pop_maximum
+  void                    pop_minimum (void)
+  {
+    BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+      "Empty priority deque has no minimal element. Removal impossible.");
+    const size_type index = min_tree_[1];
+    shards_[index].pop_minimum();
+    --size_;
+    replay(index);
+  }
+//! @details Identical to std::priority_queue pop(). @see @a pop_maximum
+  void                    pop         (void)        { pop_maximum(); }
+//--------------------------------Deque Size-----------------------------------|
+  bool                    empty       (void) const  { return size_ == 0; }
+  size_type               size        (void) const  { return size_; }
+//! @brief Returns the number of shards.
+  size_type               shards      (void) const  { return shards_.size(); }
+//! @brief Accesses a shard.
+  shard_type const &      shard       (size_type index) const
+  {
+    return shards_[index];
+  }
+//--------------------------Whole-Deque Operations-----------------------------|
+/** @brief Merges a sequence of elements, building the shards in parallel.
+//  @param first,last Forward iterators bounding the range [ @a first, @a last)
+//  @param threads Maximum number of threads building shards at once.
+//  @details The elements are first dealt to their shards, in one pass.
+//  @par  Complexity:
+//    O(n) - Linear on the size of the deque.
+//  @par  Exception safety:
+//    Basic; elements may be lost, as with priority_deque::insert.
+*/
+  template <typename ForwardIterator>
+  void                    insert      (ForwardIterator first,
+                                       ForwardIterator last,
+                                       unsigned int threads = 1);
+/** @brief Applies @a f to every shard, in parallel.
+//  @param f Called as @a f(shard, index), where @a shard is a (non-const)
+//  reference to a priority_deque. Each thread uses its own copy of @a f.
+//  @param threads Maximum number of threads at once.
+//  @details Lets each shard be updated by its own thread. The tournaments are
+//  replayed afterward, so the extremes stay exact even if @a f adds elements
+//  that @a Sharding would place in another shard.
+//  @par  Complexity:
+//    O(N) - Linear on the number of shards, plus the cost of @a f.
+*/
+  template <typename ShardFunction>
+  void                    for_each_shard (ShardFunction f,
+                                          unsigned int threads = 1);
+//! @brief Removes all elements.
+  void                    clear       (void)
+  {
+    for (size_type i = 0; i < shards_.size(); ++i)
+      shards_[i].clear();
+    rebuild();
+  }
+//! @brief Exchanges the elements of two deques.
+  void                    swap        (sharded_priority_deque & other)
+  {
+    using std::swap;
+    shards_.swap(other.shards_);
+    min_tree_.swap(other.min_tree_);
+    max_tree_.swap(other.max_tree_);
+    swap(leaves_, other.leaves_);
+    swap(size_, other.size_);
+    swap(sharding_, other.sharding_);
+    swap(less_, other.less_);
+  }
+//---------------------------------Private-------------------------------------|
+ private:
+  typedef heap::interval_heap_internal::heap_compare<Compare, Type> adapted;
+  typedef typename adapted::type Less;
+  static const size_type kNone = ~size_type(0);
+
+  size_type shard_of (value_type const & value) const
+  {
+    return sharding_(value, shards_.size());
+  }
+//  Winner of a match in each tournament. Empty shards lose every match.
+  size_type min_winner (size_type a, size_type b) const
+  {
+    if (a == kNone || (b != kNone &&
+                       less_(shards_[b].minimum(), shards_[a].minimum())))
+      return b;
+    return a;
+  }
+  size_type max_winner (size_type a, size_type b) const
+  {
+    if (a == kNone || (b != kNone &&
+                       less_(shards_[a].maximum(), shards_[b].maximum())))
+      return b;
+    return a;
+  }
+//  Replays the matches of one shard's path to the root, in both trees.
+  void replay (size_type index)
+  {
+    size_type node = leaves_ + index;
+    const size_type entry = shards_[index].empty() ? kNone : index;
+    min_tree_[node] = entry;
+    max_tree_[node] = entry;
+    for (node >>= 1; node > 0; node >>= 1) {
+      min_tree_[node] = min_winner(min_tree_[2 * node], min_tree_[2 * node + 1]);
+      max_tree_[node] = max_winner(max_tree_[2 * node], max_tree_[2 * node + 1]);
+    }
+  }
+//  Recounts the elements and replays every match, bottom-up.
+  void rebuild (void)
+  {
+    size_ = 0;
+    for (size_type i = 0; i < leaves_; ++i) {
+      const bool present = (i < shards_.size()) && !shards_[i].empty();
+      min_tree_[leaves_ + i] = max_tree_[leaves_ + i] = present ? i : kNone;
+      if (present)
+        size_ += shards_[i].size();
+    }
+    for (size_type node = leaves_ - 1; node > 0; --node) {
+      min_tree_[node] = min_winner(min_tree_[2 * node], min_tree_[2 * node + 1]);
+      max_tree_[node] = max_winner(max_tree_[2 * node], max_tree_[2 * node + 1]);
+    }
+  }
+
+  std::vector<shard_type> shards_;
+//  Heap-ordered trees: node i has children 2i and 2i+1; shard j is leaf
+//  leaves_ + j. Each node holds the winning shard, or kNone.
+  std::vector<size_type> min_tree_, max_tree_;
+  size_type leaves_;
+  size_type size_;
+  Sharding sharding_;
+  Less less_;
+};
+
+template <typename T, typename H, typename S, typename C>
+const typename sharded_priority_deque<T, H, S, C>::size_type
+  sharded_priority_deque<T, H, S, C>::kNone;
+
+template <typename T, typename H, typename S, typename C>
+sharded_priority_deque<T, H, S, C>::sharded_priority_deque (size_type shards,
+  H const & sharding, C const & comp)
+  : shards_(shards, shard_type(comp)), leaves_(1), size_(0),
+    sharding_(sharding), less_(adapted::adapt(comp))
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(shards > 0,
+    "A sharded priority deque needs at least one shard.");
+  while (leaves_ < shards)
+    leaves_ <<= 1;
+//  With one shard, the root (node 1) is also the leaf.
+  min_tree_.resize(2 * leaves_);
+  max_tree_.resize(2 * leaves_);
+  rebuild();
+}
+
+template <typename T, typename H, typename S, typename C>
+template <typename ShardFunction>
+void sharded_priority_deque<T, H, S, C>::for_each_shard (ShardFunction f,
+                                                         unsigned int threads)
+{
+  struct RAIIGuard
+  {
+    sharded_priority_deque * deque_;
+    ~RAIIGuard (void) { deque_->rebuild(); }
+  } guard = { this };
+  if (threads > shards_.size())
+    threads = static_cast<unsigned int>(shards_.size());
+  if (threads <= 1) {
+    for (size_type i = 0; i < shards_.size(); ++i)
+      f(shards_[i], i);
+    return;
+  }
+//  Thread t takes shards t, t + threads, and so on.
+  std::vector<std::exception_ptr> errors (threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+//  If a thread cannot be started, those already running must finish first.
+  struct RAIIJoiner
+  {
+    std::vector<std::thread> & workers_;
+    ~RAIIJoiner (void)
+    {
+      for (std::size_t t = 0; t < workers_.size(); ++t)
+        if (workers_[t].joinable())
+          workers_[t].join();
+    }
+  } joiner = { workers };
+  struct task
+  {
+    static void run (sharded_priority_deque * self, ShardFunction f,
+                     unsigned int first, unsigned int stride,
+                     std::exception_ptr * error)
+    {
+      try {
+        for (size_type i = first; i < self->shards_.size(); i += stride)
+          f(self->shards_[i], i);
+      } catch (...) {
+        *error = std::current_exception();
+      }
+    }
+  };
+  for (unsigned int t = 1; t < threads; ++t)
+    workers.push_back(std::thread(&task::run, this, f, t, threads,
+                                  &errors[t]));
+  task::run(this, f, 0, threads, &errors[0]);
+  for (std::size_t t = 0; t < workers.size(); ++t)
+    workers[t].join();
+  for (std::size_t t = 0; t < errors.size(); ++t)
+    if (errors[t])
+      std::rethrow_exception(errors[t]);
+}
+
+/// \cond false
+namespace sharded_priority_deque_internal {
+//  Moves a bucket of elements into a shard.
+template <typename Shard, typename Bucket>
+struct fill_shard
+{
+  std::vector<Bucket> * buckets;
+  void operator() (Shard & shard, std::size_t index) const
+  {
+    Bucket & bucket = (*buckets)[index];
+    shard.insert(std::make_move_iterator(bucket.begin()),
+                 std::make_move_iterator(bucket.end()));
+    Bucket().swap(bucket);
+  }
+};
+} //  Namespace sharded_priority_deque_internal
+/// \endcond
+
+template <typename T, typename H, typename S, typename C>
+template <typename ForwardIterator>
+void sharded_priority_deque<T, H, S, C>::insert (ForwardIterator first,
+                                                 ForwardIterator last,
+                                                 unsigned int threads)
+{
+  std::vector<S> buckets (shards_.size());
+  for (; first != last; ++first)
+    buckets[shard_of(*first)].push_back(*first);
+  sharded_priority_deque_internal::fill_shard<shard_type, S> fill = {
+    &buckets };
+  for_each_shard(fill, threads);
+}
+
+/** @brief Swaps the elements of two sharded priority deques.
+// @relates sharded_priority_deque
+*/
+template <typename T, typename H, typename S, typename C>
+inline void swap (sharded_priority_deque<T, H, S, C> & deque1,
+                  sharded_priority_deque<T, H, S, C> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -0,0 +1,389 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file stable_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    stable_priority_deque.hpp provides the class stable_priority_deque, a
+//  priority deque in which equivalent elements are removed in the order in
+//  which they were added (from the minimum end), or in the reverse of that
+//  order (from the maximum end).
+//    Each element is stamped with a sequence number when it is added. Where
+//  possible, the stamp is packed into the unused bits of a single integer
+//  alongside the element, so that ties are broken by the same integer
+//  comparison that orders the elements.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_STABLE_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_STABLE_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error stable_priority_deque.hpp requires a C++ compiler.
+#endif
+
+//  Grab std::numeric_limits, to find unused bits of integral types.
+#include <limits>
+//  Fixed-width stamps.
+#include <stdint.h>
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//! @brief Double-ended priority queue that breaks ties by order of insertion.
+template <typename Type, typename Compare =::std::less<Type> >
+class stable_priority_deque;
+
+/// \cond false
+namespace stable_priority_deque_internal {
+/*! @brief Stamped element, for any type and comparison.
+//    Equivalent elements are compared by stamp, which requires a second call
+//  to the comparison object.
+*/
+template <typename Type, typename Compare, int packing>
+struct stamp_traits
+{
+  typedef uint64_t              stamp_type;
+  typedef Type const &          const_reference;
+  struct element_type
+  {
+    Type value;
+    stamp_type stamp;
+  };
+  struct element_compare
+  {
+    element_compare (Compare const & comp) : compare(comp) {}
+    bool operator() (element_type const & lhs, element_type const & rhs) const
+    {
+      if (compare(lhs.value, rhs.value))
+        return true;
+      if (compare(rhs.value, lhs.value))
+        return false;
+      return lhs.stamp < rhs.stamp;
+    }
+    Compare compare;
+  };
+  static element_compare make_compare (Compare const & comp)
+  {
+    return element_compare(comp);
+  }
+//! @brief Bound on stamps; reaching it forces re-stamping.
+  static stamp_type max_stamp (void)
+  {
+    return std::numeric_limits<stamp_type>::max();
+  }
+  static element_type make (Type const & value, stamp_type stamp)
+  {
+    element_type result = { value, stamp };
+    return result;
+  }
+#if (__cplusplus >= 201103L)
+  static element_type make (Type && value, stamp_type stamp)
+  {
+    element_type result = { std::move(value), stamp };
+    return result;
+  }
+#endif
+  static const_reference value (element_type const & element)
+  {
+    return element.value;
+  }
+  static void restamp (element_type & element, stamp_type stamp)
+  {
+    element.stamp = stamp;
+  }
+};
+
+/*! @brief Stamped element, for small integers compared by std::less (packing
+//  = 1) or std::greater (packing = -1).
+//    The element is mapped to an unsigned integer in the high bits of a 64-bit
+//  word, preserving its order under the comparison. The stamp occupies the
+//  remaining low bits.
+*/
+template <typename Type, typename Compare, int packing>
+struct packed_stamp_traits
+{
+  typedef uint64_t              stamp_type;
+  typedef Type                  const_reference;
+  typedef uint64_t              element_type;
+  typedef std::less<uint64_t>   element_compare;
+
+  static const int kValueBits = std::numeric_limits<Type>::digits +
+                                (std::numeric_limits<Type>::is_signed ? 1 : 0);
+  static const int kStampBits = 64 - kValueBits;
+
+  static element_compare make_compare (Compare const &)
+  {
+    return element_compare();
+  }
+  static stamp_type max_stamp (void)
+  {
+    return (static_cast<stamp_type>(1) << kStampBits) - 1;
+  }
+  static element_type make (Type value, stamp_type stamp)
+  {
+//  Conversion to unsigned is modular, so flipping the sign bit of a signed
+//  type maps its least value to zero.
+    uint64_t key = static_cast<uint64_t>(value);
+    if (std::numeric_limits<Type>::is_signed)
+      key ^= static_cast<uint64_t>(1) << (kValueBits - 1);
+    key &= (~static_cast<uint64_t>(0)) >> kStampBits;
+    if (packing < 0)
+      key ^= (~static_cast<uint64_t>(0)) >> kStampBits;
+    return (key << kStampBits) | stamp;
+  }
+  static const_reference value (element_type element)
+  {
+    uint64_t key = element >> kStampBits;
+    if (packing < 0)
+      key ^= (~static_cast<uint64_t>(0)) >> kStampBits;
+    if (std::numeric_limits<Type>::is_signed)
+      key ^= static_cast<uint64_t>(1) << (kValueBits - 1);
+//  Sign-extend, so that the conversion to Type is value-preserving.
+    if (std::numeric_limits<Type>::is_signed &&
+        (key & (static_cast<uint64_t>(1) << (kValueBits - 1))))
+      key |= ~((~static_cast<uint64_t>(0)) >> kStampBits);
+    return static_cast<Type>(static_cast<int64_t>(key));
+  }
+  static void restamp (element_type & element, stamp_type stamp)
+  {
+    element = ((element >> kStampBits) << kStampBits) | stamp;
+  }
+};
+
+//! @brief 1 for std::less, -1 for std::greater, 0 for any other comparison.
+template <typename Type, typename Compare>
+struct standard_order { static const int value = 0; };
+template <typename Type>
+struct standard_order<Type, std::less<Type> > { static const int value = 1; };
+template <typename Type>
+struct standard_order<Type, std::greater<Type> >
+{
+  static const int value = -1;
+};
+
+//! @brief Whether stamps may be packed alongside elements. At least 16 bits
+//! must remain for the stamp, or re-stamping would dominate.
+template <typename Type, typename Compare>
+struct is_packable
+{
+  static const bool value = std::numeric_limits<Type>::is_integer &&
+                            (std::numeric_limits<Type>::digits +
+                             (std::numeric_limits<Type>::is_signed ? 1 : 0)
+                             <= 48) &&
+                            (standard_order<Type, Compare>::value != 0);
+};
+
+template <typename Type, typename Compare,
+          bool packable = is_packable<Type, Compare>::value>
+struct select_traits
+{
+  typedef stamp_traits<Type, Compare, 0> type;
+};
+template <typename Type, typename Compare>
+struct select_traits<Type, Compare, true>
+{
+  typedef packed_stamp_traits<Type, Compare,
+                              standard_order<Type, Compare>::value> type;
+};
+} //  Namespace stable_priority_deque_internal
+/// \endcond
+
+//-------------------------Stable Priority Deque Class-------------------------|
+/*! @brief Double-ended priority queue that breaks ties by order of insertion.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param Compare Comparison class. %Compare(A, B) should return true if %A
+ *  should be placed earlier than %B in a strict weak ordering.
+ *  Defaults to std::less<Type>, which encapsulates operator<.
+ *  @details Of several equivalent elements, pop_minimum removes the one that
+ *  was added first, and pop_maximum removes the one that was added last.
+ *  Integral types of up to 48 bits, compared by std::less or std::greater, are
+ *  packed with their stamps into a single 64-bit integer (for example, a
+ *  32-bit priority above a 32-bit stamp). Other elements are stored alongside
+ *  a separate stamp, and equivalent elements cost a second comparison.
+ *  @note Packed elements are decoded on access, so minimum and maximum return
+ *  by value rather than by reference.
+ *  @note When the stamps are exhausted, the deque is sorted and re-stamped.
+ *  This costs O(n log n), but happens at most once per 2^16 insertions, and
+ *  once per 2^32 insertions for 32-bit elements.
+ *  @see priority_deque
+ */
+template <typename Type, typename Compare>
+class stable_priority_deque
+  : private priority_deque<
+      typename stable_priority_deque_internal::select_traits<Type,
+                                                 Compare>::type::element_type,
+      std::vector<typename stable_priority_deque_internal::select_traits<Type,
+                                                 Compare>::type::element_type>,
+      typename stable_priority_deque_internal::select_traits<Type,
+                                                 Compare>::type::element_compare>
+{
+  typedef typename stable_priority_deque_internal::select_traits<Type,
+                                                    Compare>::type  traits;
+  typedef priority_deque<typename traits::element_type,
+                         std::vector<typename traits::element_type>,
+                         typename traits::element_compare>          base_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Type                                        value_type;
+  typedef Compare                                     value_compare;
+  typedef typename base_type::size_type               size_type;
+//! @details Either a const reference, or (for packed elements) a value.
+  typedef typename traits::const_reference            const_reference;
+  typedef typename traits::stamp_type                 stamp_type;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty stable priority deque.
+  explicit stable_priority_deque      (Compare const & =Compare());
+//-----------------------------Restricted Access-------------------------------|
+/** @brief Copies an element into the priority deque.
+//  @param value Element to insert into the priority deque.
+//  @post Priority deque contains @a value or a copy of @a value, ordered after
+//  all equivalent elements already in the deque.
+//  @post All iterators and references are invalidated.
+//
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the deque (amortized).
+//  @par  Exception safety:
+//    Strong - If an exception is thrown, the deque is restored to the state it
+//  had before push was called.
+*/
+  void                    push        (value_type const &);
+#if (__cplusplus >= 201103L)
+//!@overload
+  void                    push        (value_type &&);
+#endif
+//! @brief Accesses a maximal element; of several, the last added.
+  const_reference         maximum     (void) const;
+//! @brief Accesses a minimal element; of several, the first added.
+  const_reference         minimum     (void) const;
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline const_reference  top         (void) const  { return maximum(); }
+
+  using base_type::pop_maximum;
+  using base_type::pop_minimum;
+  using base_type::pop;
+  using base_type::empty;
+  using base_type::size;
+  using base_type::max_size;
+//! @brief Removes all elements from the priority deque.
+  void                    clear       (void);
+//! @brief Exchanges the elements of two stable priority deques.
+  void                    swap        (stable_priority_deque<Type, Compare> &);
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = false;
+// stable priority deque has a stable heap order
+  static const bool is_stable             = true;
+  static const bool has_reserve           = false;
+//--------------------------------Protected------------------------------------|
+ protected:
+//! @brief Stamp that will be given to the next element added.
+  inline        stamp_type &    next_stamp (void)       { return next_stamp_; }
+  inline const  stamp_type &    next_stamp (void) const { return next_stamp_; }
+//---------------------------------Private-------------------------------------|
+ private:
+  void restamp (void);
+  stamp_type next_stamp_;
+};
+
+template <typename T, typename C>
+stable_priority_deque<T, C>::stable_priority_deque (C const & comp)
+  : base_type(traits::make_compare(comp)), next_stamp_(0)
+{
+}
+
+//------------------------------------Insert-----------------------------------|
+template <typename T, typename C>
+void stable_priority_deque<T, C>::push (value_type const & value)
+{
+  if (next_stamp_ >= traits::max_stamp())
+    restamp();
+  base_type::push(traits::make(value, next_stamp_));
+  ++next_stamp_;
+}
+#if (__cplusplus >= 201103L)
+template <typename T, typename C>
+void stable_priority_deque<T, C>::push (value_type && value)
+{
+  if (next_stamp_ >= traits::max_stamp())
+    restamp();
+  base_type::push(traits::make(std::move(value), next_stamp_));
+  ++next_stamp_;
+}
+#endif
+
+//---------------------------Observe Maximum/Minimum---------------------------|
+template <typename T, typename C>
+typename stable_priority_deque<T, C>::const_reference
+  stable_priority_deque<T, C>::maximum (void) const
+{
+  return traits::value(base_type::maximum());
+}
+
+template <typename T, typename C>
+typename stable_priority_deque<T, C>::const_reference
+  stable_priority_deque<T, C>::minimum (void) const
+{
+  return traits::value(base_type::minimum());
+}
+
+//--------------------------Whole-Deque Operations-----------------------------|
+template <typename T, typename C>
+void stable_priority_deque<T, C>::clear (void)
+{
+  base_type::clear();
+  next_stamp_ = 0;
+}
+
+template <typename T, typename C>
+void stable_priority_deque<T, C>::swap (stable_priority_deque<T, C> & other)
+{
+  using std::swap;
+  base_type::swap(other);
+  swap(next_stamp_, other.next_stamp_);
+}
+
+//  The last stamp overflowed (or will overflow). Renumber the elements, in
+//  order, from zero; the sorted result needs no comparisons to re-arrange.
+template <typename T, typename C>
+void stable_priority_deque<T, C>::restamp (void)
+{
+  typedef typename base_type::container_type container_type;
+  container_type & seq = base_type::sequence();
+  heap::sort_interval_heap(seq.begin(), seq.end(), base_type::compare());
+  next_stamp_ = 0;
+  for (typename container_type::iterator it = seq.begin(); it != seq.end();
+       ++it)
+    traits::restamp(*it, next_stamp_++);
+  heap::make_interval_heap_from_sorted(seq.begin(), seq.end());
+}
+
+/** @brief Swaps the elements of two stable priority deques.
+// @relates stable_priority_deque
+*/
+template <typename T, typename C>
+inline void swap (stable_priority_deque<T, C> & deque1,
+                  stable_priority_deque<T, C> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
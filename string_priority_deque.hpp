@@ -0,0 +1,294 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file string_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    string_priority_deque.hpp provides the class string_priority_deque, a
+//  priority deque of elements ordered by string keys.
+//    The first few bytes of each key are stored beside the element, encoded
+//  as integers. Most comparisons are resolved by comparing those integers,
+//  without touching the (heap-allocated) characters of either string; the full
+//  keys are compared only when the prefixes are equal.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_STRING_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_STRING_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error string_priority_deque.hpp requires a C++ compiler.
+#endif
+
+#include <string>
+
+#include "priority_deque.hpp"
+//  Grab normalize_prefix.
+#include "normalized_priority_deque.hpp"
+//  Grab the iterator adaptor, which hides the cached prefixes.
+#include "projected_priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//! @brief Key extractor for elements that are themselves strings.
+struct string_identity
+{
+  typedef std::string const & result_type;
+  std::string const & operator() (std::string const & value) const
+  {
+    return value;
+  }
+};
+
+/// \cond false
+namespace string_priority_deque_internal {
+//! @brief Direction in which prefixes are ordered. Only std::less and
+//! std::greater, which order strings by their bytes, are supported.
+template <typename Compare>
+struct prefix_order;
+template <>
+struct prefix_order<std::less<std::string> > { static const bool less = true; };
+template <>
+struct prefix_order<std::greater<std::string> >
+{
+  static const bool less = false;
+};
+
+template <typename Type, typename KeyOf, typename Compare, int words>
+struct prefix_traits
+{
+  struct element_type
+  {
+    uint64_t prefix[words];
+    Type value;
+  };
+  struct element_compare
+  {
+    element_compare (KeyOf const & key, Compare const & comp)
+      : key_of(key), compare(comp) {}
+    bool operator() (element_type const & lhs, element_type const & rhs) const
+    {
+      for (int i = 0; i < words; ++i)
+        if (lhs.prefix[i] != rhs.prefix[i])
+          return prefix_order<Compare>::less ? (lhs.prefix[i] < rhs.prefix[i])
+                                             : (lhs.prefix[i] > rhs.prefix[i]);
+//  Equal prefixes of keys at least as long as the prefix are equal bytes,
+//  which need not be compared again.
+      std::string const & lhs_key = key_of(lhs.value);
+      std::string const & rhs_key = key_of(rhs.value);
+      const std::size_t skip = words * 8;
+      if (lhs_key.size() < skip || rhs_key.size() < skip)
+        return compare(lhs_key, rhs_key);
+      const int order = lhs_key.compare(skip, std::string::npos, rhs_key, skip,
+                                        std::string::npos);
+      return prefix_order<Compare>::less ? (order < 0) : (order > 0);
+    }
+    KeyOf key_of;
+    Compare compare;
+  };
+  static void encode (element_type & element, KeyOf const & key_of)
+  {
+    std::string const & key = key_of(element.value);
+    for (int i = 0; i < words; ++i)
+    {
+      const std::size_t offset = static_cast<std::size_t>(i) * 8;
+      element.prefix[i] = (offset < key.size()) ?
+        normalize_prefix(key.data() + offset, key.size() - offset) : 0;
+    }
+  }
+  static element_type make (Type const & value, KeyOf const & key_of)
+  {
+    element_type result;
+    result.value = value;
+    encode(result, key_of);
+    return result;
+  }
+#if (__cplusplus >= 201103L)
+  static element_type make (Type && value, KeyOf const & key_of)
+  {
+    element_type result;
+    result.value = std::move(value);
+    encode(result, key_of);
+    return result;
+  }
+#endif
+  static Type const & value (element_type const & element)
+  {
+    return element.value;
+  }
+};
+} //  Namespace string_priority_deque_internal
+/// \endcond
+
+//-----------------------String Priority Deque Class---------------------------|
+/*! @brief Double-ended priority queue ordered by string keys, with prefixes
+ *  cached beside the elements.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque. Must be default-
+ *  constructible.
+ *  @param KeyOf Key extractor. %KeyOf(A) returns the std::string by which %A
+ *  is ordered. Defaults to string_identity, for elements that are strings.
+ *  @param Compare Either std::less<std::string> (the default) or
+ *  std::greater<std::string>.
+ *  @param PrefixBytes Number of bytes of each key to cache; a multiple of 8.
+ *  Defaults to 16, which covers common leading text such as "https://".
+ *  @details If many keys share a longer common prefix, most comparisons will
+ *  fall back to comparing full keys, and a larger @a PrefixBytes is advised.
+ *  @see priority_deque, projected_priority_deque
+ */
+template <typename Type = std::string, typename KeyOf = string_identity,
+          typename Compare =::std::less<std::string>, int PrefixBytes = 16>
+class string_priority_deque
+  : private priority_deque<
+      typename string_priority_deque_internal::prefix_traits<Type, KeyOf,
+                                    Compare, PrefixBytes / 8>::element_type,
+      std::vector<typename string_priority_deque_internal::prefix_traits<Type,
+                            KeyOf, Compare, PrefixBytes / 8>::element_type>,
+      typename string_priority_deque_internal::prefix_traits<Type, KeyOf,
+                                    Compare, PrefixBytes / 8>::element_compare>
+{
+  typedef string_priority_deque_internal::prefix_traits<Type, KeyOf, Compare,
+                                                 PrefixBytes / 8>  traits;
+  typedef priority_deque<typename traits::element_type,
+                         std::vector<typename traits::element_type>,
+                         typename traits::element_compare>          base_type;
+  typedef char prefix_is_whole_words[(PrefixBytes > 0 && PrefixBytes % 8 == 0)
+                                     ? 1 : -1];
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Type                                        value_type;
+  typedef KeyOf                                       key_extractor;
+  typedef Compare                                     key_compare;
+  typedef typename base_type::size_type               size_type;
+  typedef Type const &                                const_reference;
+  typedef projected_priority_deque_internal::const_iterator<Type,
+                  typename base_type::const_iterator, traits> const_iterator;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty priority deque.
+  explicit string_priority_deque      (KeyOf const & key =KeyOf(),
+                                       Compare const & comp =Compare())
+    : base_type(typename traits::element_compare(key, comp)), key_of_(key) {}
+/** @brief Constructs a new priority deque from a sequence of elements.
+//  @param first,last Range of elements.
+//  @param key Instance of key extractor.
+//  @param comp Instance of comparison class.
+//  @post Deque contains copies of all elements in [ @a first, @a last).
+//
+//  @par Complexity:
+//    O(n) - Linear on the number of elements.
+//  @par Exception safety:
+//    Strong.
+*/
+  template <typename InputIterator>
+  string_priority_deque               (InputIterator first, InputIterator last,
+                                       KeyOf const & key =KeyOf(),
+                                       Compare const & comp =Compare())
+    : base_type(typename traits::element_compare(key, comp)), key_of_(key)
+  {
+    typename base_type::container_type & seq = base_type::sequence();
+    for (; first != last; ++first)
+      seq.push_back(traits::make(*first, key_of_));
+    heap::make_interval_heap(seq.begin(), seq.end(), base_type::compare());
+  }
+//-----------------------------Restricted Access-------------------------------|
+//! @brief Copies an element into the priority deque.
+//! @see priority_deque::push
+  inline void             push        (value_type const & value)
+  {
+    base_type::push(traits::make(value, key_of_));
+  }
+#if (__cplusplus >= 201103L)
+//!@overload
+  inline void             push        (value_type && value)
+  {
+    base_type::push(traits::make(std::move(value), key_of_));
+  }
+#endif
+//! @brief Accesses a maximal element in the deque.
+  inline const_reference  maximum     (void) const
+  {
+    return traits::value(base_type::maximum());
+  }
+//! @brief Accesses a minimal element in the deque.
+  inline const_reference  minimum     (void) const
+  {
+    return traits::value(base_type::minimum());
+  }
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline const_reference  top         (void) const  { return maximum(); }
+
+  using base_type::pop_maximum;
+  using base_type::pop_minimum;
+  using base_type::pop;
+  using base_type::empty;
+  using base_type::size;
+  using base_type::max_size;
+  using base_type::clear;
+//! @brief Exchanges the elements of two string priority deques.
+  void                    swap        (string_priority_deque & other)
+  {
+    using std::swap;
+    base_type::swap(other);
+    swap(key_of_, other.key_of_);
+  }
+//-------------------------------Random Access---------------------------------|
+//! @brief Returns a const iterator at the beginning of the sequence.
+  inline const_iterator   begin       (void) const
+  {
+    return const_iterator(base_type::begin());
+  }
+//! @brief Returns a const iterator past the end of the sequence.
+  inline const_iterator   end         (void) const
+  {
+    return const_iterator(base_type::end());
+  }
+//! @brief Modifies a specified element of the deque.
+//! @see priority_deque::update
+  inline void             update      (const_iterator random_it,
+                                       value_type const & value)
+  {
+    base_type::update(random_it.base(), traits::make(value, key_of_));
+  }
+//! @brief Removes a specified element from the deque.
+//! @see priority_deque::erase
+  inline void             erase       (const_iterator random_it)
+  {
+    base_type::erase(random_it.base());
+  }
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = false;
+  static const bool is_stable             = false;
+  static const bool has_reserve           = false;
+//---------------------------------Private-------------------------------------|
+ private:
+  KeyOf key_of_;
+};
+
+/** @brief Swaps the elements of two string priority deques.
+// @relates string_priority_deque
+*/
+template <typename T, typename K, typename C, int P>
+inline void swap (string_priority_deque<T, K, C, P> & deque1,
+                  string_priority_deque<T, K, C, P> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -0,0 +1,166 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file event_simulation.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    event_simulation.hpp provides a small discrete-event simulation engine,
+//  built on priority_deque, and the increment distributions of the hold model
+//  (as used by Jones to compare event queues).
+//    Events run in order of time, and events at equal times in the order they
+//  were scheduled. The engine has a horizon, past which events are not run.
+//  Moving the horizon closer culls the events beyond it from the max end of
+//  the deque, without touching the events still to run.
+*/
+
+#ifndef BOOST_CONTAINER_TESTS_EVENT_SIMULATION_HPP_
+#define BOOST_CONTAINER_TESTS_EVENT_SIMULATION_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdint.h>
+
+#include "../priority_deque.hpp"
+
+//-----------------------------Hold Increments---------------------------------|
+//  Uniform doubles in [0, 1), the same on every platform.
+struct hold_random
+{
+  uint64_t state;
+  explicit hold_random (uint64_t seed) : state(seed ? seed : 1) {}
+  double operator() (void)
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+  }
+};
+//  Each distribution has mean 1.
+struct exponential_increment
+{
+  double operator() (hold_random & random) const
+  {
+    return -std::log(1.0 - random());
+  }
+};
+struct uniform_increment
+{
+  double operator() (hold_random & random) const { return 2.0 * random(); }
+};
+//  Mostly very short, sometimes long: 90% from [0, 0.2), 10% from [0, 18.2).
+struct bimodal_increment
+{
+  double operator() (hold_random & random) const
+  {
+    return (random() < 0.9) ? 0.2 * random() : 18.2 * random();
+  }
+};
+//  Triangular on [0, 2), peaking at 1.
+struct triangular_increment
+{
+  double operator() (hold_random & random) const
+  {
+    return random() + random();
+  }
+};
+
+//-----------------------------Simulation Engine-------------------------------|
+template <typename Payload>
+class event_simulation
+{
+ public:
+  typedef double time_type;
+
+  event_simulation (void)
+    : now_(0), horizon_(std::numeric_limits<time_type>::infinity()),
+      sequence_(0), culled_(0) {}
+//  Events beyond the horizon are dropped. Returns false if this one was.
+  bool schedule (time_type at, Payload const & payload)
+  {
+    if (at > horizon_)
+    {
+      ++culled_;
+      return false;
+    }
+    event added = { at, sequence_++, payload };
+    events_.push(added);
+    return true;
+  }
+//  Moves the horizon, culling the pending events beyond it.
+  void set_horizon (time_type horizon)
+  {
+    horizon_ = horizon;
+    beyond_horizon pred = { horizon };
+    events_.pop_maximum_while(pred, culler(&culled_));
+  }
+//  Runs events, in order, until none remain. @a handler is called as
+//  handler(simulation, payload), and may schedule events.
+  template <typename Handler>
+  std::size_t run (Handler handler, std::size_t limit =
+                                      std::numeric_limits<std::size_t>::max())
+  {
+    std::size_t ran = 0;
+    for (; (ran < limit) && !events_.empty(); ++ran)
+    {
+      event next = events_.minimum();
+      events_.pop_minimum();
+      now_ = next.time;
+      handler(*this, next.payload);
+    }
+    return ran;
+  }
+  time_type now (void) const { return now_; }
+  std::size_t pending (void) const { return events_.size(); }
+//  Events dropped, or culled, for lying beyond the horizon.
+  std::size_t culled (void) const { return culled_; }
+
+ private:
+  struct event
+  {
+    time_type time;
+    uint64_t sequence;
+    Payload payload;
+    bool operator< (event const & other) const
+    {
+      return (time < other.time) ||
+             ((time == other.time) && (sequence < other.sequence));
+    }
+  };
+  struct beyond_horizon
+  {
+    time_type horizon;
+    bool operator() (event const & e) const { return e.time > horizon; }
+  };
+//  Output iterator that counts, and discards, culled events.
+  struct culler
+  {
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef void difference_type;
+    typedef void pointer;
+    typedef void reference;
+    std::size_t * count;
+    explicit culler (std::size_t * c) : count(c) {}
+    culler & operator* (void) { return *this; }
+    culler & operator++ (void) { return *this; }
+    culler & operator++ (int) { return *this; }
+    culler & operator= (event const &)
+    {
+      ++*count;
+      return *this;
+    }
+  };
+
+  boost::container::priority_deque<event> events_;
+  time_type now_, horizon_;
+  uint64_t sequence_;
+  std::size_t culled_;
+};
+
+#endif
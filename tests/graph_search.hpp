@@ -0,0 +1,338 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file graph_search.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    graph_search.hpp provides synthetic graphs and shortest-path searches
+//  (Dijkstra's algorithm, or A* with a consistent heuristic), against which
+//  the priority deques are benchmarked.
+//    Three frontiers are compared:
+//  - Lazy deletion: a node is pushed again whenever its distance improves, and
+//    stale entries are skipped when popped.
+//  - Decrease-key: unique_priority_deque holds one entry per node, and a push
+//    improves that entry in place.
+//  - Bounded: as lazy deletion, but the frontier is capped, and the worst
+//    entries are dropped from the far end. The path found may not be optimal.
+*/
+
+#ifndef BOOST_CONTAINER_TESTS_GRAPH_SEARCH_HPP_
+#define BOOST_CONTAINER_TESTS_GRAPH_SEARCH_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <stdint.h>
+#include <vector>
+
+#include "../priority_deque.hpp"
+#include "../unique_priority_deque.hpp"
+
+//---------------------------------Graphs--------------------------------------|
+//  Directed graph in compressed sparse rows, with a position for each node.
+struct search_graph
+{
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> targets;
+  std::vector<uint32_t> weights;
+  std::vector<int32_t> x, y;
+//  Whether the heuristic is the straight-line distance, or the Manhattan one.
+  bool euclidean;
+
+  uint32_t nodes (void) const
+  {
+    return static_cast<uint32_t>(offsets.size() - 1);
+  }
+//  A lower bound on the cost from node @a from to node @a to.
+  uint64_t heuristic (uint32_t from, uint32_t to) const
+  {
+    const int64_t dx = x[from] - x[to], dy = y[from] - y[to];
+    if (euclidean)
+      return static_cast<uint64_t>(std::sqrt(static_cast<double>(dx * dx +
+                                                                 dy * dy)));
+    return static_cast<uint64_t>((dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy));
+  }
+};
+
+//  Small generator, so that graphs are the same on every platform.
+struct search_random
+{
+  uint32_t state;
+  explicit search_random (uint32_t seed) : state(seed ? seed : 1) {}
+  uint32_t operator() (uint32_t bound)
+  {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % bound;
+  }
+};
+
+//  Builds the rows of a graph from a list of (source, target, weight) edges.
+struct search_edge
+{
+  uint32_t source, target, weight;
+  bool operator< (search_edge const & other) const
+  {
+    return source < other.source;
+  }
+};
+inline void build_rows (search_graph & g, std::vector<search_edge> & edges,
+                        uint32_t nodes)
+{
+  std::sort(edges.begin(), edges.end());
+  g.offsets.assign(nodes + 1, 0);
+  g.targets.resize(edges.size());
+  g.weights.resize(edges.size());
+  for (std::size_t i = 0; i < edges.size(); ++i)
+  {
+    ++g.offsets[edges[i].source + 1];
+    g.targets[i] = edges[i].target;
+    g.weights[i] = edges[i].weight;
+  }
+  for (uint32_t i = 0; i < nodes; ++i)
+    g.offsets[i + 1] += g.offsets[i];
+}
+
+/*  A 4-connected grid map. A fraction of the cells are walls, and each open
+//  cell costs between 1 and 9 to enter. The Manhattan distance is a consistent
+//  heuristic.
+*/
+inline search_graph make_grid_graph (uint32_t width, uint32_t height,
+                                     unsigned wall_percent, uint32_t seed)
+{
+  search_random random (seed);
+  std::vector<uint32_t> cost (width * height);
+  for (std::size_t i = 0; i < cost.size(); ++i)
+    cost[i] = (random(100) < wall_percent) ? 0 : (1 + random(9));
+  search_graph g;
+  g.euclidean = false;
+  std::vector<search_edge> edges;
+  for (uint32_t row = 0; row < height; ++row)
+    for (uint32_t col = 0; col < width; ++col)
+    {
+      const uint32_t node = row * width + col;
+      g.x.push_back(static_cast<int32_t>(col));
+      g.y.push_back(static_cast<int32_t>(row));
+      if (!cost[node])
+        continue;
+      const uint32_t neighbors[4] = { node - 1, node + 1, node - width,
+                                      node + width };
+      const bool present[4] = { col > 0, col + 1 < width, row > 0,
+                                row + 1 < height };
+      for (int i = 0; i < 4; ++i)
+        if (present[i] && cost[neighbors[i]])
+        {
+          search_edge edge = { node, neighbors[i], cost[neighbors[i]] };
+          edges.push_back(edge);
+        }
+    }
+  build_rows(g, edges, width * height);
+  return g;
+}
+
+/*  A road-network-like graph: a jittered lattice of junctions, with some
+//  streets missing, some diagonal streets, and some fast highways. Each street
+//  costs at least its straight-line length, so the Euclidean distance is a
+//  consistent heuristic.
+*/
+inline search_graph make_road_graph (uint32_t side, uint32_t seed)
+{
+  static const int32_t kSpacing = 100;
+  search_random random (seed);
+  search_graph g;
+  g.euclidean = true;
+  for (uint32_t row = 0; row < side; ++row)
+    for (uint32_t col = 0; col < side; ++col)
+    {
+      g.x.push_back(static_cast<int32_t>(col) * kSpacing +
+                    static_cast<int32_t>(random(kSpacing / 2)));
+      g.y.push_back(static_cast<int32_t>(row) * kSpacing +
+                    static_cast<int32_t>(random(kSpacing / 2)));
+    }
+  std::vector<search_edge> edges;
+  for (uint32_t row = 0; row < side; ++row)
+    for (uint32_t col = 0; col < side; ++col)
+    {
+      const uint32_t node = row * side + col;
+      uint32_t ends[3];
+      int count = 0;
+      if ((col + 1 < side) && (random(10) != 0))
+        ends[count++] = node + 1;
+      if ((row + 1 < side) && (random(10) != 0))
+        ends[count++] = node + side;
+      if ((col + 1 < side) && (row + 1 < side) && (random(5) == 0))
+        ends[count++] = node + side + 1;
+//  Every sixteenth row and column is a highway, with no detour.
+      const bool highway = (row % 16 == 0) || (col % 16 == 0);
+      for (int i = 0; i < count; ++i)
+      {
+        const double dx = g.x[node] - g.x[ends[i]];
+        const double dy = g.y[node] - g.y[ends[i]];
+        const double length = std::sqrt(dx * dx + dy * dy);
+        const uint32_t weight = static_cast<uint32_t>(std::ceil(length *
+          (highway ? 1.0 : (1.2 + random(100) / 100.0))));
+        search_edge forward = { node, ends[i], weight };
+        search_edge backward = { ends[i], node, weight };
+        edges.push_back(forward);
+        edges.push_back(backward);
+      }
+    }
+  build_rows(g, edges, side * side);
+  return g;
+}
+
+//---------------------------------Searches------------------------------------|
+//  Frontier entry. Ordered by estimated total cost, then by node.
+struct search_entry
+{
+  uint64_t estimate;
+  uint32_t node;
+  bool operator< (search_entry const & other) const
+  {
+    return (estimate < other.estimate) ||
+           ((estimate == other.estimate) && (node < other.node));
+  }
+  bool operator> (search_entry const & other) const { return other < *this; }
+};
+struct search_node_of
+{
+  uint32_t operator() (search_entry const & entry) const { return entry.node; }
+};
+
+struct search_result
+{
+  uint64_t cost;            //  Cost of the path found, or kUnreachable.
+  std::size_t settled;      //  Nodes removed from the frontier and expanded.
+  std::size_t peak;         //  Largest number of entries in the frontier.
+};
+static const uint64_t kUnreachable = ~uint64_t(0);
+
+//  The best entry of each kind of frontier.
+template <typename T, typename S, typename C>
+inline T const & frontier_best (std::priority_queue<T, S, C> const & q)
+{
+  return q.top();
+}
+template <typename T, typename S, typename C>
+inline void frontier_pop_best (std::priority_queue<T, S, C> & q)
+{
+  q.pop();
+}
+template <typename T, typename S, typename C>
+inline T const & frontier_best (boost::container::priority_deque<T, S, C>
+                                  const & q)
+{
+  return q.minimum();
+}
+template <typename T, typename S, typename C>
+inline void frontier_pop_best (boost::container::priority_deque<T, S, C> & q)
+{
+  q.pop_minimum();
+}
+//  Drops the worst entries. Only a double-ended queue can do so cheaply.
+template <typename T, typename S, typename C>
+inline void prune_frontier (std::priority_queue<T, S, C> &, std::size_t) {}
+template <typename T, typename S, typename C>
+inline void prune_frontier (boost::container::priority_deque<T, S, C> & q,
+                            std::size_t cap)
+{
+  while (q.size() > cap)
+    q.pop_maximum();
+}
+
+/*  Searches from @a source to @a target. Without @a astar, the heuristic is 0
+//  (Dijkstra's algorithm). @a Queue is a min-queue of search_entry with lazy
+//  deletion. If @a cap is nonzero, @a Queue must be a priority_deque, and the
+//  worst entries beyond @a cap are dropped.
+*/
+template <typename Queue>
+search_result search_lazy (search_graph const & g, uint32_t source,
+                           uint32_t target, bool astar, std::size_t cap = 0)
+{
+  std::vector<uint64_t> distance (g.nodes(), kUnreachable);
+  std::vector<char> closed (g.nodes(), 0);
+  search_result result = { kUnreachable, 0, 0 };
+  Queue frontier;
+  distance[source] = 0;
+  search_entry start = { astar ? g.heuristic(source, target) : 0, source };
+  frontier.push(start);
+  while (!frontier.empty())
+  {
+    const uint32_t node = frontier_best(frontier).node;
+    frontier_pop_best(frontier);
+    if (closed[node])
+      continue;
+    closed[node] = 1;
+    ++result.settled;
+    if (node == target)
+    {
+      result.cost = distance[node];
+      break;
+    }
+    for (uint32_t e = g.offsets[node]; e < g.offsets[node + 1]; ++e)
+    {
+      const uint32_t next = g.targets[e];
+      const uint64_t through = distance[node] + g.weights[e];
+      if (through >= distance[next])
+        continue;
+      distance[next] = through;
+      search_entry entry = { through + (astar ? g.heuristic(next, target) : 0),
+                             next };
+      frontier.push(entry);
+      if (cap)
+        prune_frontier(frontier, cap);
+      result.peak = std::max<std::size_t>(result.peak, frontier.size());
+    }
+  }
+  return result;
+}
+
+//  As search_lazy, but with one frontier entry per node, improved in place.
+inline search_result search_decrease_key (search_graph const & g,
+                                          uint32_t source, uint32_t target,
+                                          bool astar)
+{
+//  push keeps the entry ordered later, so later must mean a cheaper estimate.
+  typedef boost::container::unique_priority_deque<search_entry,
+            search_node_of, std::greater<search_entry> > queue_t;
+  std::vector<uint64_t> distance (g.nodes(), kUnreachable);
+  std::vector<char> closed (g.nodes(), 0);
+  search_result result = { kUnreachable, 0, 0 };
+  queue_t frontier;
+  distance[source] = 0;
+  search_entry start = { astar ? g.heuristic(source, target) : 0, source };
+  frontier.push(start);
+  while (!frontier.empty())
+  {
+    const uint32_t node = frontier.maximum().node;
+    frontier.pop_maximum();
+    closed[node] = 1;
+    ++result.settled;
+    if (node == target)
+    {
+      result.cost = distance[node];
+      break;
+    }
+    for (uint32_t e = g.offsets[node]; e < g.offsets[node + 1]; ++e)
+    {
+      const uint32_t next = g.targets[e];
+      const uint64_t through = distance[node] + g.weights[e];
+      if (closed[next] || (through >= distance[next]))
+        continue;
+      distance[next] = through;
+      search_entry entry = { through + (astar ? g.heuristic(next, target) : 0),
+                             next };
+      frontier.push(entry);
+      result.peak = std::max<std::size_t>(result.peak, frontier.size());
+    }
+  }
+  return result;
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include "../async_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( async_priority_deque_merge )
+{
+  using namespace boost::container;
+  async_priority_deque<int> pd;
+  std::multiset<int> expected;
+  for (int i = 0; i < 1000; ++i)
+  {
+    int pushed = rand() % 100000;
+    pd.push(pushed);
+    expected.insert(pushed);
+  }
+  std::vector<int> batch;
+  for (int i = 0; i < 200000; ++i)
+  {
+    batch.push_back(rand() % 100000);
+    expected.insert(batch.back());
+  }
+  pd.merge_async(batch.begin(), batch.end());
+  BOOST_TEST_REQUIRE(pd.size() == expected.size());
+//  The staged batch's extremes are visible at once.
+  BOOST_TEST_REQUIRE(pd.minimum() == *expected.begin());
+  BOOST_TEST_REQUIRE(pd.maximum() == *expected.rbegin());
+
+  for (int i = 0; !expected.empty(); ++i)
+  {
+    if (i % 3 == 0)
+    {
+      int pushed = rand() % 100000;
+      pd.push(pushed);
+      expected.insert(pushed);
+    }
+    BOOST_TEST_REQUIRE(pd.minimum() == *expected.begin());
+    BOOST_TEST_REQUIRE(pd.maximum() == *expected.rbegin());
+    if (i % 2 == 0)
+    {
+      pd.pop_minimum();
+      expected.erase(expected.begin());
+    } else {
+      pd.pop();
+      expected.erase(--expected.end());
+    }
+    BOOST_TEST_REQUIRE(pd.size() == expected.size());
+  }
+  BOOST_TEST_REQUIRE(pd.empty());
+  BOOST_TEST_REQUIRE(!pd.merging());
+}
+
+BOOST_AUTO_TEST_CASE( async_priority_deque_wait )
+{
+  using namespace boost::container;
+  async_priority_deque<int, std::vector<int>, std::greater<int> > pd;
+  std::vector<int> batch;
+  for (int i = 0; i < 100000; ++i)
+    batch.push_back(i);
+  pd.merge_async(std::vector<int>(batch));
+//  A second batch waits for the first.
+  pd.merge_async(batch.begin(), batch.begin() + 10);
+  pd.wait();
+  BOOST_TEST_REQUIRE(!pd.merging());
+  BOOST_TEST_REQUIRE(pd.size() == 100010u);
+  BOOST_TEST_REQUIRE(pd.minimum() == 99999);
+  BOOST_TEST_REQUIRE(pd.maximum() == 0);
+  pd.pop_maximum();
+  pd.pop_maximum();
+  BOOST_TEST_REQUIRE(pd.maximum() == 1);
+
+//  A finished batch is no longer merging, though it is not yet folded in.
+  pd.merge_async(batch.begin(), batch.begin() + 10);
+  while (pd.merging())
+    std::this_thread::yield();
+  BOOST_TEST_REQUIRE(pd.size() == 100018u);
+  BOOST_TEST_REQUIRE(pd.maximum() == 0);
+
+//  Clearing, or destroying, a deque waits for its worker.
+  pd.merge_async(batch.begin(), batch.end());
+  pd.clear();
+  BOOST_TEST_REQUIRE(pd.empty());
+  pd.merge_async(batch.begin(), batch.end());
+}
@@ -0,0 +1,191 @@
+#include <boost/test/unit_test.hpp>
+
+//  Built as C++20, by a test target of its own.
+#if (__cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+#include "../awaitable_priority_deque.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace {
+//  Starts at once; the frame lives until the task is destroyed.
+struct task
+{
+  struct promise_type
+  {
+    task get_return_object (void)
+    {
+      return task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_never initial_suspend (void) noexcept { return {}; }
+    std::suspend_always final_suspend (void) noexcept { return {}; }
+    void return_void (void) {}
+    void unhandled_exception (void) { std::terminate(); }
+  };
+  explicit task (std::coroutine_handle<promise_type> h) : handle(h) {}
+  task (task && other) noexcept : handle(other.handle) { other.handle = {}; }
+  ~task (void)
+  {
+    if (handle)
+      handle.destroy();
+  }
+  bool done (void) const { return handle.done(); }
+  std::coroutine_handle<promise_type> handle;
+};
+
+typedef boost::container::awaitable_priority_deque<int> deque_t;
+
+task take_maximum (deque_t & deque, std::vector<int> & out)
+{
+  out.push_back(co_await deque.pop_maximum());
+}
+task take_minimum (deque_t & deque, std::vector<int> & out)
+{
+  out.push_back(co_await deque.pop_minimum());
+}
+task take_until (deque_t & deque, deque_t::time_point deadline,
+                 std::optional<int> & out)
+{
+  out = co_await deque.pop_maximum(deadline);
+}
+task take_unless (deque_t & deque, std::stop_token stop,
+                  std::optional<int> & out)
+{
+  out = co_await deque.pop_minimum(stop);
+}
+task take_many (deque_t & deque, int count, std::atomic<long> & sum)
+{
+  for (int i = 0; i < count; ++i)
+    sum += co_await deque.pop_maximum();
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( awaitable_priority_deque_handoff )
+{
+  deque_t deque;
+  std::vector<int> out;
+  deque.push(3);
+  deque.push(1);
+  deque.push(2);
+//  Elements already present are taken without suspending.
+  {
+    task a = take_maximum(deque, out), b = take_minimum(deque, out);
+    BOOST_TEST_REQUIRE(a.done());
+    BOOST_TEST_REQUIRE(b.done());
+  }
+  BOOST_TEST_REQUIRE((out == std::vector<int>{ 3, 1 }));
+  int value;
+  BOOST_TEST_REQUIRE(deque.try_pop_maximum(value));
+  BOOST_TEST_REQUIRE(!deque.try_pop_minimum(value));
+//  Waiters are served in order, each element handed over directly.
+  out.clear();
+  task a = take_maximum(deque, out), b = take_minimum(deque, out),
+       c = take_maximum(deque, out);
+  BOOST_TEST_REQUIRE(deque.waiting() == 3u);
+  deque.push(10);
+  BOOST_TEST_REQUIRE(a.done());
+  BOOST_TEST_REQUIRE(!b.done());
+  deque.push(20);
+  deque.push(30);
+  BOOST_TEST_REQUIRE(c.done());
+  BOOST_TEST_REQUIRE((out == std::vector<int>{ 10, 20, 30 }));
+  BOOST_TEST_REQUIRE(deque.handoffs() == 3u);
+  BOOST_TEST_REQUIRE(deque.empty());
+  BOOST_TEST_REQUIRE(deque.waiting() == 0u);
+  deque.push(40);
+  BOOST_TEST_REQUIRE(deque.size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE( awaitable_priority_deque_cancel )
+{
+  deque_t deque;
+  std::optional<int> out (0);
+  std::stop_source source;
+  task a = take_unless(deque, source.get_token(), out);
+  BOOST_TEST_REQUIRE(!a.done());
+  source.request_stop();
+  BOOST_TEST_REQUIRE(a.done());
+  BOOST_TEST_REQUIRE(!out);
+  BOOST_TEST_REQUIRE(deque.waiting() == 0u);
+//  Already stopped: no wait, unless an element is present.
+  out = 0;
+  task b = take_unless(deque, source.get_token(), out);
+  BOOST_TEST_REQUIRE(b.done());
+  BOOST_TEST_REQUIRE(!out);
+  deque.push(5);
+  task c = take_unless(deque, source.get_token(), out);
+  BOOST_TEST_REQUIRE((out == 5));
+//  A destroyed waiter is forgotten.
+  std::vector<int> taken;
+  {
+    task d = take_maximum(deque, taken);
+    BOOST_TEST_REQUIRE(deque.waiting() == 1u);
+  }
+  BOOST_TEST_REQUIRE(deque.waiting() == 0u);
+  deque.push(6);
+  BOOST_TEST_REQUIRE(deque.size() == 1u);
+  BOOST_TEST_REQUIRE(taken.empty());
+}
+
+BOOST_AUTO_TEST_CASE( awaitable_priority_deque_timeout )
+{
+  deque_t deque;
+  const deque_t::time_point now = deque_t::clock_type::now();
+  std::optional<int> early (0), late (0), served (0);
+  task a = take_until(deque, now - std::chrono::seconds(1), early);
+  BOOST_TEST_REQUIRE(a.done());
+  BOOST_TEST_REQUIRE(!early);
+  task b = take_until(deque, now + std::chrono::seconds(10), late);
+  task c = take_until(deque, now + std::chrono::seconds(20), served);
+  deque_t::time_point next;
+  BOOST_TEST_REQUIRE(deque.next_deadline(next));
+  BOOST_TEST_REQUIRE((next == now + std::chrono::seconds(10)));
+  BOOST_TEST_REQUIRE(deque.expire_until(now + std::chrono::seconds(5)) == 0u);
+  BOOST_TEST_REQUIRE(deque.expire_until(now + std::chrono::seconds(10)) == 1u);
+  BOOST_TEST_REQUIRE(b.done());
+  BOOST_TEST_REQUIRE(!late);
+//  A waiter that is served no longer has a deadline.
+  deque.push(7);
+  BOOST_TEST_REQUIRE(c.done());
+  BOOST_TEST_REQUIRE((served == 7));
+  BOOST_TEST_REQUIRE(!deque.next_deadline(next));
+//  The duration overloads measure from now.
+  std::optional<int> waited (0);
+  task d = [](deque_t & q, std::optional<int> & out) -> task {
+    out = co_await q.pop_minimum(std::chrono::milliseconds(1));
+  }(deque, waited);
+  BOOST_TEST_REQUIRE(!d.done());
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  deque.expire_until(deque_t::clock_type::now());
+  BOOST_TEST_REQUIRE(d.done());
+  BOOST_TEST_REQUIRE(!waited);
+}
+
+//  Consumers are resumed on the producers' threads.
+BOOST_AUTO_TEST_CASE( awaitable_priority_deque_threads )
+{
+  deque_t deque;
+  std::atomic<long> sum (0);
+  std::vector<task> consumers;
+  for (int i = 0; i < 8; ++i)
+    consumers.push_back(take_many(deque, 1000, sum));
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 4; ++p)
+    producers.push_back(std::thread([&deque, p]() {
+      for (int i = 0; i < 2000; ++i)
+        deque.push(p * 2000 + i);
+    }));
+  for (std::size_t p = 0; p < producers.size(); ++p)
+    producers[p].join();
+  for (std::size_t i = 0; i < consumers.size(); ++i)
+    BOOST_TEST_REQUIRE(consumers[i].done());
+  BOOST_TEST_REQUIRE(sum == 8000L * 7999 / 2);
+  BOOST_TEST_REQUIRE(deque.empty());
+}
+#endif
@@ -0,0 +1,79 @@
+#include "../batched_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( batched_priority_deque_thresholds )
+{
+  using namespace boost::container;
+  batched_priority_deque<int> shared (10, std::chrono::hours(1));
+  batched_priority_deque<int>::producer producer (shared);
+  for (int i = 0; i < 9; ++i)
+    producer.push(i);
+//  Nothing is published until the batch is full.
+  BOOST_TEST_REQUIRE(shared.empty());
+  producer.push(9);
+  BOOST_TEST_REQUIRE(shared.size() == 10u);
+  BOOST_TEST_REQUIRE(shared.batches() == 1u);
+  producer.push(100);
+  producer.push(-100);
+  shared.flush();
+  BOOST_TEST_REQUIRE(shared.size() == 12u);
+  int value = 0;
+  BOOST_TEST_REQUIRE(shared.try_pop_maximum(value));
+  BOOST_TEST_REQUIRE(value == 100);
+  BOOST_TEST_REQUIRE(shared.try_pop_minimum(value));
+  BOOST_TEST_REQUIRE(value == -100);
+  std::vector<int> rest;
+  shared.pop_maximum_n(100, std::back_inserter(rest));
+  BOOST_TEST_REQUIRE(rest.size() == 10u);
+  BOOST_TEST_REQUIRE(!shared.try_pop_maximum(value));
+
+//  A batch whose oldest element is old enough is published by the next push.
+  batched_priority_deque<int> aged (1000, std::chrono::milliseconds(1));
+  {
+    batched_priority_deque<int>::producer slow (aged);
+    slow.push(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    slow.push(2);
+    BOOST_TEST_REQUIRE(aged.size() == 2u);
+    slow.push(3);
+    BOOST_TEST_REQUIRE(aged.size() == 2u);
+  }
+//  A destroyed producer publishes what remains.
+  BOOST_TEST_REQUIRE(aged.size() == 3u);
+}
+
+BOOST_AUTO_TEST_CASE( batched_priority_deque_threads )
+{
+  using namespace boost::container;
+  batched_priority_deque<int> shared (32);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t)
+    threads.push_back(std::thread([&shared, t]() {
+      batched_priority_deque<int>::producer producer (shared);
+      for (int i = 0; i < 1000; ++i)
+        producer.push(t * 1000 + i);
+    }));
+  std::multiset<int> seen;
+  int value;
+  while (seen.size() < 4000u)
+  {
+    shared.flush();
+    if (shared.try_pop_minimum(value))
+      seen.insert(value);
+  }
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  while (shared.try_pop_minimum(value))
+    seen.insert(value);
+  BOOST_TEST_REQUIRE(seen.size() == 8000u);
+  BOOST_TEST_REQUIRE(*seen.begin() == 0);
+  BOOST_TEST_REQUIRE(*seen.rbegin() == 7999);
+  BOOST_TEST_REQUIRE(shared.batches() < 8000u);
+}
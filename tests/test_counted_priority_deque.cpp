@@ -0,0 +1,71 @@
+#include "../counted_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <set>
+
+BOOST_AUTO_TEST_CASE( counted_priority_deque_counts )
+{
+  using namespace boost::container;
+  counted_priority_deque<int> pd;
+  std::multiset<int> expected;
+  for (int i = 0; i < 5000; ++i)
+  {
+    int pushed = rand() % 37;
+    pd.push(pushed);
+    expected.insert(pushed);
+  }
+  pd.push(100, 3);
+  expected.insert(100);
+  expected.insert(100);
+  expected.insert(100);
+  pd.push(101, 0);
+  BOOST_TEST_REQUIRE(pd.size() == expected.size());
+  BOOST_TEST_REQUIRE(pd.distinct() <= 38u);
+  BOOST_TEST_REQUIRE(pd.count(100) == 3u);
+  BOOST_TEST_REQUIRE(pd.count(101) == 0u);
+  BOOST_TEST_REQUIRE(pd.count(5) == expected.count(5));
+
+  BOOST_TEST_REQUIRE(pd.erase(7) == expected.count(7));
+  expected.erase(7);
+  BOOST_TEST_REQUIRE(pd.size() == expected.size());
+
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() == *expected.begin());
+    expected.erase(expected.begin());
+    pd.pop_minimum();
+    if (pd.empty())
+      break;
+    BOOST_TEST_REQUIRE(pd.top() == *expected.rbegin());
+    expected.erase(--expected.end());
+    pd.pop();
+    BOOST_TEST_REQUIRE(pd.size() == expected.size());
+  }
+  BOOST_TEST_REQUIRE(expected.empty());
+  BOOST_TEST_REQUIRE(pd.distinct() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE( counted_priority_deque_greater )
+{
+  using namespace boost::container;
+  counted_priority_deque<int, std::greater<int> > pd;
+  for (int i = 0; i < 100; ++i)
+    pd.push(i % 10);
+  BOOST_TEST_REQUIRE(pd.minimum() == 9);
+  BOOST_TEST_REQUIRE(pd.maximum() == 0);
+  for (int i = 0; i < 10; ++i)
+    pd.pop_minimum();
+  BOOST_TEST_REQUIRE(pd.minimum() == 8);
+  BOOST_TEST_REQUIRE(pd.distinct() == 9u);
+
+  counted_priority_deque<int, std::greater<int> > other;
+  other.push(42);
+  swap(pd, other);
+  BOOST_TEST_REQUIRE(pd.size() == 1u);
+  BOOST_TEST_REQUIRE(other.size() == 90u);
+  other.clear();
+  BOOST_TEST_REQUIRE(other.empty());
+}
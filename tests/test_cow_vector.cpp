@@ -0,0 +1,212 @@
+#include "../cow_vector.hpp"
+#include "../priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( cow_vector_sequence )
+{
+  using namespace boost::container;
+  cow_vector<int, 8> cow;
+  std::vector<int> model;
+  BOOST_TEST_REQUIRE(cow.empty());
+  for (int i = 0; i < 1000; ++i)
+  {
+    const int op = std::rand() % 4, value = std::rand() % 100;
+    if ((op == 0) && !model.empty())
+    {
+      cow.pop_back();
+      model.pop_back();
+    } else if (op == 1) {
+      const std::size_t at = model.empty() ? 0 : std::rand() % model.size();
+      const int values[3] = { value, value + 1, value + 2 };
+      cow.insert(cow.begin() + at, values, values + 3);
+      model.insert(model.begin() + at, values, values + 3);
+    } else if ((op == 2) && (model.size() > 2)) {
+      const std::size_t at = std::rand() % (model.size() - 2);
+      cow.erase(cow.begin() + at, cow.begin() + at + 2);
+      model.erase(model.begin() + at, model.begin() + at + 2);
+    } else {
+      cow.push_back(value);
+      model.push_back(value);
+    }
+    BOOST_TEST_REQUIRE(cow.size() == model.size());
+  }
+  BOOST_TEST_REQUIRE(std::equal(model.begin(), model.end(), cow.begin()));
+  std::sort(cow.begin(), cow.end());
+  std::sort(model.begin(), model.end());
+  BOOST_TEST_REQUIRE(std::equal(model.begin(), model.end(), cow.begin()));
+  BOOST_TEST_REQUIRE(cow.front() == model.front());
+  BOOST_TEST_REQUIRE(cow.back() == model.back());
+  cow.clear();
+  BOOST_TEST_REQUIRE(cow.empty());
+
+//  Elements that own memory are copied and destroyed properly.
+  cow_vector<std::string, 4> strings;
+  for (int i = 0; i < 10; ++i)
+    strings.push_back(std::string(50, static_cast<char>('a' + i)));
+  cow_vector<std::string, 4> other (strings);
+  other.back() = "changed";
+  other.pop_back();
+  BOOST_TEST_REQUIRE(strings.back() == std::string(50, 'j'));
+  BOOST_TEST_REQUIRE(other.size() == 9u);
+}
+
+BOOST_AUTO_TEST_CASE( cow_vector_sharing )
+{
+  using namespace boost::container;
+  std::vector<int> values (64 * 16);
+  std::iota(values.begin(), values.end(), 0);
+  cow_vector<int, 64> original (values.begin(), values.end());
+  BOOST_TEST_REQUIRE(!original.shared());
+  cow_vector<int, 64> copy (original);
+  BOOST_TEST_REQUIRE(original.shared());
+  BOOST_TEST_REQUIRE(copy.shared());
+//  Only the chunks written are copied.
+  original[5] = -1;
+  original[6] = -2;
+  original[64 * 10] = -3;
+  BOOST_TEST_REQUIRE(original.copies() == 2u);
+  BOOST_TEST_REQUIRE(std::equal(values.begin(), values.end(), copy.begin()));
+//  Reading, through const iterators, copies nothing.
+  cow_vector<int, 64> const & reader = original;
+  BOOST_TEST_REQUIRE(std::accumulate(reader.begin(), reader.end(), 0L) ==
+                     std::accumulate(values.begin(), values.end(), 0L) -
+                     5 - 6 - 640 - 6);
+  BOOST_TEST_REQUIRE(original.copies() == 2u);
+//  Once the copy is gone, nothing is shared.
+  copy.clear();
+  BOOST_TEST_REQUIRE(!original.shared());
+  original[7] = -4;
+  BOOST_TEST_REQUIRE(original.copies() == 2u);
+}
+
+BOOST_AUTO_TEST_CASE( priority_deque_snapshot )
+{
+  using namespace boost::container;
+  typedef priority_deque<int, cow_vector<int, 256> > deque_t;
+  deque_t deque;
+  for (int i = 0; i < 100000; ++i)
+    deque.push(std::rand());
+  const deque_t view = deque.snapshot();
+  std::vector<int> before (view.begin(), view.end());
+  const int maximum = view.maximum(), minimum = view.minimum();
+  for (int i = 0; i < 100; ++i)
+  {
+    deque.pop_maximum();
+    deque.push(std::rand() / 2);
+  }
+  BOOST_TEST_REQUIRE(view.size() == 100000u);
+  BOOST_TEST_REQUIRE(view.maximum() == maximum);
+  BOOST_TEST_REQUIRE(view.minimum() == minimum);
+  BOOST_TEST_REQUIRE(std::equal(before.begin(), before.end(), view.begin()));
+  BOOST_TEST_REQUIRE(deque.size() == 100000u);
+
+//  An exporter scans snapshots while the writer keeps going.
+  long expected = 0;
+  std::vector<std::thread> readers;
+  std::vector<long> sums;
+  sums.reserve(4);
+  for (int round = 0; round < 4; ++round)
+  {
+    deque_t scanned = deque.snapshot();
+    expected = 0;
+    for (deque_t::const_iterator it = deque.begin(); it != deque.end(); ++it)
+      expected += *it;
+    sums.push_back(expected);
+    readers.push_back(std::thread([scanned, &sums, round]() {
+      long sum = 0;
+      for (deque_t::const_iterator it = scanned.begin(); it != scanned.end();
+           ++it)
+        sum += *it;
+      sums[round] -= sum;
+    }));
+    for (int i = 0; i < 10000; ++i)
+    {
+      deque.pop_minimum();
+      deque.push(std::rand());
+    }
+  }
+  for (std::size_t r = 0; r < readers.size(); ++r)
+    readers[r].join();
+  for (std::size_t r = 0; r < sums.size(); ++r)
+    BOOST_TEST_REQUIRE(sums[r] == 0);
+}
+
+namespace {
+struct add_one
+{
+  int operator() (int x) const { return x + 1; }
+};
+} //  Namespace
+
+//  Threaded operations copy chunks from several threads at once.
+BOOST_AUTO_TEST_CASE( priority_deque_snapshot_threads )
+{
+  using namespace boost::container;
+  typedef priority_deque<int, cow_vector<int, 16> > deque_t;
+  deque_t deque;
+  for (int i = 0; i < 10000; ++i)
+    deque.push(std::rand() / 2);
+  const deque_t view = deque.snapshot();
+  deque.transform_monotone(add_one(), 4);
+  deque_t::const_iterator it = deque.begin();
+  for (deque_t::const_iterator v = view.begin(); v != view.end(); ++v, ++it)
+    BOOST_TEST_REQUIRE(*it == *v + 1);
+}
+
+namespace {
+//  Once @a count calls have been made, holds one call until @a dropped is set.
+struct add_one_pausing
+{
+  std::atomic<int> * calls;
+  std::atomic<bool> * dropped;
+  int count;
+  int operator() (int x) const
+  {
+    if (calls->fetch_add(1) == count)
+      while (!dropped->load())
+        std::this_thread::yield();
+    return x + 1;
+  }
+};
+} //  Namespace
+
+//  A reader lets go of its snapshot while chunks are being copied.
+BOOST_AUTO_TEST_CASE( priority_deque_snapshot_dropped_during_transform )
+{
+  using namespace boost::container;
+  typedef priority_deque<int, cow_vector<int, 16> > deque_t;
+  deque_t deque;
+  for (int i = 0; i < 20000; ++i)
+    deque.push(std::rand() / 2);
+  for (int round = 0; round < 20; ++round)
+  {
+    const std::vector<int> before (deque.begin(), deque.end());
+    std::unique_ptr<deque_t> view (new deque_t(deque.snapshot()));
+    std::atomic<int> calls (0);
+    std::atomic<bool> dropped (false);
+    const int count = std::rand() % 20000;
+    std::thread reader ([&]() {
+      while (calls.load() < count)
+        std::this_thread::yield();
+      view.reset();
+      dropped.store(true);
+    });
+    add_one_pausing f = { &calls, &dropped, count };
+    deque.transform_monotone(f, 4);
+    reader.join();
+    BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(deque.begin(), deque.end(), std::less<int>()));
+    std::vector<int>::const_iterator b = before.begin();
+    for (deque_t::const_iterator it = deque.begin(); it != deque.end(); ++it, ++b)
+      BOOST_TEST_REQUIRE(*it == *b + 1);
+  }
+}
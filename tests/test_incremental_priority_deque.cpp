@@ -0,0 +1,170 @@
+#include "../incremental_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace {
+template <typename Deque>
+void check_extremes (Deque const & pd)
+{
+  BOOST_TEST_REQUIRE(pd.minimum() == *std::min_element(pd.begin(), pd.end()));
+  BOOST_TEST_REQUIRE(pd.maximum() == *std::max_element(pd.begin(), pd.end()));
+}
+}
+
+BOOST_AUTO_TEST_CASE( incremental_priority_deque_steps )
+{
+  using namespace boost::container;
+  for (int old_size = 0; old_size < 7; ++old_size)
+  {
+    for (int added = 0; added < 40; ++added)
+    {
+      incremental_priority_deque<int> pd;
+      for (int i = 0; i < old_size; ++i)
+        pd.push(rand() % 100);
+      std::vector<int> batch;
+      for (int i = 0; i < added; ++i)
+        batch.push_back(rand() % 100);
+      pd.insert(batch.begin(), batch.end());
+      BOOST_TEST_REQUIRE(pd.size() == std::size_t(old_size + added));
+      if (pd.empty())
+        continue;
+      check_extremes(pd);
+      while (pd.step(1))
+        check_extremes(pd);
+      check_extremes(pd);
+      BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(),
+                                                       std::less<int>()));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( incremental_priority_deque_piggyback )
+{
+  using namespace boost::container;
+  std::vector<int> batch;
+  for (int i = 0; i < 20000; ++i)
+    batch.push_back(rand());
+  incremental_priority_deque<int> pd (batch.begin(), batch.end());
+  pd.set_piggyback(3);
+  BOOST_TEST_REQUIRE(pd.building());
+//  Pushes during the build join the unarranged tail.
+  for (int i = 0; pd.building(); ++i)
+  {
+    pd.push((i % 3 == 0) ? -i : rand());
+    check_extremes(pd);
+  }
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(),
+                                                   std::less<int>()));
+
+//  A second insertion, into a deque that is already an interval heap.
+  pd.insert(batch.begin(), batch.begin() + 5001);
+  pd.step(1000);
+  check_extremes(pd);
+  std::vector<int> expected (pd.begin(), pd.end());
+  std::sort(expected.begin(), expected.end());
+//  Removals continue the build, rather than finish it.
+  pd.pop_minimum();
+  BOOST_TEST_REQUIRE(pd.building());
+  BOOST_TEST_REQUIRE(pd.minimum() == expected[1]);
+  pd.pop_maximum();
+  BOOST_TEST_REQUIRE(pd.maximum() == expected[expected.size() - 2]);
+  pd.finish();
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(),
+                                                   std::less<int>()));
+}
+
+BOOST_AUTO_TEST_CASE( incremental_priority_deque_pops )
+{
+  using namespace boost::container;
+  for (int old_size = 0; old_size < 5; ++old_size)
+  {
+    for (int added = 2; added < 60; added += 3)
+    {
+      incremental_priority_deque<int> pd;
+      pd.set_piggyback(added % 2);
+      std::multiset<int> existing_elements;
+      for (int i = 0; i < old_size; ++i)
+      {
+        int value = rand() % 50;
+        existing_elements.insert(value);
+        pd.push(value);
+      }
+      std::vector<int> batch;
+      for (int i = 0; i < added; ++i)
+        batch.push_back(rand() % 50);
+      existing_elements.insert(batch.begin(), batch.end());
+      pd.insert(batch.begin(), batch.end());
+      while (!pd.empty())
+      {
+        BOOST_TEST_REQUIRE(pd.minimum() == *existing_elements.begin());
+        BOOST_TEST_REQUIRE(pd.maximum() == *existing_elements.rbegin());
+        switch (rand() % 3)
+        {
+          case 0:
+            existing_elements.erase(existing_elements.begin());
+            pd.pop_minimum();
+            break;
+          case 1:
+            existing_elements.erase(--existing_elements.end());
+            pd.pop_maximum();
+            break;
+          default:
+            if (existing_elements.size() < std::size_t(added))
+            {
+              int value = rand() % 60 - 5;
+              existing_elements.insert(value);
+              pd.push(value);
+            }
+        }
+        BOOST_TEST_REQUIRE(pd.size() == existing_elements.size());
+      }
+      BOOST_TEST_REQUIRE(!pd.building());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( incremental_priority_deque_greater )
+{
+  using namespace boost::container;
+  incremental_priority_deque<int, std::vector<int>, std::greater<int> > pd;
+  for (int i = 0; i < 11; ++i)
+    pd.push(i);
+  std::vector<int> batch;
+  for (int i = 0; i < 1000; ++i)
+    batch.push_back(rand() % 5000 - 2500);
+  pd.merge(batch.begin(), batch.end());
+  for (int i = 0; pd.building(); ++i)
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() ==
+                       *std::max_element(pd.begin(), pd.end()));
+    BOOST_TEST_REQUIRE(pd.maximum() ==
+                       *std::min_element(pd.begin(), pd.end()));
+    pd.push(rand() % 6000 - 3000);
+  }
+  std::vector<int> expected (pd.begin(), pd.end());
+  std::sort(expected.begin(), expected.end(), std::greater<int>());
+  for (std::size_t i = 0; i < expected.size(); ++i)
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() == expected[i]);
+    pd.pop_minimum();
+  }
+  BOOST_TEST_REQUIRE(pd.empty());
+
+  incremental_priority_deque<int, std::vector<int>, std::greater<int> > other;
+  other.insert(batch.begin(), batch.end());
+  swap(pd, other);
+  BOOST_TEST_REQUIRE(pd.building());
+  BOOST_TEST_REQUIRE(!other.building());
+  pd.finish();
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(),
+                                                   std::greater<int>()));
+  pd.clear();
+  BOOST_TEST_REQUIRE(pd.empty());
+  BOOST_TEST_REQUIRE(!pd.building());
+}
@@ -4,6 +4,59 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <set>
+
+namespace
+{
+//  A strcmp-style comparison, marked as three-way below.
+struct ThreeWayInt
+{
+  int operator() (int lhs, int rhs) const { return (lhs > rhs) - (lhs < rhs); }
+};
+
+//  Counts assignments, to show how far elements travel.
+struct MovedInt
+{
+  static long assignments;
+  int value;
+  MovedInt (int v = 0) : value(v) {}
+  MovedInt (MovedInt const & other) : value(other.value) {}
+  MovedInt & operator= (MovedInt const & other)
+  {
+    ++assignments;
+    value = other.value;
+    return *this;
+  }
+  bool operator< (MovedInt const & other) const { return value < other.value; }
+};
+long MovedInt::assignments = 0;
+
+struct ThreeWayMoved
+{
+  int operator() (MovedInt const & lhs, MovedInt const & rhs) const
+  {
+    return (lhs.value > rhs.value) - (lhs.value < rhs.value);
+  }
+};
+} //  Namespace
+
+namespace boost {
+namespace heap {
+template <>
+struct is_three_way_compare<ThreeWayInt, int>
+{
+  static const bool value = true;
+};
+template <>
+struct is_three_way_compare<ThreeWayMoved, MovedInt>
+{
+  static const bool value = true;
+};
+} //  Namespace heap
+} //  Namespace boost
 
 int kArrHeap [] = { 0, 19, 2, 19, 15, 16, 4, 5, 7 };
 
@@ -79,3 +132,267 @@ BOOST_AUTO_TEST_CASE( interval_heap_sorting )
   BOOST_TEST_REQUIRE(std::equal(heap_arr.begin(), heap_arr.end(), original.begin()));
 }
 
+
+BOOST_AUTO_TEST_CASE( interval_heap_make_arithmetic )
+{
+  using namespace boost::heap;
+  for (int count = 0; count < 300; ++count)
+  {
+    std::vector<int> ints;
+    std::vector<float> floats;
+    for (int i = 0; i < count; ++i)
+    {
+      ints.push_back(rand() % 64);
+      floats.push_back(static_cast<float>(rand() % 64) - 32.f);
+    }
+//  Zeros of both signs are equivalent, but neither may be lost.
+    floats.push_back(0.f);
+    floats.push_back(-0.f);
+    std::vector<int> original_ints = ints;
+    std::sort(original_ints.begin(), original_ints.end());
+
+    make_interval_heap(ints.begin(), ints.end(), std::less<int>());
+    BOOST_TEST_REQUIRE(is_interval_heap(ints.begin(), ints.end(), std::less<int>()));
+    std::vector<int> sorted_ints = ints;
+    std::sort(sorted_ints.begin(), sorted_ints.end());
+    BOOST_TEST_REQUIRE((sorted_ints == original_ints));
+
+    make_interval_heap(floats.begin(), floats.end(), std::greater<float>());
+    BOOST_TEST_REQUIRE(is_interval_heap(floats.begin(), floats.end(), std::greater<float>()));
+    int negative_zeros = 0;
+    for (std::vector<float>::iterator it = floats.begin(); it != floats.end(); ++it)
+      negative_zeros += (*it == 0.f) && (1.f / *it < 0.f);
+    BOOST_TEST_REQUIRE(negative_zeros == 1);
+  }
+}
+
+namespace
+{
+//  Counts comparisons, to verify that sorted input is arranged without them.
+struct CountingLess
+{
+  long * count;
+  explicit CountingLess (long * counter) : count(counter) {}
+  bool operator() (int lhs, int rhs) const
+  {
+    ++*count;
+    return lhs < rhs;
+  }
+};
+
+//  Copying may throw, so sorted input is arranged without scratch space.
+struct CopiedInt
+{
+  int value;
+  CopiedInt (int n) : value(n) {}
+  CopiedInt (CopiedInt const & rhs) : value(rhs.value) {}
+  CopiedInt & operator= (CopiedInt const & rhs)
+  {
+    value = rhs.value;
+    return *this;
+  }
+  bool operator< (CopiedInt const & rhs) const { return value < rhs.value; }
+};
+}
+
+BOOST_AUTO_TEST_CASE( interval_heap_from_sorted )
+{
+  using namespace boost::heap;
+  for (int count = 0; count < 300; ++count)
+  {
+    std::vector<int> heap_arr;
+    for (int i = 0; i < count; ++i)
+      heap_arr.push_back(rand() % 128);
+    std::sort(heap_arr.begin(), heap_arr.end());
+    std::vector<int> original = heap_arr;
+
+    std::vector<CopiedInt> copied_arr (heap_arr.begin(), heap_arr.end());
+
+    make_interval_heap_from_sorted(heap_arr.begin(), heap_arr.end());
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+    std::sort(heap_arr.begin(), heap_arr.end());
+    BOOST_TEST_REQUIRE((heap_arr == original));
+
+    make_interval_heap_from_sorted(copied_arr.begin(), copied_arr.end());
+    BOOST_TEST_REQUIRE(is_interval_heap(copied_arr.begin(), copied_arr.end(), std::less<CopiedInt>()));
+    std::sort(copied_arr.begin(), copied_arr.end());
+    for (int i = 0; i < count; ++i)
+      BOOST_TEST_REQUIRE(copied_arr[i].value == original[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( interval_heap_make_presorted )
+{
+  using namespace boost::heap;
+  for (int count = 2; count < 600; count += 7)
+  {
+    std::vector<int> ascending;
+    for (int i = 0; i < count; ++i)
+      ascending.push_back(rand() % 512);
+    std::sort(ascending.begin(), ascending.end());
+
+//  Sorted input is arranged after a single pass of comparisons.
+    std::vector<int> heap_arr = ascending;
+    long comparisons = 0;
+    make_interval_heap(heap_arr.begin(), heap_arr.end(), CountingLess(&comparisons));
+    BOOST_TEST_REQUIRE(comparisons == count - 1);
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+
+//  Strictly descending input is reversed, then arranged.
+    std::vector<int> descending;
+    for (int i = count; i--;)
+      descending.push_back(i);
+    comparisons = 0;
+    make_interval_heap(descending.begin(), descending.end(), CountingLess(&comparisons));
+    BOOST_TEST_REQUIRE(comparisons == count);
+    BOOST_TEST_REQUIRE(is_interval_heap(descending.begin(), descending.end(), std::less<int>()));
+
+//  A short unsorted tail is inserted after arranging the sorted prefix.
+    heap_arr = ascending;
+    heap_arr.back() = rand() % 512;
+    std::vector<int> expected = heap_arr;
+    std::sort(expected.begin(), expected.end());
+    make_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>());
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+    std::sort(heap_arr.begin(), heap_arr.end());
+    BOOST_TEST_REQUIRE((heap_arr == expected));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( interval_heap_sorting_double_ended )
+{
+  using namespace boost::heap;
+  for (int count = 0; count < 300; ++count)
+  {
+    std::vector<int> heap_arr;
+    for (int i = 0; i < count; ++i)
+      heap_arr.push_back(rand() % 200);
+    std::vector<int> original = heap_arr;
+    std::sort(original.begin(), original.end());
+    std::vector<CopiedInt> copied_arr (heap_arr.begin(), heap_arr.end());
+
+    make_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>());
+    sort_interval_heap_double_ended(heap_arr.begin(), heap_arr.end(), std::less<int>());
+    BOOST_TEST_REQUIRE((heap_arr == original));
+
+    make_interval_heap(copied_arr.begin(), copied_arr.end(), std::less<CopiedInt>());
+    sort_interval_heap_double_ended(copied_arr.begin(), copied_arr.end(), std::less<CopiedInt>());
+    for (int i = 0; i < count; ++i)
+      BOOST_TEST_REQUIRE(copied_arr[i].value == original[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( interval_heap_reverse )
+{
+  using namespace boost::heap;
+  for (int count = 0; count < 300; ++count)
+  {
+    std::vector<int> heap_arr;
+    for (int i = 0; i < count; ++i)
+      heap_arr.push_back(rand() % 128);
+    make_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>());
+    reverse_interval_heap(heap_arr.begin(), heap_arr.end());
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::greater<int>()));
+    reverse_interval_heap(heap_arr.begin(), heap_arr.end());
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( interval_heap_three_way )
+{
+  using namespace boost::heap;
+  for (int count = 0; count < 300; ++count)
+  {
+    std::vector<int> heap_arr;
+    std::multiset<int> expected;
+    for (int i = 0; i < count; ++i)
+    {
+      heap_arr.push_back(rand() % 4);
+      expected.insert(heap_arr.back());
+    }
+    make_interval_heap(heap_arr.begin(), heap_arr.end(), ThreeWayInt());
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), ThreeWayInt()));
+//  Updates may move elements in either direction.
+    for (int i = 0; i < count; ++i)
+    {
+      int index = rand() % count;
+      expected.erase(expected.find(heap_arr[index]));
+      heap_arr[index] = rand() % 6 - 1;
+      expected.insert(heap_arr[index]);
+      update_interval_heap(heap_arr.begin(), heap_arr.end(), index, ThreeWayInt());
+      BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+    }
+    while (!heap_arr.empty())
+    {
+      if (heap_arr.size() & 1)
+      {
+        pop_interval_heap_min(heap_arr.begin(), heap_arr.end(), ThreeWayInt());
+        BOOST_TEST_REQUIRE(heap_arr.back() == *expected.begin());
+        expected.erase(expected.begin());
+      } else {
+        pop_interval_heap_max(heap_arr.begin(), heap_arr.end(), ThreeWayInt());
+        BOOST_TEST_REQUIRE(heap_arr.back() == *expected.rbegin());
+        expected.erase(--expected.end());
+      }
+      heap_arr.pop_back();
+      BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+    }
+  }
+
+//  With few distinct keys, sifts stop at the first tie.
+  std::vector<MovedInt> boolean_arr, three_way_arr;
+  for (int i = 0; i < 10000; ++i)
+    boolean_arr.push_back(MovedInt(rand() % 2));
+  make_interval_heap(boolean_arr.begin(), boolean_arr.end(), std::less<MovedInt>());
+  three_way_arr = boolean_arr;
+  MovedInt::assignments = 0;
+  for (std::vector<MovedInt>::iterator it = boolean_arr.end(); it != boolean_arr.begin(); --it)
+    pop_interval_heap_min(boolean_arr.begin(), it, std::less<MovedInt>());
+  const long boolean_assignments = MovedInt::assignments;
+  MovedInt::assignments = 0;
+  for (std::vector<MovedInt>::iterator it = three_way_arr.end(); it != three_way_arr.begin(); --it)
+    pop_interval_heap_min(three_way_arr.begin(), it, ThreeWayMoved());
+  BOOST_TEST_REQUIRE(MovedInt::assignments < boolean_assignments * 3 / 4);
+  for (std::size_t i = 0; i < three_way_arr.size(); ++i)
+    BOOST_TEST_REQUIRE(three_way_arr[i].value == boolean_arr[i].value);
+}
+
+BOOST_AUTO_TEST_CASE( interval_heap_push_monotone )
+{
+  using namespace boost::heap;
+  for (int pattern = 0; pattern < 4; ++pattern)
+  {
+    std::vector<int> heap_arr;
+    int shortcuts = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+      int pushed;
+      switch (pattern)
+      {
+        case 0:  pushed = i; break;                   //  Increasing
+        case 1:  pushed = -i; break;                  //  Decreasing
+        case 2:  pushed = i + rand() % 16; break;     //  Nearly increasing
+        default: pushed = (i & 1) ? i : -i;           //  Both ends
+      }
+      heap_arr.push_back(pushed);
+      if (push_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()))
+        ++shortcuts;
+      BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+    }
+    BOOST_TEST_REQUIRE(heap_arr[0] == *std::min_element(heap_arr.begin(), heap_arr.end()));
+    BOOST_TEST_REQUIRE(heap_arr[1] == *std::max_element(heap_arr.begin(), heap_arr.end()));
+    if (pattern != 2)
+      BOOST_TEST_REQUIRE(shortcuts > 1900);
+    else
+      BOOST_TEST_REQUIRE(shortcuts > 0);
+  }
+//  Elements that do not belong at the root are sifted as usual.
+  std::vector<int> heap_arr;
+  for (int i = 0; i < 2000; ++i)
+  {
+    heap_arr.push_back(rand() % 1000);
+    push_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>());
+    BOOST_TEST_REQUIRE(is_interval_heap(heap_arr.begin(), heap_arr.end(), std::less<int>()));
+  }
+}
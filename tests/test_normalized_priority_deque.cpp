@@ -0,0 +1,147 @@
+#include "../normalized_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+//  Checks that encoding preserves order and is inverted by decoding.
+template <typename T>
+void check_normalizer (std::vector<T> values)
+{
+  typedef boost::container::key_normalizer<T> normalizer;
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    BOOST_TEST_REQUIRE((normalizer::decode(normalizer::encode(values[i])) == values[i]));
+    for (std::size_t j = 0; j < values.size(); ++j)
+      if (values[i] < values[j])
+        BOOST_TEST_REQUIRE(normalizer::encode(values[i]) < normalizer::encode(values[j]));
+  }
+}
+
+template <typename T, typename Compare>
+void check_deque (std::vector<T> const & values)
+{
+  using namespace boost::container;
+  std::multiset<T, Compare> expected (values.begin(), values.end());
+  normalized_priority_deque<T, Compare> pd;
+  for (std::size_t i = 0; i < values.size() / 2; ++i)
+    pd.push(values[i]);
+  pd.insert(values.begin() + values.size() / 2, values.end());
+  BOOST_TEST_REQUIRE(pd.size() == values.size());
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE((pd.minimum() == *expected.begin()));
+    expected.erase(expected.begin());
+    pd.pop_minimum();
+    if (pd.empty())
+      break;
+    typename std::multiset<T, Compare>::iterator last = expected.end();
+    --last;
+    BOOST_TEST_REQUIRE((pd.top() == *last));
+    expected.erase(last);
+    pd.pop();
+  }
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( key_normalizer_integers )
+{
+  std::vector<int> ints;
+  ints.push_back(std::numeric_limits<int>::min());
+  ints.push_back(-1);
+  ints.push_back(0);
+  ints.push_back(1);
+  ints.push_back(std::numeric_limits<int>::max());
+  check_normalizer(ints);
+
+  std::vector<signed char> chars;
+  for (int i = -128; i < 128; i += 5)
+    chars.push_back(static_cast<signed char>(i));
+  check_normalizer(chars);
+
+  std::vector<unsigned long long> longs;
+  longs.push_back(0);
+  longs.push_back(1);
+  longs.push_back(std::numeric_limits<unsigned long long>::max());
+  check_normalizer(longs);
+}
+
+BOOST_AUTO_TEST_CASE( key_normalizer_floating )
+{
+  std::vector<float> floats;
+  floats.push_back(-std::numeric_limits<float>::infinity());
+  floats.push_back(-std::numeric_limits<float>::max());
+  floats.push_back(-1.5f);
+  floats.push_back(-std::numeric_limits<float>::denorm_min());
+  floats.push_back(0.f);
+  floats.push_back(std::numeric_limits<float>::denorm_min());
+  floats.push_back(std::numeric_limits<float>::min());
+  floats.push_back(2.25f);
+  floats.push_back(std::numeric_limits<float>::infinity());
+  check_normalizer(floats);
+
+  std::vector<double> doubles;
+  for (int i = 0; i < 100; ++i)
+    doubles.push_back((rand() - RAND_MAX / 2) / 7.0);
+  check_normalizer(doubles);
+
+//  Negative zero is decoded with its sign, and ordered before positive zero.
+  typedef boost::container::key_normalizer<float> normalizer;
+  const float negative_zero = -0.f;
+  BOOST_TEST_REQUIRE(1.f / normalizer::decode(normalizer::encode(negative_zero)) < 0.f);
+  BOOST_TEST_REQUIRE(normalizer::encode(negative_zero) < normalizer::encode(0.f));
+}
+
+BOOST_AUTO_TEST_CASE( key_normalizer_pairs )
+{
+  std::vector<std::pair<short, unsigned char> > small;
+  std::vector<std::pair<int, int> > large;
+  std::vector<std::pair<bool, signed char> > bits;
+  for (int i = 0; i < 50; ++i)
+  {
+    small.push_back(std::make_pair(static_cast<short>(rand() % 7 - 3), static_cast<unsigned char>(rand())));
+    large.push_back(std::make_pair(rand() - RAND_MAX / 2, rand() - RAND_MAX / 2));
+    bits.push_back(std::make_pair(rand() % 2 == 0, static_cast<signed char>(rand() % 256 - 128)));
+  }
+  check_normalizer(small);
+  check_normalizer(large);
+  check_normalizer(bits);
+}
+
+BOOST_AUTO_TEST_CASE( key_normalizer_prefix )
+{
+  using boost::container::normalize_prefix;
+  const char * words[] = { "", "a", "ab", "abcdefgh", "abcdefghij", "b", "\xff" };
+  const std::size_t count = sizeof(words) / sizeof(words[0]);
+  for (std::size_t i = 0; i + 1 < count; ++i)
+    BOOST_TEST_REQUIRE(normalize_prefix(words[i], std::strlen(words[i])) <=
+                       normalize_prefix(words[i + 1], std::strlen(words[i + 1])));
+  BOOST_TEST_REQUIRE(normalize_prefix(words[1], 1) < normalize_prefix(words[2], 2));
+  BOOST_TEST_REQUIRE(normalize_prefix(words[3], 8) == normalize_prefix(words[4], 10));
+}
+
+BOOST_AUTO_TEST_CASE( normalized_priority_deque_order )
+{
+  std::vector<float> floats;
+  std::vector<int> ints;
+  std::vector<std::pair<short, short> > pairs;
+  for (int i = 0; i < 517; ++i)
+  {
+    floats.push_back((rand() - RAND_MAX / 2) / 3.f);
+    ints.push_back(rand() - RAND_MAX / 2);
+    pairs.push_back(std::make_pair(static_cast<short>(rand() % 5 - 2), static_cast<short>(rand() % 1000 - 500)));
+  }
+  check_deque<float, std::less<float> >(floats);
+  check_deque<float, std::greater<float> >(floats);
+  check_deque<int, std::less<int> >(ints);
+  check_deque<std::pair<short, short>, std::less<std::pair<short, short> > >(pairs);
+}
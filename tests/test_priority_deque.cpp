@@ -5,6 +5,10 @@
 #include <iostream>
 #include <cstdlib>
 #include <set>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 
 namespace
 {
@@ -566,3 +570,397 @@ BOOST_AUTO_TEST_CASE( priority_deque_random_erase )
   }
 }
 
+
+BOOST_AUTO_TEST_CASE( priority_deque_sorted_range_constructor )
+{
+  using namespace boost::container;
+
+  std::multiset<int> existing_elements;
+  for (int i = 0; i < 517; ++i)
+    existing_elements.insert(rand());
+  priority_deque<int> pd (sorted_range, existing_elements.begin(), existing_elements.end());
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<int>()));
+  BOOST_TEST_REQUIRE(have_same_elements(pd, existing_elements));
+
+  for (std::multiset<int>::iterator it = existing_elements.begin(); it != existing_elements.end(); ++it)
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() == *it);
+    pd.pop_minimum();
+  }
+  BOOST_TEST_REQUIRE(pd.empty());
+
+  std::multiset<int, std::greater<int> > descending (existing_elements.begin(), existing_elements.end());
+  priority_deque<int, std::vector<int>, std::greater<int> > reversed_pd (sorted_range, descending.begin(), descending.end());
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(reversed_pd.begin(), reversed_pd.end(), std::greater<int>()));
+  BOOST_TEST_REQUIRE(reversed_pd.maximum() == *existing_elements.begin());
+}
+
+namespace
+{
+struct AddOffset
+{
+  int offset;
+  int operator() (int value) const { return value + offset; }
+};
+
+//  Doubles values, but throws after a set number of calls. Each copy (one per
+//  thread) counts its own calls.
+struct ThrowingDouble
+{
+  long calls_left;
+  int operator() (int value)
+  {
+    if (calls_left-- == 0)
+      throw std::exception();
+    return value * 2;
+  }
+};
+}
+
+BOOST_AUTO_TEST_CASE( priority_deque_transform_monotone )
+{
+  using namespace boost::container;
+  std::multiset<int> existing_elements;
+  priority_deque<int> pd;
+  for (int i = 0; i < 5171; ++i)
+  {
+    int pushed = rand() % 10000 - 5000;
+    existing_elements.insert(pushed + 7);
+    pd.push(pushed);
+  }
+  AddOffset add = { 7 };
+  pd.transform_monotone(add, 4);
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<int>()));
+  BOOST_TEST_REQUIRE(have_same_elements(pd, existing_elements));
+  BOOST_TEST_REQUIRE(pd.minimum() == *existing_elements.begin());
+  BOOST_TEST_REQUIRE(pd.maximum() == *existing_elements.rbegin());
+
+//  Offsets preserve order under any comparison.
+  priority_deque<int, std::vector<int>, std::greater<int> > reversed;
+  for (std::multiset<int>::iterator it = existing_elements.begin(); it != existing_elements.end(); ++it)
+    reversed.push(*it);
+  AddOffset subtract = { -7 };
+  reversed.transform_monotone(subtract);
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(reversed.begin(), reversed.end(), std::greater<int>()));
+  BOOST_TEST_REQUIRE(reversed.minimum() == *existing_elements.rbegin() - 7);
+
+//  A failed transform leaves a valid heap of the same size.
+  ThrowingDouble doubler = { 1000 };
+  bool thrown = false;
+  try {
+    pd.transform_monotone(doubler, 3);
+  } catch (std::exception &) {
+    thrown = true;
+  }
+  BOOST_TEST_REQUIRE(thrown);
+  BOOST_TEST_REQUIRE(pd.size() == existing_elements.size());
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<int>()));
+}
+
+namespace
+{
+//  A strcmp-style comparison, marked as three-way below.
+struct ThreeWayLess
+{
+  int operator() (int lhs, int rhs) const { return (lhs > rhs) - (lhs < rhs); }
+};
+
+//  Comparison whose direction is chosen at run time.
+struct DirectedLess
+{
+  bool ascending;
+  bool operator() (int lhs, int rhs) const
+  {
+    return ascending ? (lhs < rhs) : (rhs < lhs);
+  }
+};
+}
+
+namespace boost {
+namespace heap {
+template <>
+struct is_three_way_compare<ThreeWayLess, int>
+{
+  static const bool value = true;
+};
+} //  Namespace heap
+} //  Namespace boost
+
+BOOST_AUTO_TEST_CASE( priority_deque_reverse )
+{
+  using namespace boost::container;
+  std::multiset<int> existing_elements;
+  DirectedLess ascending = { true };
+  DirectedLess descending = { false };
+  priority_deque<int, std::vector<int>, DirectedLess> pd (ascending);
+  for (int i = 0; i < 3131; ++i)
+  {
+    int pushed = rand();
+    existing_elements.insert(pushed);
+    pd.push(pushed);
+  }
+  pd.reverse(descending, 4);
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), descending));
+  BOOST_TEST_REQUIRE(pd.minimum() == *existing_elements.rbegin());
+  BOOST_TEST_REQUIRE(pd.maximum() == *existing_elements.begin());
+  BOOST_TEST_REQUIRE(have_same_elements(pd, existing_elements));
+
+  priority_deque<int> forward;
+  for (std::multiset<int>::iterator it = existing_elements.begin(); it != existing_elements.end(); ++it)
+    forward.push(*it);
+#if (__cplusplus >= 201103L)
+  priority_deque<int, std::vector<int>, std::greater<int> > backward (reverse_order, std::move(forward), std::greater<int>(), 3);
+#else
+  priority_deque<int, std::vector<int>, std::greater<int> > backward (reverse_order, forward, std::greater<int>(), 3);
+#endif
+  BOOST_TEST_REQUIRE(forward.empty());
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(backward.begin(), backward.end(), std::greater<int>()));
+  BOOST_TEST_REQUIRE(have_same_elements(backward, existing_elements));
+  for (std::multiset<int>::iterator it = existing_elements.begin(); it != existing_elements.end(); ++it)
+  {
+    BOOST_TEST_REQUIRE(backward.maximum() == *it);
+    backward.pop_maximum();
+  }
+}
+
+namespace
+{
+template <typename Deque>
+void check_three_way (Deque & pd)
+{
+  std::multiset<int> existing_elements;
+  for (int i = 0; i < 2000; ++i)
+  {
+    int pushed = rand() % 5;
+    existing_elements.insert(pushed);
+    pd.push(pushed);
+  }
+  for (int i = 0; i < 200; ++i)
+  {
+    typename Deque::const_iterator it = pd.begin() + rand() % pd.size();
+    existing_elements.erase(existing_elements.find(*it));
+    int updated = rand() % 7 - 1;
+    existing_elements.insert(updated);
+    pd.update(it, updated);
+  }
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<int>()));
+  BOOST_TEST_REQUIRE(have_same_elements(pd, existing_elements));
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() == *existing_elements.begin());
+    existing_elements.erase(existing_elements.begin());
+    pd.pop_minimum();
+    if (pd.empty())
+      break;
+    BOOST_TEST_REQUIRE(pd.maximum() == *existing_elements.rbegin());
+    existing_elements.erase(--existing_elements.end());
+    pd.pop_maximum();
+  }
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( priority_deque_three_way )
+{
+  using namespace boost::container;
+  priority_deque<int, std::vector<int>, ThreeWayLess> pd;
+  check_three_way(pd);
+  BOOST_TEST_REQUIRE(!(boost::heap::is_three_way_compare<std::less<int>, int>::value));
+}
+
+BOOST_AUTO_TEST_CASE( priority_deque_monotone_pushes )
+{
+  using namespace boost::container;
+  priority_deque<int> pd;
+  for (int i = 0; i < 1000; ++i)
+    pd.push(i);
+  BOOST_TEST_REQUIRE(pd.monotone_pushes() > 900u);
+  BOOST_TEST_REQUIRE(pd.maximum() == 999);
+  BOOST_TEST_REQUIRE(pd.minimum() == 0);
+  const std::size_t counted = pd.monotone_pushes();
+//  Pushes in the middle of the range are not counted.
+  for (int i = 0; i < 100; ++i)
+    pd.push(500);
+  BOOST_TEST_REQUIRE(pd.monotone_pushes() == counted);
+  priority_deque<int> other;
+  other.swap(pd);
+  BOOST_TEST_REQUIRE(other.monotone_pushes() == counted);
+  BOOST_TEST_REQUIRE(pd.monotone_pushes() == 0u);
+  for (int i = 0; i < 1100; ++i)
+  {
+    BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(other.begin(), other.end(), std::less<int>()));
+    other.pop_minimum();
+  }
+}
+
+namespace
+{
+struct BelowCutoff
+{
+  int cutoff;
+  bool operator() (int x) const { return x < cutoff; }
+};
+struct AtLeast
+{
+  int cutoff;
+  bool operator() (int x) const { return x >= cutoff; }
+};
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( priority_deque_pop_while )
+{
+  using namespace boost::container;
+  std::vector<int> values;
+  for (int i = 0; i < 10000; ++i)
+    values.push_back(rand() % 10000);
+  std::multiset<int> expected (values.begin(), values.end());
+  priority_deque<int> pd (values.begin(), values.end());
+//  Few elements qualify, so they are popped one at a time, in order.
+  std::vector<int> removed;
+  BelowCutoff few = { 20 };
+  pd.pop_minimum_while(few, std::back_inserter(removed));
+  BOOST_TEST_REQUIRE(!removed.empty());
+  for (std::size_t i = 0; i < removed.size(); ++i)
+  {
+    BOOST_TEST_REQUIRE(removed[i] < 20);
+    if (i > 0)
+      BOOST_TEST_REQUIRE(removed[i - 1] <= removed[i]);
+    expected.erase(expected.find(removed[i]));
+  }
+//  Most elements qualify, so the heap is partitioned and rebuilt.
+  removed.clear();
+  pd.pop_minimum_until(8000, std::back_inserter(removed));
+  BOOST_TEST_REQUIRE(removed.size() > pd.size());
+  for (std::size_t i = 0; i < removed.size(); ++i)
+  {
+    BOOST_TEST_REQUIRE(removed[i] < 8000);
+    expected.erase(expected.find(removed[i]));
+  }
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<int>()));
+  BOOST_TEST_REQUIRE(have_same_elements(pd, expected));
+  BOOST_TEST_REQUIRE(pd.minimum() >= 8000);
+
+  std::vector<int> top;
+  AtLeast all = { 0 };
+  pd.pop_maximum_while(all, std::back_inserter(top));
+  BOOST_TEST_REQUIRE(pd.empty());
+  BOOST_TEST_REQUIRE(top.size() == expected.size());
+
+  priority_deque<int, std::vector<int>, ThreeWayLess> three_way;
+  for (int i = 0; i < 100; ++i)
+    three_way.push(i);
+  top.clear();
+  three_way.pop_minimum_until(50, std::back_inserter(top));
+  BOOST_TEST_REQUIRE(top.size() == 50u);
+  BOOST_TEST_REQUIRE(three_way.minimum() == 50);
+}
+
+BOOST_AUTO_TEST_CASE( priority_deque_pop_n )
+{
+  using namespace boost::container;
+  std::vector<int> values;
+  for (int i = 0; i < 10000; ++i)
+    values.push_back(rand() % 1000);
+  std::multiset<int> expected (values.begin(), values.end());
+  priority_deque<int> pd (values.begin(), values.end());
+  std::vector<int> removed;
+//  A few are popped one at a time, in order; many are selected at once.
+  const std::size_t counts[] = { 3, 5000, 0, 20000 };
+  for (int round = 0; round < 4; ++round)
+  {
+    const bool maximal = (round % 2 == 1);
+    removed.clear();
+    if (maximal)
+      pd.pop_maximum_n(counts[round], std::back_inserter(removed));
+    else
+      pd.pop_minimum_n(counts[round], std::back_inserter(removed));
+    BOOST_TEST_REQUIRE(removed.size() == std::min(counts[round], expected.size()));
+    for (std::size_t i = 0; i < removed.size(); ++i)
+    {
+      BOOST_TEST_REQUIRE(expected.count(removed[i]) > 0u);
+      if (maximal)
+        BOOST_TEST_REQUIRE(removed[i] >= (pd.empty() ? removed[i] : pd.maximum()));
+      else
+        BOOST_TEST_REQUIRE(removed[i] <= (pd.empty() ? removed[i] : pd.minimum()));
+      if ((removed.size() == 3u) && (i > 0))
+        BOOST_TEST_REQUIRE(removed[i - 1] <= removed[i]);
+      expected.erase(expected.find(removed[i]));
+    }
+    BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<int>()));
+    BOOST_TEST_REQUIRE(have_same_elements(pd, expected));
+  }
+  BOOST_TEST_REQUIRE(pd.empty());
+}
+
+namespace
+{
+//  Output iterator that throws once it has written @a limit elements.
+struct LimitedWriter
+{
+  std::vector<std::string> * written;
+  std::size_t limit;
+  LimitedWriter & operator* (void) { return *this; }
+  LimitedWriter & operator++ (void) { return *this; }
+  LimitedWriter & operator= (std::string const & value)
+  {
+    if (written->size() == limit)
+      throw std::runtime_error("Output full.");
+    written->push_back(value);
+    return *this;
+  }
+};
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( priority_deque_pop_n_throwing_output )
+{
+  using namespace boost::container;
+  priority_deque<std::string> pd;
+  for (int i = 0; i < 1000; ++i)
+    pd.push(std::string(20, static_cast<char>('a' + rand() % 26)) + static_cast<char>('a' + i % 26));
+  std::vector<std::string> written;
+  LimitedWriter out = { &written, 100 };
+  bool thrown = false;
+  try {
+//  Enough to take the selection path.
+    pd.pop_minimum_n(900, out);
+  } catch (std::runtime_error &) {
+    thrown = true;
+  }
+  BOOST_TEST_REQUIRE(thrown);
+  BOOST_TEST_REQUIRE(written.size() == 100u);
+//  Written elements are gone, not left behind as moved-from strings.
+  BOOST_TEST_REQUIRE(pd.size() + written.size() + 1 == 1000u);
+  for (priority_deque<std::string>::const_iterator it = pd.begin(); it != pd.end(); ++it)
+    BOOST_TEST_REQUIRE(it->size() == 21u);
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<std::string>()));
+}
+
+#if (__cplusplus >= 201103L)
+BOOST_AUTO_TEST_CASE( priority_deque_merge_deque )
+{
+  using namespace boost::container;
+  std::multiset<int> expected;
+//  Small into large, large into small, and of similar sizes.
+  const int sizes[][2] = { { 1000, 10 }, { 10, 1000 }, { 500, 600 } };
+  for (int round = 0; round < 3; ++round)
+  {
+    priority_deque<int> first, second;
+    expected.clear();
+    for (int i = 0; i < sizes[round][0]; ++i)
+    {
+      const int pushed = rand() % 1000;
+      first.push(pushed);
+      expected.insert(pushed);
+    }
+    for (int i = 0; i < sizes[round][1]; ++i)
+    {
+      const int pushed = rand() % 1000;
+      second.push(pushed);
+      expected.insert(pushed);
+    }
+    first.merge(std::move(second));
+    BOOST_TEST_REQUIRE(second.empty());
+    BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(first.begin(), first.end(), std::less<int>()));
+    BOOST_TEST_REQUIRE(have_same_elements(first, expected));
+  }
+}
+#endif
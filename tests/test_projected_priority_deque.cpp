@@ -0,0 +1,129 @@
+#include "../projected_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace
+{
+struct Task
+{
+  int priority;
+};
+
+//  Counts projections, to verify that cached keys are not re-computed.
+struct TaskPriority
+{
+  typedef int result_type;
+  static long calls;
+  int operator() (Task const * task) const
+  {
+    ++calls;
+    return task->priority;
+  }
+};
+long TaskPriority::calls = 0;
+
+//  Checks that the deque yields its tasks in order, from both ends.
+template <typename Deque>
+void check_drain (Deque & pd, std::multiset<int> expected)
+{
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE(pd.minimum()->priority == *expected.begin());
+    expected.erase(expected.begin());
+    pd.pop_minimum();
+    if (pd.empty())
+      break;
+    std::multiset<int>::iterator last = expected.end();
+    --last;
+    BOOST_TEST_REQUIRE(pd.maximum()->priority == *last);
+    expected.erase(last);
+    pd.pop_maximum();
+  }
+  BOOST_TEST_REQUIRE(expected.empty());
+}
+
+template <bool cache>
+void check_projected (void)
+{
+  using namespace boost::container;
+  typedef projected_priority_deque<Task *, TaskPriority, std::less<int>, cache> deque_t;
+  std::vector<Task> tasks (313);
+  std::multiset<int> expected;
+  deque_t pd;
+  for (std::size_t i = 0; i < tasks.size(); ++i)
+  {
+    tasks[i].priority = rand() % 100;
+    expected.insert(tasks[i].priority);
+    pd.push(&tasks[i]);
+  }
+  BOOST_TEST_REQUIRE(pd.size() == tasks.size());
+  BOOST_TEST_REQUIRE((static_cast<std::size_t>(pd.end() - pd.begin()) == tasks.size()));
+
+//  Change pointed-to priorities, refreshing each key as it changes.
+  for (std::size_t i = 0; i < pd.size(); ++i)
+  {
+    Task * task = pd.begin()[i];
+    expected.erase(expected.find(task->priority));
+    task->priority = rand() % 100;
+    expected.insert(task->priority);
+    pd.update(pd.begin() + i);
+  }
+  check_drain(pd, expected);
+
+//  Replace and erase elements by iterator.
+  std::vector<Task *> pointers;
+  for (std::size_t i = 0; i < tasks.size(); ++i)
+    pointers.push_back(&tasks[i]);
+  deque_t built (pointers.begin(), pointers.end());
+  expected.clear();
+  for (std::size_t i = 0; i < tasks.size(); ++i)
+    expected.insert(tasks[i].priority);
+  Task extra = { -1 };
+  expected.erase(expected.find(built.begin()[5]->priority));
+  built.update(built.begin() + 5, &extra);
+  expected.insert(-1);
+  expected.erase(expected.find(built.begin()[7]->priority));
+  built.erase(built.begin() + 7);
+  BOOST_TEST_REQUIRE(built.minimum() == &extra);
+  check_drain(built, expected);
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( projected_priority_deque_cached )
+{
+  check_projected<true>();
+}
+
+BOOST_AUTO_TEST_CASE( projected_priority_deque_uncached )
+{
+  check_projected<false>();
+}
+
+BOOST_AUTO_TEST_CASE( projected_priority_deque_projection_count )
+{
+  using namespace boost::container;
+  std::vector<Task> tasks (517);
+  std::vector<Task *> pointers;
+  for (std::size_t i = 0; i < tasks.size(); ++i)
+  {
+    tasks[i].priority = rand();
+    pointers.push_back(&tasks[i]);
+  }
+//  Cached keys are projected once per insertion, and never while sifting.
+  TaskPriority::calls = 0;
+  projected_priority_deque<Task *, TaskPriority> pd (pointers.begin(), pointers.end());
+  for (std::size_t i = 0; i < tasks.size(); ++i)
+    pd.push(&tasks[i]);
+  while (!pd.empty())
+    pd.pop_minimum();
+  BOOST_TEST_REQUIRE(TaskPriority::calls == 2 * static_cast<long>(tasks.size()));
+
+  TaskPriority::calls = 0;
+  projected_priority_deque<Task *, TaskPriority, std::less<int>, false> uncached (pointers.begin(), pointers.end());
+  BOOST_TEST_REQUIRE(TaskPriority::calls > static_cast<long>(tasks.size()));
+}
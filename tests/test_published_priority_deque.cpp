@@ -0,0 +1,113 @@
+#include "../published_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+//  Too large to publish whole; only its priority is published.
+struct job
+{
+  int priority;
+  std::string name;
+  bool operator< (job const & other) const
+  {
+    return priority < other.priority;
+  }
+};
+struct priority_of
+{
+  int operator() (job const & j) const { return j.priority; }
+};
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( published_priority_deque_peek )
+{
+  using namespace boost::container;
+  published_priority_deque<int> deque;
+  int key = 0;
+  BOOST_TEST_REQUIRE(deque.empty());
+  BOOST_TEST_REQUIRE(!deque.peek_minimum(key));
+  BOOST_TEST_REQUIRE(!deque.peek_maximum(key));
+  for (int i = 0; i < 100; ++i)
+    deque.push((i * 37) % 100);
+  published_priority_deque<int>::extremes seen = deque.peek();
+  BOOST_TEST_REQUIRE(seen.size == 100u);
+  BOOST_TEST_REQUIRE(seen.minimum == 0);
+  BOOST_TEST_REQUIRE(seen.maximum == 99);
+  int value = 0;
+  BOOST_TEST_REQUIRE(deque.try_pop_maximum(value));
+  BOOST_TEST_REQUIRE(value == 99);
+  BOOST_TEST_REQUIRE(deque.try_pop_minimum(value));
+  BOOST_TEST_REQUIRE(value == 0);
+  BOOST_TEST_REQUIRE(deque.peek_minimum(key));
+  BOOST_TEST_REQUIRE(key == 1);
+  BOOST_TEST_REQUIRE(deque.peek_maximum(key));
+  BOOST_TEST_REQUIRE(key == 98);
+//  Operations not wrapped are published once they return.
+  std::vector<int> low;
+  deque.modify([&low](published_priority_deque<int>::deque_type & d) {
+    d.pop_minimum_n(10, std::back_inserter(low));
+  });
+  BOOST_TEST_REQUIRE(low.size() == 10u);
+  BOOST_TEST_REQUIRE(deque.size() == 88u);
+  BOOST_TEST_REQUIRE(deque.peek_minimum(key));
+  BOOST_TEST_REQUIRE(key == 11);
+  deque.clear();
+  BOOST_TEST_REQUIRE(!deque.peek_maximum(key));
+  BOOST_TEST_REQUIRE(!deque.try_pop_minimum(value));
+
+//  Large elements publish a key.
+  published_priority_deque<job, priority_of> jobs;
+  job a = { 5, std::string(100, 'a') }, b = { 2, "b" }, c = { 9, "c" };
+  jobs.push(a);
+  jobs.push(b);
+  jobs.push(c);
+  BOOST_TEST_REQUIRE(jobs.peek_minimum(key));
+  BOOST_TEST_REQUIRE(key == 2);
+  BOOST_TEST_REQUIRE(jobs.peek_maximum(key));
+  BOOST_TEST_REQUIRE(key == 9);
+  job out;
+  BOOST_TEST_REQUIRE(jobs.try_pop_maximum(out));
+  BOOST_TEST_REQUIRE(out.name == "c");
+  BOOST_TEST_REQUIRE(jobs.peek_maximum(key));
+  BOOST_TEST_REQUIRE(key == 5);
+}
+
+//  The writer keeps the contents a run of consecutive integers, so a torn
+//  snapshot would be caught by a reader.
+BOOST_AUTO_TEST_CASE( published_priority_deque_readers )
+{
+  using namespace boost::container;
+  published_priority_deque<long> deque;
+  std::atomic<bool> done (false);
+  std::atomic<int> torn (0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r)
+    readers.push_back(std::thread([&]() {
+      while (!done)
+      {
+        const published_priority_deque<long>::extremes seen = deque.peek();
+        if (seen.size && (seen.maximum - seen.minimum + 1 !=
+                          static_cast<long>(seen.size)))
+          ++torn;
+      }
+    }));
+  long value;
+  for (int round = 0; round < 20; ++round)
+  {
+    for (long i = 0; i < 1000; ++i)
+      deque.push(round * 1000 + i);
+    while (deque.try_pop_minimum(value)) {}
+  }
+  done = true;
+  for (std::size_t r = 0; r < readers.size(); ++r)
+    readers[r].join();
+  BOOST_TEST_REQUIRE(torn == 0);
+  BOOST_TEST_REQUIRE(deque.empty());
+  BOOST_TEST_REQUIRE(deque.publications() == 40001u);
+}
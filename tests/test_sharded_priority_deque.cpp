@@ -0,0 +1,84 @@
+#include "../sharded_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( sharded_priority_deque_push_pop )
+{
+  using namespace boost::container;
+  for (std::size_t shards = 1; shards <= 7; shards += 3)
+  {
+    sharded_priority_deque<int> pd (shards);
+    std::multiset<int> expected;
+    for (int i = 0; i < 2000; ++i)
+    {
+      const int pushed = rand() % 1000;
+      pd.push(pushed);
+      expected.insert(pushed);
+    }
+    for (int i = 0; !expected.empty(); ++i)
+    {
+      BOOST_TEST_REQUIRE(pd.size() == expected.size());
+      BOOST_TEST_REQUIRE(pd.minimum() == *expected.begin());
+      BOOST_TEST_REQUIRE(pd.maximum() == *expected.rbegin());
+      if (i % 2 == 0)
+      {
+        pd.pop_minimum();
+        expected.erase(expected.begin());
+      } else {
+        pd.pop_maximum();
+        expected.erase(--expected.end());
+      }
+    }
+    BOOST_TEST_REQUIRE(pd.empty());
+  }
+}
+
+namespace
+{
+struct add_to_shard
+{
+  void operator() (boost::container::priority_deque<int> & shard,
+                   std::size_t index) const
+  {
+    for (int i = 0; i < 100; ++i)
+      shard.push(static_cast<int>(index) * 1000 + i);
+  }
+};
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( sharded_priority_deque_parallel )
+{
+  using namespace boost::container;
+  std::vector<int> bounds;
+  bounds.push_back(250);
+  bounds.push_back(500);
+  bounds.push_back(750);
+  typedef sharded_priority_deque<int, range_shard<int> > deque_t;
+  deque_t pd (4, range_shard<int>(bounds));
+  std::vector<int> values;
+  for (int i = 0; i < 100000; ++i)
+    values.push_back(rand() % 1000);
+  pd.insert(values.begin(), values.end(), 4);
+  BOOST_TEST_REQUIRE(pd.size() == values.size());
+//  Range sharding puts each quarter of the values in its own shard.
+  for (std::size_t i = 0; i < pd.shards(); ++i)
+  {
+    BOOST_TEST_REQUIRE(!pd.shard(i).empty());
+    BOOST_TEST_REQUIRE(pd.shard(i).minimum() >= static_cast<int>(i) * 250);
+    BOOST_TEST_REQUIRE(pd.shard(i).maximum() < static_cast<int>(i + 1) * 250);
+  }
+  BOOST_TEST_REQUIRE(pd.minimum() == *std::min_element(values.begin(), values.end()));
+  pd.for_each_shard(add_to_shard(), 3);
+  BOOST_TEST_REQUIRE(pd.size() == values.size() + 400);
+  BOOST_TEST_REQUIRE(pd.maximum() == 3099);
+  pd.pop_maximum();
+  BOOST_TEST_REQUIRE(pd.maximum() == 3098);
+  pd.clear();
+  BOOST_TEST_REQUIRE(pd.empty());
+}
@@ -0,0 +1,169 @@
+#include "../stable_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace
+{
+struct Job
+{
+  int priority;
+  int id;
+};
+
+struct JobLess
+{
+  bool operator() (Job const & lhs, Job const & rhs) const
+  {
+    return lhs.priority < rhs.priority;
+  }
+};
+
+//  Exposes the next stamp, so that re-stamping may be forced.
+template <typename T, typename C>
+struct ExposedStableDeque : public boost::container::stable_priority_deque<T, C>
+{
+  typedef boost::container::stable_priority_deque<T, C> base_type;
+  typename base_type::stamp_type & stamp (void) { return base_type::next_stamp(); }
+};
+
+//  Pushes random values with few distinct priorities, then checks that they
+//  leave the deque in order.
+template <typename Deque, typename Compare>
+void check_order (Deque & pd, Compare compare, int count, bool from_min)
+{
+  for (int i = 0; i < count; ++i)
+    pd.push((rand() % 7) - 3);
+  BOOST_TEST_REQUIRE(pd.size() == static_cast<std::size_t>(count));
+  while (!pd.empty())
+  {
+    int value = from_min ? pd.minimum() : pd.maximum();
+    if (from_min)
+      pd.pop_minimum();
+    else
+      pd.pop_maximum();
+    if (!pd.empty())
+    {
+      int next = from_min ? pd.minimum() : pd.maximum();
+      BOOST_TEST_REQUIRE(!(from_min ? compare(next, value) : compare(value, next)));
+    }
+  }
+}
+
+//  Pushes jobs with few distinct priorities, then checks that jobs of equal
+//  priority leave in order of insertion (or in reverse, from the maximum end).
+template <typename Deque>
+void check_stable_order (Deque & pd, int count)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    Job job = { rand() % 5, i };
+    pd.push(job);
+  }
+  BOOST_TEST_REQUIRE(pd.size() == static_cast<std::size_t>(count));
+
+//  First-in, first-out among equal priorities at the minimum end...
+  int last_priority = -1, last_id = -1;
+  for (int i = 0; i < count / 2; ++i)
+  {
+    Job job = pd.minimum();
+    pd.pop_minimum();
+    BOOST_TEST_REQUIRE(job.priority >= last_priority);
+    if (job.priority == last_priority)
+      BOOST_TEST_REQUIRE(job.id > last_id);
+    last_priority = job.priority;
+    last_id = job.id;
+  }
+//  ... and last-in, first-out at the maximum end.
+  last_priority = 5;
+  last_id = count;
+  while (!pd.empty())
+  {
+    Job job = pd.top();
+    pd.pop();
+    BOOST_TEST_REQUIRE(job.priority <= last_priority);
+    if (job.priority == last_priority)
+      BOOST_TEST_REQUIRE(job.id < last_id);
+    last_priority = job.priority;
+    last_id = job.id;
+  }
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( stable_priority_deque_generic )
+{
+  using namespace boost::container;
+  stable_priority_deque<Job, JobLess> pd;
+  BOOST_TEST_REQUIRE(pd.empty());
+  check_stable_order(pd, 313);
+  check_stable_order(pd, 2);
+  check_stable_order(pd, 517);
+}
+
+BOOST_AUTO_TEST_CASE( stable_priority_deque_packed )
+{
+  using namespace boost::container;
+  {
+    stable_priority_deque<int> pd;
+    check_order(pd, std::less<int>(), 517, true);
+    check_order(pd, std::less<int>(), 517, false);
+  }
+  {
+    stable_priority_deque<int, std::greater<int> > pd;
+    check_order(pd, std::greater<int>(), 517, true);
+    check_order(pd, std::greater<int>(), 517, false);
+  }
+  {
+    stable_priority_deque<short> pd;
+    pd.push(-32768);
+    pd.push(32767);
+    pd.push(0);
+    BOOST_TEST_REQUIRE(pd.minimum() == -32768);
+    BOOST_TEST_REQUIRE(pd.maximum() == 32767);
+  }
+  {
+    stable_priority_deque<unsigned, std::greater<unsigned> > pd;
+    pd.push(0u);
+    pd.push(4294967295u);
+    BOOST_TEST_REQUIRE(pd.minimum() == 4294967295u);
+    BOOST_TEST_REQUIRE(pd.maximum() == 0u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( stable_priority_deque_restamp )
+{
+  using namespace boost::container;
+  {
+    ExposedStableDeque<int, std::less<int> > pd;
+    check_order(pd, std::less<int>(), 100, true);
+//  Push across the limit of a 32-bit stamp, forcing the deque to renumber.
+    pd.stamp() = 0xFFFFFFFFu - 50;
+    check_order(pd, std::less<int>(), 100, false);
+    BOOST_TEST_REQUIRE(pd.stamp() < 0xFFFFFFFFu);
+    pd.stamp() = 0xFFFFFFFFu - 50;
+    check_order(pd, std::less<int>(), 100, true);
+  }
+  {
+//  Generic stamps are 64-bit.
+    ExposedStableDeque<Job, JobLess> pd;
+    pd.stamp() = ~static_cast<ExposedStableDeque<Job, JobLess>::stamp_type>(0) - 50;
+    check_stable_order(pd, 313);
+    BOOST_TEST_REQUIRE(pd.stamp() == 313u);
+  }
+  {
+    ExposedStableDeque<signed char, std::greater<signed char> > pd;
+    for (int i = 0; i < 50; ++i)
+      pd.push(static_cast<signed char>(i % 3));
+    typedef ExposedStableDeque<signed char, std::greater<signed char> >::stamp_type stamp_type;
+    pd.stamp() = (static_cast<stamp_type>(1) << 56) - 10;
+    for (int i = 50; i < 100; ++i)
+      pd.push(static_cast<signed char>(i % 3));
+    BOOST_TEST_REQUIRE(pd.stamp() == 100u);
+    BOOST_TEST_REQUIRE(pd.size() == 100u);
+    BOOST_TEST_REQUIRE(pd.minimum() == 2);
+    BOOST_TEST_REQUIRE(pd.maximum() == 0);
+  }
+}
@@ -0,0 +1,106 @@
+#include "../string_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+//  Random strings that often share long prefixes, and contain bytes above 127.
+std::string random_key (void)
+{
+  static const char * const stems[] = { "", "a", "https://", "https://www.example.", "\xc3\xa9t\xc3\xa9" };
+  std::string key = stems[rand() % 5];
+  for (int length = rand() % 20; length--;)
+    key.push_back(static_cast<char>("ab\x00\xff"[rand() % 4]));
+  return key;
+}
+
+struct Record
+{
+  std::string name;
+  int id;
+};
+
+struct RecordName
+{
+  typedef std::string const & result_type;
+  std::string const & operator() (Record const & record) const { return record.name; }
+};
+
+template <typename Deque, typename Compare>
+void check_drain (Deque & pd, std::multiset<std::string, Compare> expected)
+{
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() == *expected.begin());
+    expected.erase(expected.begin());
+    pd.pop_minimum();
+    if (pd.empty())
+      break;
+    typename std::multiset<std::string, Compare>::iterator last = expected.end();
+    --last;
+    BOOST_TEST_REQUIRE(pd.maximum() == *last);
+    expected.erase(last);
+    pd.pop_maximum();
+  }
+  BOOST_TEST_REQUIRE(expected.empty());
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( string_priority_deque_order )
+{
+  using namespace boost::container;
+  std::vector<std::string> keys;
+  for (int i = 0; i < 517; ++i)
+    keys.push_back(random_key());
+
+  {
+    string_priority_deque<> pd;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      pd.push(keys[i]);
+    BOOST_TEST_REQUIRE((static_cast<std::size_t>(pd.end() - pd.begin()) == keys.size()));
+    check_drain(pd, std::multiset<std::string>(keys.begin(), keys.end()));
+  }
+  {
+    string_priority_deque<std::string, string_identity, std::greater<std::string>, 8> pd (keys.begin(), keys.end());
+    check_drain(pd, std::multiset<std::string, std::greater<std::string> >(keys.begin(), keys.end()));
+  }
+  {
+    string_priority_deque<std::string, string_identity, std::less<std::string>, 24> pd (keys.begin(), keys.end());
+    std::multiset<std::string> expected (keys.begin(), keys.end());
+    expected.erase(expected.find(*(pd.begin() + 3)));
+    pd.erase(pd.begin() + 3);
+    expected.erase(expected.find(*(pd.begin() + 9)));
+    const std::string greatest (40, '\xff');
+    pd.update(pd.begin() + 9, greatest);
+    expected.insert(greatest);
+    BOOST_TEST_REQUIRE(pd.maximum() == greatest);
+    check_drain(pd, expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( string_priority_deque_key_extractor )
+{
+  using namespace boost::container;
+  string_priority_deque<Record, RecordName> pd;
+  std::multiset<std::string> expected;
+  for (int i = 0; i < 313; ++i)
+  {
+    Record record;
+    record.name = random_key();
+    record.id = i;
+    expected.insert(record.name);
+    pd.push(record);
+  }
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE(pd.top().name == *expected.rbegin());
+    expected.erase(--expected.end());
+    pd.pop();
+  }
+}
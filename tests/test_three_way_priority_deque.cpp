@@ -0,0 +1,131 @@
+#include <boost/test/unit_test.hpp>
+
+//  Built as C++20, by a test target of its own.
+#if (__cplusplus > 201703L)
+#include "../priority_deque.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <vector>
+
+namespace {
+typedef boost::container::priority_deque<int, std::vector<int>,
+                                         std::compare_three_way> three_way_pd;
+
+//  Pops alternately from both ends, checking against a sorted reference.
+void drain_and_check (three_way_pd & pd, std::multiset<int> existing_elements)
+{
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::compare_three_way()));
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<int>()));
+  BOOST_TEST_REQUIRE(pd.size() == existing_elements.size());
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() == *existing_elements.begin());
+    existing_elements.erase(existing_elements.begin());
+    pd.pop_minimum();
+    if (pd.empty())
+      break;
+    BOOST_TEST_REQUIRE(pd.maximum() == *existing_elements.rbegin());
+    existing_elements.erase(--existing_elements.end());
+    pd.pop_maximum();
+  }
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( three_way_standard_comparison )
+{
+  BOOST_TEST_REQUIRE((boost::heap::is_three_way_compare<std::compare_three_way, int>::value));
+  BOOST_TEST_REQUIRE(!(boost::heap::is_three_way_compare<std::less<int>, int>::value));
+}
+
+BOOST_AUTO_TEST_CASE( three_way_push_update_erase )
+{
+  three_way_pd pd;
+  std::multiset<int> existing_elements;
+  for (int i = 0; i < 2000; ++i)
+  {
+    int pushed = rand() % 5;
+    existing_elements.insert(pushed);
+    pd.push(pushed);
+  }
+  for (int i = 0; i < 200; ++i)
+  {
+    three_way_pd::const_iterator it = pd.begin() + rand() % pd.size();
+    existing_elements.erase(existing_elements.find(*it));
+    int updated = rand() % 7 - 1;
+    existing_elements.insert(updated);
+    pd.update(it, updated);
+  }
+  for (int i = 0; i < 100; ++i)
+  {
+    three_way_pd::const_iterator it = pd.begin() + rand() % pd.size();
+    existing_elements.erase(existing_elements.find(*it));
+    pd.erase(it);
+  }
+  drain_and_check(pd, existing_elements);
+}
+
+BOOST_AUTO_TEST_CASE( three_way_range_constructor_and_insert )
+{
+  std::vector<int> values;
+  for (int i = 0; i < 3000; ++i)
+    values.push_back(rand() % 100);
+  std::multiset<int> existing_elements (values.begin(), values.end());
+
+  three_way_pd constructed (values.begin(), values.end());
+  drain_and_check(constructed, existing_elements);
+
+  three_way_pd inserted;
+  inserted.push(7);
+  existing_elements.insert(7);
+  inserted.insert(values.begin(), values.end());
+  drain_and_check(inserted, existing_elements);
+
+//  Sorted input takes the comparison-free path.
+  std::vector<int> sorted (existing_elements.begin(), existing_elements.end());
+  three_way_pd from_sorted (sorted.begin(), sorted.end());
+  drain_and_check(from_sorted, existing_elements);
+}
+
+BOOST_AUTO_TEST_CASE( three_way_merge )
+{
+  std::multiset<int> existing_elements;
+  three_way_pd pd, other;
+  std::vector<int> values;
+  for (int i = 0; i < 1500; ++i)
+  {
+    int value = rand() % 50;
+    existing_elements.insert(value);
+    if (i & 1)
+      pd.push(value);
+    else
+      values.push_back(value);
+  }
+  pd.merge(values.begin(), values.end());
+  for (int i = 0; i < 700; ++i)
+  {
+    int value = rand() % 50;
+    existing_elements.insert(value);
+    other.push(value);
+  }
+  pd.merge(std::move(other));
+  BOOST_TEST_REQUIRE(other.empty());
+  drain_and_check(pd, existing_elements);
+}
+
+BOOST_AUTO_TEST_CASE( three_way_interval_heap_functions )
+{
+  std::vector<int> values;
+  for (int i = 0; i < 1000; ++i)
+    values.push_back(rand() % 30);
+  boost::heap::make_interval_heap(values.begin(), values.end(), std::compare_three_way());
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(values.begin(), values.end(), std::compare_three_way()));
+  BOOST_TEST_REQUIRE((boost::heap::is_interval_heap_until(values.begin(), values.end(), std::compare_three_way()) == values.end()));
+  boost::heap::sort_interval_heap(values.begin(), values.end(), std::compare_three_way());
+  BOOST_TEST_REQUIRE(std::is_sorted(values.begin(), values.end()));
+}
+#endif
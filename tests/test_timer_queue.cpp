@@ -0,0 +1,133 @@
+#include "../timer_queue.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( timer_queue_expire )
+{
+  using namespace boost::container;
+  typedef timer_queue<int> queue_t;
+  queue_t timers;
+  std::vector<int> fired;
+//  Expected deadline of each pending timer, by token.
+  std::map<queue_t::token_type, int> expected;
+  for (int i = 0; i < 3000; ++i)
+  {
+    const int deadline = rand() % 1000;
+    queue_t::token_type token = timers.schedule(deadline,
+                                  [&fired, deadline]() {
+                                    fired.push_back(deadline);
+                                  });
+    expected[token] = deadline;
+  }
+  int cancelled = 0;
+  for (queue_t::token_type token = 1; token <= 3000; token += 7)
+  {
+    BOOST_TEST_REQUIRE(timers.cancel(token));
+    BOOST_TEST_REQUIRE(!timers.pending(token));
+    BOOST_TEST_REQUIRE(!timers.cancel(token));
+    expected.erase(token);
+    ++cancelled;
+  }
+//  Rescheduled timers keep their callbacks, which report the old deadline.
+  for (queue_t::token_type token = 2; token <= 3000; token += 11)
+    if (timers.reschedule(token, 2000))
+      expected[token] = 2000;
+  BOOST_TEST_REQUIRE(timers.size() == expected.size());
+  BOOST_TEST_REQUIRE(timers.latest_deadline() == 2000);
+
+  std::size_t expired = 0;
+  for (int now = 0; now < 1000; now += 10)
+  {
+    fired.clear();
+    const std::size_t count = timers.expire_until(now);
+    BOOST_TEST_REQUIRE(count == fired.size());
+    expired += count;
+    for (std::size_t i = 0; i < fired.size(); ++i)
+    {
+      BOOST_TEST_REQUIRE(fired[i] <= now);
+      BOOST_TEST_REQUIRE(fired[i] > now - 10);
+    }
+    if (!timers.empty())
+      BOOST_TEST_REQUIRE(timers.next_deadline() > now);
+  }
+  std::size_t still_pending = 0;
+  for (std::map<queue_t::token_type, int>::iterator it = expected.begin();
+       it != expected.end(); ++it)
+    if (it->second > 990)
+      ++still_pending;
+  BOOST_TEST_REQUIRE(timers.size() == still_pending);
+  BOOST_TEST_REQUIRE(expired + still_pending + cancelled == 3000u);
+}
+
+BOOST_AUTO_TEST_CASE( timer_queue_callbacks )
+{
+  using namespace boost::container;
+  timer_queue<int> timers;
+  std::vector<int> order;
+//  Equal deadlines expire in the order they were scheduled.
+  for (int i = 0; i < 5; ++i)
+    timers.schedule(10, [&order, i]() { order.push_back(i); });
+//  A callback may schedule another timer, which waits for a later call.
+  timers.schedule(5, [&]() {
+    order.push_back(-1);
+    timers.schedule(0, [&order]() { order.push_back(-2); });
+  });
+  BOOST_TEST_REQUIRE(timers.expire_until(10) == 6u);
+  BOOST_TEST_REQUIRE(order.size() == 6u);
+  BOOST_TEST_REQUIRE(order[0] == -1);
+  for (int i = 0; i < 5; ++i)
+    BOOST_TEST_REQUIRE(order[i + 1] == i);
+  BOOST_TEST_REQUIRE(timers.size() == 1u);
+  BOOST_TEST_REQUIRE(timers.expire_until(10) == 1u);
+  BOOST_TEST_REQUIRE(order.back() == -2);
+
+//  Shedding takes the latest deadline, without running it.
+  int ran = 0;
+  timers.schedule(1, [&ran]() { ran += 1; });
+  timers.schedule(100, [&ran]() { ran += 100; });
+  std::function<void()> shed = timers.shed_latest();
+  BOOST_TEST_REQUIRE(ran == 0);
+  BOOST_TEST_REQUIRE(timers.latest_deadline() == 1);
+  shed();
+  BOOST_TEST_REQUIRE(ran == 100);
+  unsigned passed = 0;
+  timers.expire_until(50, [&passed](std::function<void()> & callback) {
+    callback();
+    ++passed;
+  });
+  BOOST_TEST_REQUIRE(passed == 1u);
+  BOOST_TEST_REQUIRE(ran == 101);
+  BOOST_TEST_REQUIRE(timers.empty());
+}
+
+BOOST_AUTO_TEST_CASE( timer_queue_throwing_callback )
+{
+  using namespace boost::container;
+  timer_queue<int> timers;
+  std::vector<int> order;
+  std::vector<timer_queue<int>::token_type> tokens;
+  for (int i = 0; i < 5; ++i)
+    tokens.push_back(timers.schedule(i, [&order, i]() {
+      order.push_back(i);
+      if (i == 2)
+        throw std::runtime_error("callback failed");
+    }));
+  BOOST_CHECK_THROW(timers.expire_until(10), std::runtime_error);
+  BOOST_TEST_REQUIRE(order.size() == 3u);
+//  Timers after the one that threw are pending again, with the same tokens.
+  BOOST_TEST_REQUIRE(timers.size() == 2u);
+  BOOST_TEST_REQUIRE(!timers.pending(tokens[2]));
+  BOOST_TEST_REQUIRE(timers.pending(tokens[3]));
+  BOOST_TEST_REQUIRE(timers.pending(tokens[4]));
+  BOOST_TEST_REQUIRE(timers.next_deadline() == 3);
+  BOOST_TEST_REQUIRE(timers.expire_until(10) == 2u);
+  BOOST_TEST_REQUIRE(order.size() == 5u);
+  BOOST_TEST_REQUIRE(order[3] == 3);
+  BOOST_TEST_REQUIRE(order[4] == 4);
+}
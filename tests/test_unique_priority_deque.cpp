@@ -0,0 +1,114 @@
+#include "../unique_priority_deque.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace
+{
+typedef std::pair<int, std::string> ScoredUrl;
+
+struct UrlOf
+{
+  std::string const & operator() (ScoredUrl const & value) const { return value.second; }
+};
+
+//  Checks the deque against a map from keys to best scores.
+template <typename Deque>
+void check_against (Deque & pd, std::map<std::string, int> const & best)
+{
+  BOOST_TEST_REQUIRE(pd.size() == best.size());
+  BOOST_TEST_REQUIRE(boost::heap::is_interval_heap(pd.begin(), pd.end(), std::less<ScoredUrl>()));
+  for (std::map<std::string, int>::const_iterator it = best.begin(); it != best.end(); ++it)
+  {
+    BOOST_TEST_REQUIRE(pd.contains(it->first));
+    BOOST_TEST_REQUIRE(pd.find(it->first)->first == it->second);
+  }
+}
+} //  Namespace
+
+BOOST_AUTO_TEST_CASE( unique_priority_deque_push_keeps_better )
+{
+  using namespace boost::container;
+  unique_priority_deque<ScoredUrl, UrlOf> pd;
+  std::map<std::string, int> best;
+  for (int i = 0; i < 3000; ++i)
+  {
+    std::string url = "https://example.com/" + std::to_string(rand() % 500);
+    int score = rand() % 1000;
+    std::map<std::string, int>::iterator it = best.find(url);
+    const bool improves = (it == best.end()) || (it->second < score);
+    BOOST_TEST_REQUIRE(pd.push(ScoredUrl(score, url)) == improves);
+    if (improves)
+      best[url] = score;
+  }
+  check_against(pd, best);
+  BOOST_TEST_REQUIRE(!pd.contains("https://example.com/missing"));
+  BOOST_TEST_REQUIRE(pd.find("https://example.com/missing") == nullptr);
+
+//  Replacing lowers a score; erasing removes a key.
+  std::string lowered = best.begin()->first;
+  BOOST_TEST_REQUIRE(!pd.update(ScoredUrl(-1, lowered)));
+  best[lowered] = -1;
+  BOOST_TEST_REQUIRE(pd.minimum().second == lowered);
+  std::string erased = best.rbegin()->first;
+  BOOST_TEST_REQUIRE(pd.erase(erased));
+  BOOST_TEST_REQUIRE(!pd.erase(erased));
+  best.erase(erased);
+  check_against(pd, best);
+
+//  Copies have their own index.
+  unique_priority_deque<ScoredUrl, UrlOf> copy (pd);
+  pd.clear();
+  BOOST_TEST_REQUIRE(pd.empty());
+  BOOST_TEST_REQUIRE(!pd.contains(lowered));
+  check_against(copy, best);
+
+//  Pops remove keys, and yield elements in order from both ends.
+  int last_min = -2, last_max = 1000;
+  while (!copy.empty())
+  {
+    ScoredUrl low = copy.minimum();
+    copy.pop_minimum();
+    BOOST_TEST_REQUIRE(!copy.contains(low.second));
+    BOOST_TEST_REQUIRE(low.first >= last_min);
+    last_min = low.first;
+    best.erase(low.second);
+    if (copy.empty())
+      break;
+    ScoredUrl high = copy.top();
+    copy.pop();
+    BOOST_TEST_REQUIRE(!copy.contains(high.second));
+    BOOST_TEST_REQUIRE(high.first <= last_max);
+    last_max = high.first;
+    best.erase(high.second);
+    check_against(copy, best);
+  }
+  BOOST_TEST_REQUIRE(best.empty());
+}
+
+BOOST_AUTO_TEST_CASE( unique_priority_deque_identity )
+{
+  using namespace boost::container;
+  unique_priority_deque<int> pd;
+  for (int i = 0; i < 1000; ++i)
+    pd.push(rand() % 100);
+  BOOST_TEST_REQUIRE(pd.size() <= 100u);
+  for (int i = 0; i < 100; i += 2)
+    pd.erase(i);
+  int previous = -1;
+  while (!pd.empty())
+  {
+    BOOST_TEST_REQUIRE(pd.minimum() % 2 == 1);
+    BOOST_TEST_REQUIRE(pd.minimum() > previous);
+    previous = pd.minimum();
+    pd.pop_minimum();
+  }
+  unique_priority_deque<int> moved (std::move(pd));
+  moved.push(4);
+  moved.push(4);
+  BOOST_TEST_REQUIRE(moved.size() == 1u);
+}
@@ -0,0 +1,63 @@
+#include "../work_stealing_scheduler.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE( work_stealing_scheduler_order )
+{
+  using namespace boost::container;
+  work_stealing_scheduler<int> scheduler (1);
+  std::atomic<bool> release (false);
+  std::vector<int> order;
+//  The worker is held while the rest are queued, so they run by priority.
+  scheduler.submit(100, [&release]() {
+    while (!release)
+      std::this_thread::yield();
+  });
+  for (int i = 0; i < 50; ++i)
+  {
+    const int priority = (i * 7) % 50;
+    scheduler.submit(priority, [&order, priority]() {
+      order.push_back(priority);
+    });
+  }
+  release = true;
+  scheduler.wait();
+  BOOST_TEST_REQUIRE(order.size() == 50u);
+  for (int i = 0; i < 50; ++i)
+    BOOST_TEST_REQUIRE(order[i] == 49 - i);
+}
+
+BOOST_AUTO_TEST_CASE( work_stealing_scheduler_steal )
+{
+  using namespace boost::container;
+  work_stealing_scheduler<int> scheduler (3);
+  std::atomic<int> ran (0);
+  std::atomic<bool> finished (false);
+//  Tasks submitted from within a task stay with its worker, which then waits
+//  for them; only thieves can run them.
+  scheduler.submit(0, [&]() {
+    for (int i = 0; i < 1000; ++i)
+      scheduler.submit(i, [&ran]() { ++ran; });
+    const std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while ((ran < 1000) && (std::chrono::steady_clock::now() < deadline))
+      std::this_thread::yield();
+    finished = (ran == 1000);
+  });
+  scheduler.wait();
+  BOOST_TEST_REQUIRE(finished);
+  BOOST_TEST_REQUIRE(scheduler.steals() > 0u);
+  BOOST_TEST_REQUIRE(scheduler.stolen() >= 1000u);
+
+  scheduler.submit(1, []() { throw std::runtime_error("task failed"); });
+  scheduler.submit(2, [&ran]() { ++ran; });
+  BOOST_CHECK_THROW(scheduler.wait(), std::runtime_error);
+  BOOST_TEST_REQUIRE(ran == 1001);
+  scheduler.wait();
+}
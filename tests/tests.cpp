@@ -1,5 +1,25 @@
 #include "../priority_deque.hpp"
+#include "../projected_priority_deque.hpp"
+#include "../normalized_priority_deque.hpp"
+#include "../string_priority_deque.hpp"
+#include "../incremental_priority_deque.hpp"
+#if (__cplusplus >= 201103L)
+#include "../counted_priority_deque.hpp"
+#include "../async_priority_deque.hpp"
+#include "../timer_queue.hpp"
+#include "timing_wheel.hpp"
+#include "graph_search.hpp"
+#include "../work_stealing_scheduler.hpp"
+#include "../batched_priority_deque.hpp"
+#include "../sharded_priority_deque.hpp"
+#include "../published_priority_deque.hpp"
+#include "../cow_vector.hpp"
+#endif
+#if (__cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+#include "../awaitable_priority_deque.hpp"
+#endif
 #include "priority_deque_verify.hpp"
+#include "event_simulation.hpp"
 
 #include <vector>
 #include <queue>
@@ -7,6 +27,19 @@
 #include <stdint.h>
 #include <time.h>
 #include <algorithm>
+#include <iterator>
+#include <string>
+#if (__cplusplus >= 201103L)
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+#if (__cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <exception>
+#endif
 
 int main();
 
@@ -38,6 +71,941 @@ void benchmark_priority_queue (unsigned benchmark_elements) {
   std::cout << ", Pop: " << (bench_end - bench_mid) << " (" << static_cast<double>(bench_end - bench_mid) / CLOCKS_PER_SEC << "s)\n";
 }
 
+//  Equivalent to std::less, but not recognized as such by interval_heap.hpp.
+template <typename T>
+struct opaque_less
+{
+  bool operator() (T const & lhs, T const & rhs) const { return lhs < rhs; }
+};
+
+//  Compares bulk-loading with and without the branch-free leaf pass.
+template <typename T>
+void benchmark_bulk_load (unsigned benchmark_elements) {
+  std::vector<T> original, v;
+  clock_t bench_begin, bench_end;
+  for (unsigned n = benchmark_elements; n--;)
+    original.push_back(static_cast<T>(rand()));
+  std::cout << benchmark_elements << " elements: ";
+
+  v = original;
+  bench_begin = clock();
+  boost::heap::make_interval_heap(v.begin(), v.end(), opaque_less<T>());
+  bench_end = clock();
+  std::cout << "Generic: " << (bench_end - bench_begin) << " (" << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s)";
+
+  v = original;
+  bench_begin = clock();
+  boost::heap::make_interval_heap(v.begin(), v.end(), std::less<T>());
+  bench_end = clock();
+  std::cout << ", std::less: " << (bench_end - bench_begin) << " (" << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s)\n";
+}
+
+//  Compares in-place heap-sorting with std::sort and std::sort_heap.
+template <typename T>
+void benchmark_sort (unsigned benchmark_elements) {
+  std::vector<T> original, v;
+  clock_t bench_begin, bench_end;
+  for (unsigned n = benchmark_elements; n--;)
+    original.push_back(static_cast<T>(rand()));
+  std::cout << benchmark_elements << " elements: ";
+
+  v = original;
+  bench_begin = clock();
+  std::sort(v.begin(), v.end());
+  bench_end = clock();
+  std::cout << "std::sort: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+
+  v = original;
+  std::make_heap(v.begin(), v.end());
+  bench_begin = clock();
+  std::sort_heap(v.begin(), v.end());
+  bench_end = clock();
+  std::cout << ", std::sort_heap: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+
+  v = original;
+  boost::heap::make_interval_heap(v.begin(), v.end(), std::less<T>());
+  bench_begin = clock();
+  boost::heap::sort_interval_heap(v.begin(), v.end(), std::less<T>());
+  bench_end = clock();
+  std::cout << ", sort_interval_heap: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+
+  v = original;
+  boost::heap::make_interval_heap(v.begin(), v.end(), std::less<T>());
+  bench_begin = clock();
+  boost::heap::sort_interval_heap_double_ended(v.begin(), v.end(), std::less<T>());
+  bench_end = clock();
+  std::cout << ", double-ended: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s\n";
+}
+
+//  Elements whose priority is reached through two indirections.
+struct indirect_priority { int priority; };
+struct indirect_node { indirect_priority * data; };
+struct indirect_key
+{
+  typedef int result_type;
+  int operator() (indirect_node const * node) const
+  {
+    return node->data->priority;
+  }
+};
+struct indirect_less
+{
+  bool operator() (indirect_node const * lhs, indirect_node const * rhs) const
+  {
+    return lhs->data->priority < rhs->data->priority;
+  }
+};
+
+//  Compares chasing pointers in every comparison with caching projected keys.
+template <typename pq_t>
+void benchmark_indirect (std::vector<indirect_node *> const & nodes) {
+  pq_t pq;
+  clock_t bench_begin, bench_end;
+  bench_begin = clock();
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+    pq.push(nodes[i]);
+  while (!pq.empty())
+    pq.pop_minimum();
+  bench_end = clock();
+  std::cout << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+}
+
+void benchmark_indirect (unsigned benchmark_elements) {
+  using boost::container::priority_deque;
+  using boost::container::projected_priority_deque;
+//  Scatter the objects, so that following a pointer is likely a cache miss.
+  std::vector<indirect_priority> data (benchmark_elements);
+  std::vector<indirect_node> storage (benchmark_elements);
+  std::vector<indirect_node *> nodes;
+  for (unsigned i = 0; i < benchmark_elements; ++i)
+  {
+    data[i].priority = rand();
+    nodes.push_back(&storage[i]);
+  }
+  std::random_shuffle(nodes.begin(), nodes.end());
+  for (unsigned i = 0; i < benchmark_elements; ++i)
+    nodes[i]->data = &data[(i * 7919u) % benchmark_elements];
+  std::random_shuffle(nodes.begin(), nodes.end());
+
+  std::cout << benchmark_elements << " elements: Comparator: ";
+  benchmark_indirect<priority_deque<indirect_node *, std::vector<indirect_node *>, indirect_less> >(nodes);
+  std::cout << ", Projection: ";
+  benchmark_indirect<projected_priority_deque<indirect_node *, indirect_key, std::less<int>, false> >(nodes);
+  std::cout << ", Cached projection: ";
+  benchmark_indirect<projected_priority_deque<indirect_node *, indirect_key> >(nodes);
+  std::cout << "\n";
+}
+
+//  Compares plain and normalized storage of the same keys, when bulk-loaded
+//  then drained.
+template <typename pq_t, typename T>
+void benchmark_keys (std::vector<T> const & values) {
+  pq_t pq;
+  clock_t bench_begin, bench_mid, bench_end;
+  bench_begin = clock();
+  pq.insert(values.begin(), values.end());
+  bench_mid = clock();
+  while (!pq.empty())
+    pq.pop_minimum();
+  bench_end = clock();
+  std::cout << "Load: " << static_cast<double>(bench_mid - bench_begin) / CLOCKS_PER_SEC << "s, Drain: " << static_cast<double>(bench_end - bench_mid) / CLOCKS_PER_SEC << "s";
+}
+
+template <typename T>
+void benchmark_normalized (std::vector<T> const & values) {
+  std::cout << values.size() << " elements: Plain: ";
+  benchmark_keys<boost::container::priority_deque<T> >(values);
+  std::cout << "; Normalized: ";
+  benchmark_keys<boost::container::normalized_priority_deque<T> >(values);
+  std::cout << "\n";
+}
+
+//  Compares plain and prefix-cached string keys, using URL-like strings.
+template <typename pq_t>
+void benchmark_strings (std::vector<std::string> const & keys) {
+  pq_t pq;
+  clock_t bench_begin, bench_end;
+  bench_begin = clock();
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    pq.push(keys[i]);
+  while (!pq.empty())
+    pq.pop_minimum();
+  bench_end = clock();
+  std::cout << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+}
+
+void benchmark_strings (unsigned benchmark_elements, bool few_hosts) {
+  static const char * const hosts[] = { "www.example.com", "docs.example.org", "cdn.static-assets.net", "api.service.io", "blog.example.com", "www.test.org" };
+  std::vector<std::string> keys;
+  for (unsigned n = benchmark_elements; n--;)
+  {
+    std::string key = "https://";
+    if (few_hosts)
+      key += hosts[rand() % 6];
+    else
+    {
+      for (int length = 4 + rand() % 8; length--;)
+        key.push_back(static_cast<char>('a' + rand() % 26));
+      key += ".com";
+    }
+    key += "/items/";
+    for (int depth = 3; depth--;)
+    {
+      key.push_back(static_cast<char>('a' + rand() % 26));
+      key.push_back(static_cast<char>('a' + rand() % 26));
+      key.push_back('/');
+    }
+    keys.push_back(key);
+  }
+  std::cout << benchmark_elements << " elements: Plain: ";
+  benchmark_strings<boost::container::priority_deque<std::string> >(keys);
+  std::cout << ", Prefix (16 bytes): ";
+  benchmark_strings<boost::container::string_priority_deque<> >(keys);
+  std::cout << ", Prefix (32 bytes): ";
+  benchmark_strings<boost::container::string_priority_deque<std::string, boost::container::string_identity, std::less<std::string>, 32> >(keys);
+  std::cout << "\n";
+}
+
+//  Pushes timestamp-like keys, which are mostly new maxima.
+template <typename T>
+void benchmark_monotone (std::vector<T> const & keys) {
+  boost::container::priority_deque<T> pq;
+  clock_t bench_begin, bench_end;
+  bench_begin = clock();
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    pq.push(keys[i]);
+  bench_end = clock();
+  std::cout << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s (" << pq.monotone_pushes() << " at root)";
+}
+
+intmax_t identity_key (intmax_t key) { return key; }
+
+//  Formats a key as a log-style timestamp, which is costly to compare.
+std::string format_stamp (intmax_t key) {
+  std::string stamp = "2013-01-01T";
+  for (intmax_t place = 100000000000LL; place != 0; place /= 10)
+    stamp.push_back(static_cast<char>('0' + (key / place) % 10));
+  return stamp;
+}
+
+template <typename T>
+void benchmark_monotone (unsigned benchmark_elements, T (*make_key)(intmax_t)) {
+  std::vector<T> increasing, nearly, random;
+  for (unsigned n = 0; n < benchmark_elements; ++n)
+  {
+    increasing.push_back(make_key(n));
+//  Late arrivals: most keys are new maxima, but some fall slightly behind.
+    nearly.push_back(make_key(static_cast<intmax_t>(n) - ((rand() % 8 == 0) ? rand() % 64 : 0)));
+    random.push_back(make_key(rand()));
+  }
+  std::cout << benchmark_elements << " elements: Increasing: ";
+  benchmark_monotone(increasing);
+  std::cout << ", Nearly increasing: ";
+  benchmark_monotone(nearly);
+  std::cout << ", Random: ";
+  benchmark_monotone(random);
+  std::cout << "\n";
+}
+
+//  A strcmp-style comparison of strings, marked as three-way below.
+struct string_three_way {
+  int operator() (std::string const & lhs, std::string const & rhs) const {
+    return lhs.compare(rhs);
+  }
+};
+namespace boost {
+namespace heap {
+template <>
+struct is_three_way_compare<string_three_way, std::string> {
+  static const bool value = true;
+};
+} //  Namespace heap
+} //  Namespace boost
+
+//  Counts assignments, to measure how far sifted elements travel.
+struct counted_key {
+  static unsigned long assignments;
+  int key;
+  counted_key (int k = 0) : key(k) {}
+  counted_key (counted_key const & other) : key(other.key) {}
+  counted_key & operator= (counted_key const & other) {
+    ++assignments;
+    key = other.key;
+    return *this;
+  }
+  bool operator< (counted_key const & other) const { return key < other.key; }
+};
+unsigned long counted_key::assignments = 0;
+struct counted_three_way {
+  int operator() (counted_key const & lhs, counted_key const & rhs) const {
+    return (lhs.key > rhs.key) - (lhs.key < rhs.key);
+  }
+};
+namespace boost {
+namespace heap {
+template <>
+struct is_three_way_compare<counted_three_way, counted_key> {
+  static const bool value = true;
+};
+} //  Namespace heap
+} //  Namespace boost
+
+template <typename pq_t>
+void benchmark_ties (std::vector<int> const & values) {
+  pq_t pq;
+  counted_key::assignments = 0;
+  for (std::size_t i = 0; i < values.size(); ++i)
+    pq.push(counted_key(values[i]));
+  while (!pq.empty())
+    pq.pop_minimum();
+  std::cout << counted_key::assignments << " moves";
+}
+
+//  Compares "less-than" and three-way comparisons when there are few distinct
+//  keys. Three-way comparisons let sifts stop at ties.
+void benchmark_ties (unsigned benchmark_elements, unsigned distinct) {
+  std::vector<int> values;
+  std::vector<std::string> keys;
+  for (unsigned n = benchmark_elements; n--;)
+  {
+    values.push_back(rand() % distinct);
+    keys.push_back("https://www.example.com/items/" + std::string(1, static_cast<char>('a' + values.back())));
+  }
+  std::cout << benchmark_elements << " elements, " << distinct << " distinct: Less-than: ";
+  benchmark_ties<boost::container::priority_deque<counted_key> >(values);
+  std::cout << ", ";
+  benchmark_strings<boost::container::priority_deque<std::string> >(keys);
+  std::cout << "; Three-way: ";
+  benchmark_ties<boost::container::priority_deque<counted_key, std::vector<counted_key>, counted_three_way> >(values);
+  std::cout << ", ";
+  benchmark_strings<boost::container::priority_deque<std::string, std::vector<std::string>, string_three_way> >(keys);
+  std::cout << "\n";
+}
+
+//  Compares the pause of a bulk insertion with the pauses of an incremental one.
+void benchmark_incremental (unsigned benchmark_elements, unsigned budget) {
+  std::vector<int> values;
+  for (unsigned n = benchmark_elements; n--;)
+    values.push_back(rand());
+  clock_t bench_begin, bench_end, longest = 0, total = 0;
+  boost::container::priority_deque<int> pd;
+  bench_begin = clock();
+  pd.insert(values.begin(), values.end());
+  bench_end = clock();
+  std::cout << benchmark_elements << " elements: Insert: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s; Incremental: ";
+
+  boost::container::incremental_priority_deque<int> ipd;
+  bench_begin = clock();
+  ipd.insert(values.begin(), values.end());
+  bench_end = clock();
+  std::cout << "insert " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+//  The first pop after the insertion does not wait for the build.
+  bench_begin = clock();
+  ipd.pop_minimum();
+  bench_end = clock();
+  std::cout << ", first pop " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+  unsigned steps = 0;
+  for (bool building = true; building; ++steps)
+  {
+    bench_begin = clock();
+    building = ipd.step(budget);
+    bench_end = clock();
+    total += bench_end - bench_begin;
+    longest = std::max(longest, bench_end - bench_begin);
+  }
+  std::cout << ", " << steps << " steps of " << budget << " intervals, " << static_cast<double>(total) / CLOCKS_PER_SEC << "s total, longest " << static_cast<double>(longest) / CLOCKS_PER_SEC << "s\n";
+}
+
+//  Compares a loop of pops with pop_minimum_until, when expiring a fraction of
+//  the elements (as in a TTL sweep).
+void benchmark_sweep (unsigned benchmark_elements, unsigned percent) {
+  std::vector<int> values;
+  for (unsigned n = benchmark_elements; n--;)
+    values.push_back(rand() % 100);
+  boost::container::priority_deque<int> looped (values.begin(), values.end());
+  boost::container::priority_deque<int> swept (looped);
+  std::vector<int> expired;
+  expired.reserve(benchmark_elements);
+  const int cutoff = static_cast<int>(percent);
+  clock_t bench_begin, bench_end;
+  bench_begin = clock();
+  while (!looped.empty() && (looped.minimum() < cutoff)) {
+    expired.push_back(looped.minimum());
+    looped.pop_minimum();
+  }
+  bench_end = clock();
+  std::cout << benchmark_elements << " elements, " << percent << "% expired: Pop loop: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s";
+  expired.clear();
+  bench_begin = clock();
+  swept.pop_minimum_until(cutoff, std::back_inserter(expired));
+  bench_end = clock();
+  std::cout << ", pop_minimum_until: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s\n";
+}
+
+//    The hold model: each hold pops the earliest event, and pushes it back a
+//  random increment later, so the queue's size stays fixed. Returns the cost of
+//  a hold, in nanoseconds.
+template <typename pq_t, typename increment_t>
+double benchmark_hold (unsigned size, unsigned holds, increment_t increment) {
+  hold_random random (size);
+  pq_t pq;
+  for (unsigned n = size; n--;)
+    pq.push(increment(random));
+  clock_t bench_begin = clock();
+  for (unsigned n = holds; n--;)
+  {
+    const double time = pq.top();
+    pq.pop();
+    pq.push(time + increment(random));
+  }
+  clock_t bench_end = clock();
+  return static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC * 1e9 / holds;
+}
+
+template <typename increment_t>
+void benchmark_hold (char const * name, increment_t increment) {
+//  With std::greater, top() is the earliest event in both queues.
+  typedef boost::container::priority_deque<double, std::vector<double>, std::greater<double> > deque_t;
+  typedef std::priority_queue<double, std::vector<double>, std::greater<double> > heap_t;
+  std::cout << name << " increments:\n";
+  for (unsigned size = 100; size <= 10000000; size *= 10)
+  {
+    std::cout << "  " << size << " events: priority_deque " << benchmark_hold<deque_t>(size, 1000000, increment) << " ns/hold";
+    std::cout << ", std::priority_queue " << benchmark_hold<heap_t>(size, 1000000, increment) << " ns/hold\n";
+  }
+}
+
+//  Each event reschedules its entity, and sometimes starts another.
+struct simulation_handler {
+  hold_random * random;
+  void operator() (event_simulation<unsigned> & simulation, unsigned entity) const {
+    simulation.schedule(simulation.now() + exponential_increment()(*random), entity);
+    if ((*random)() < 0.01)
+      simulation.schedule(simulation.now() + 10.0 * exponential_increment()(*random), entity);
+  }
+};
+
+//    Runs a simulation, then brings its horizon close, so that most pending
+//  events are culled from the max end, and drains the rest.
+void benchmark_simulation (unsigned entities, unsigned events) {
+  hold_random random (entities);
+  event_simulation<unsigned> simulation;
+  for (unsigned i = 0; i < entities; ++i)
+    simulation.schedule(exponential_increment()(random), i);
+  simulation_handler handler = { &random };
+  clock_t bench_begin = clock();
+  const std::size_t ran = simulation.run(handler, events);
+  clock_t bench_mid = clock();
+  const std::size_t pending = simulation.pending();
+  simulation.set_horizon(simulation.now() + 0.5);
+  clock_t bench_cull = clock();
+  const std::size_t culled = pending - simulation.pending();
+  const std::size_t drained = simulation.run(handler);
+  clock_t bench_end = clock();
+  std::cout << entities << " entities: " << ran << " events, " << static_cast<double>(bench_mid - bench_begin) / CLOCKS_PER_SEC * 1e9 / ran << " ns/event; horizon culled " << culled << " of " << pending << " in " << static_cast<double>(bench_cull - bench_mid) / CLOCKS_PER_SEC << "s; drained " << drained << " events in " << static_cast<double>(bench_end - bench_cull) / CLOCKS_PER_SEC << "s\n";
+}
+
+#if (__cplusplus >= 201103L)
+//  Compares plain and counted storage when there are few distinct values.
+template <typename pq_t>
+void benchmark_duplicates (std::vector<int> const & values) {
+  pq_t pq;
+  clock_t bench_begin, bench_mid, bench_end;
+  bench_begin = clock();
+  for (std::size_t i = 0; i < values.size(); ++i)
+    pq.push(values[i]);
+  bench_mid = clock();
+  while (!pq.empty())
+    pq.pop_minimum();
+  bench_end = clock();
+  std::cout << "Push: " << static_cast<double>(bench_mid - bench_begin) / CLOCKS_PER_SEC << "s, Pop: " << static_cast<double>(bench_end - bench_mid) / CLOCKS_PER_SEC << "s";
+}
+
+void benchmark_duplicates (unsigned benchmark_elements, unsigned distinct) {
+  std::vector<int> values;
+  for (unsigned n = benchmark_elements; n--;)
+    values.push_back(rand() % distinct);
+  std::cout << benchmark_elements << " elements, " << distinct << " distinct: Plain: ";
+  benchmark_duplicates<boost::container::priority_deque<int> >(values);
+  std::cout << "; Counted: ";
+  benchmark_duplicates<boost::container::counted_priority_deque<int> >(values);
+  std::cout << "\n";
+}
+
+//    Keeps a fixed population of timers with delays of up to 10000 ticks. Each
+//  timer that expires is replaced, and each tick one timer is cancelled and
+//  replaced (as when a request completes before its timeout).
+template <typename queue_t>
+void benchmark_timers (unsigned timers, unsigned ticks) {
+  srand(timers);
+  queue_t queue;
+  std::vector<typename queue_t::token_type> tokens (timers);
+  for (unsigned i = 0; i < timers; ++i)
+    tokens[i] = queue.schedule(1 + rand() % 10000, i);
+  std::size_t expired = 0;
+  clock_t bench_begin = clock();
+  for (uint64_t now = 1; now <= ticks; ++now)
+  {
+    expired += queue.expire_until(now, [&](unsigned & slot) {
+      tokens[slot] = queue.schedule(now + 1 + rand() % 10000, slot);
+    });
+    const unsigned slot = rand() % timers;
+    queue.cancel(tokens[slot]);
+    tokens[slot] = queue.schedule(now + 1 + rand() % 10000, slot);
+  }
+  clock_t bench_end = clock();
+  std::cout << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s (" << expired << " expired)";
+}
+
+//  Runs the same queries with each frontier, and reports settled nodes per
+//  second, the peak frontier size (in entries and bytes), and the paths found.
+template <typename search_t>
+void benchmark_search (char const * name, search_t search,
+                       std::vector<std::pair<uint32_t, uint32_t> > const & queries,
+                       std::size_t entry_bytes) {
+  std::size_t settled = 0, peak = 0, found = 0;
+  uint64_t cost = 0;
+  clock_t bench_begin = clock();
+  for (std::size_t i = 0; i < queries.size(); ++i)
+  {
+    search_result result = search(queries[i].first, queries[i].second);
+    settled += result.settled;
+    peak = std::max(peak, result.peak);
+    if (result.cost != kUnreachable) {
+      ++found;
+      cost += result.cost;
+    }
+  }
+  const double seconds = static_cast<double>(clock() - bench_begin) / CLOCKS_PER_SEC;
+  std::cout << "  " << name << ": " << static_cast<uint64_t>(settled / seconds) << " nodes/s, peak " << peak << " entries (" << peak * entry_bytes / 1024 << " KiB), " << found << " paths found, total cost " << cost << "\n";
+}
+
+void benchmark_search (char const * graph_name, search_graph const & g, bool astar) {
+  typedef std::priority_queue<search_entry, std::vector<search_entry>, std::greater<search_entry> > heap_t;
+  typedef boost::container::priority_deque<search_entry> deque_t;
+  std::vector<std::pair<uint32_t, uint32_t> > queries;
+  search_random random (g.nodes());
+  while (queries.size() < 10)
+  {
+    const uint32_t source = random(g.nodes()), target = random(g.nodes());
+    if ((g.offsets[source] != g.offsets[source + 1]) && (g.offsets[target] != g.offsets[target + 1]))
+      queries.push_back(std::make_pair(source, target));
+  }
+//  Lazy deletion keeps an entry per improvement; the unique deque also keeps a
+//  hash and an index slot (at most half full) for each entry.
+  const std::size_t unique_bytes = sizeof(boost::container::unique_priority_deque_internal::entry<search_entry>) + 2 * sizeof(void *);
+  std::cout << graph_name << ", " << g.nodes() << " nodes, " << (astar ? "A*" : "Dijkstra") << ":\n";
+  benchmark_search("std::priority_queue, lazy deletion", [&](uint32_t s, uint32_t t) { return search_lazy<heap_t>(g, s, t, astar); }, queries, sizeof(search_entry));
+  benchmark_search("priority_deque, lazy deletion", [&](uint32_t s, uint32_t t) { return search_lazy<deque_t>(g, s, t, astar); }, queries, sizeof(search_entry));
+  benchmark_search("unique_priority_deque, decrease-key", [&](uint32_t s, uint32_t t) { return search_decrease_key(g, s, t, astar); }, queries, unique_bytes);
+  benchmark_search("priority_deque, frontier of 1024", [&](uint32_t s, uint32_t t) { return search_lazy<deque_t>(g, s, t, astar, 1024); }, queries, sizeof(search_entry));
+}
+
+//    One task spawns the rest, so they all start in one worker's deque, and the
+//  others must steal them. Reports throughput, steals, and how far the order of
+//  execution strays from the order of priority (mean displacement, as a
+//  fraction of the number of tasks).
+void benchmark_scheduler (unsigned threads, unsigned tasks) {
+  std::vector<unsigned> order (tasks);
+  std::atomic<unsigned> executed (0);
+  std::atomic<unsigned> sink (0);
+  boost::container::work_stealing_scheduler<unsigned> scheduler (threads);
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  scheduler.submit(tasks, [&]() {
+    for (unsigned i = 0; i < tasks; ++i)
+    {
+      const unsigned priority = static_cast<unsigned>((i * 7919ull) % tasks);
+      scheduler.submit(priority, [&, priority]() {
+        unsigned x = priority;
+        for (int k = 0; k < 500; ++k)
+          x = x * 1664525u + 1013904223u;
+        sink += x;
+        order[executed++] = priority;
+      });
+    }
+  });
+  scheduler.wait();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  double displacement = 0;
+  for (unsigned i = 0; i < tasks; ++i)
+  {
+    const double rank = tasks - 1 - order[i];
+    displacement += (rank > i) ? (rank - i) : (i - rank);
+  }
+  std::cout << threads << " threads: " << static_cast<uint64_t>(tasks / seconds) << " tasks/s, " << scheduler.steals() << " steals (" << scheduler.stolen() << " tasks), displacement " << displacement / tasks / tasks << "\n";
+}
+
+//    Many producers push into one deque while a consumer drains it. Compares a
+//  lock per element with batches published by batched_priority_deque.
+void benchmark_batched (unsigned producers, unsigned items) {
+  std::atomic<bool> producing (true);
+  std::size_t consumed = 0;
+  std::vector<std::thread> threads;
+
+  boost::container::priority_deque<int> locked_deque;
+  std::mutex lock;
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  for (unsigned p = 0; p < producers; ++p)
+    threads.push_back(std::thread([&, p]() {
+      for (unsigned i = 0; i < items; ++i)
+      {
+        std::lock_guard<std::mutex> guard (lock);
+        locked_deque.push(static_cast<int>(p * items + i));
+      }
+    }));
+  std::thread consumer ([&]() {
+    for (bool last = false; !last; )
+    {
+      last = !producing;
+      std::lock_guard<std::mutex> guard (lock);
+      for (; !locked_deque.empty(); ++consumed)
+        locked_deque.pop_maximum();
+    }
+  });
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  producing = false;
+  consumer.join();
+  std::cout << producers << " producers x " << items << " elements: Lock per element: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() << "s (" << consumed << " consumed, " << producers * items << " locks)";
+
+  boost::container::batched_priority_deque<int> batched (64);
+  threads.clear();
+  consumed = 0;
+  producing = true;
+  begin = std::chrono::steady_clock::now();
+  for (unsigned p = 0; p < producers; ++p)
+    threads.push_back(std::thread([&, p]() {
+      boost::container::batched_priority_deque<int>::producer producer (batched);
+      for (unsigned i = 0; i < items; ++i)
+        producer.push(static_cast<int>(p * items + i));
+    }));
+  std::thread batch_consumer ([&]() {
+    std::vector<int> out;
+    for (bool last = false; !last; )
+    {
+      last = !producing;
+      if (last)
+        batched.flush();
+      out.clear();
+      batched.pop_maximum_n(1024, std::back_inserter(out));
+      consumed += out.size();
+      if (!out.empty())
+        last = false;
+    }
+  });
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  producing = false;
+  batch_consumer.join();
+  std::cout << "; Batched: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() << "s (" << consumed << " consumed, " << batched.batches() << " batches)\n";
+}
+
+template <typename pq_t>
+void benchmark_sharded (pq_t & pq, std::vector<int> const & values, unsigned threads) {
+  clock_t bench_begin = clock();
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  pq.insert(values.begin(), values.end(), threads);
+  const double load = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  clock_t bench_mid = clock();
+  for (std::size_t i = 0; i < 1000000; ++i)
+  {
+    pq.pop_minimum();
+    pq.push(values[i]);
+    pq.pop_maximum();
+    pq.push(values[i + 1]);
+  }
+  clock_t bench_end = clock();
+  std::cout << "load " << load << "s (" << static_cast<double>(bench_mid - bench_begin) / CLOCKS_PER_SEC << "s CPU), pops " << static_cast<double>(bench_end - bench_mid) / CLOCKS_PER_SEC * 1e9 / 4000000 << " ns/op";
+}
+
+//  Compares one deque with deques split among shards, loaded by several threads.
+void benchmark_sharded (unsigned benchmark_elements) {
+  std::vector<int> values;
+  for (unsigned n = benchmark_elements; n--;)
+    values.push_back(rand());
+  typedef boost::container::sharded_priority_deque<int> sharded_t;
+  std::cout << benchmark_elements << " elements: One deque: ";
+  {
+    boost::container::priority_deque<int> pd;
+    clock_t bench_begin = clock();
+    pd.insert(values.begin(), values.end());
+    clock_t bench_mid = clock();
+    for (std::size_t i = 0; i < 1000000; ++i)
+    {
+      pd.pop_minimum();
+      pd.push(values[i]);
+      pd.pop_maximum();
+      pd.push(values[i + 1]);
+    }
+    clock_t bench_end = clock();
+    std::cout << "load " << static_cast<double>(bench_mid - bench_begin) / CLOCKS_PER_SEC << "s, pops " << static_cast<double>(bench_end - bench_mid) / CLOCKS_PER_SEC * 1e9 / 4000000 << " ns/op\n";
+  }
+  const unsigned shard_counts[] = { 4, 64 };
+  for (int s = 0; s < 2; ++s)
+    for (unsigned threads = 1; threads <= 4; threads *= 4)
+    {
+      sharded_t pq (shard_counts[s]);
+      std::cout << "  " << shard_counts[s] << " shards, " << threads << " threads: ";
+      benchmark_sharded(pq, values, threads);
+      std::cout << "\n";
+    }
+}
+
+//    Compares readers of the extremes that take the writer's lock with readers
+//  of a published snapshot, while one writer pushes and pops.
+void benchmark_published (unsigned readers, unsigned writes) {
+  std::vector<int> values;
+  for (unsigned n = writes + 100000; n--;)
+    values.push_back(rand());
+  std::atomic<bool> writing (true);
+  std::atomic<uint64_t> peeks (0);
+  std::vector<std::thread> threads;
+  boost::container::priority_deque<int> locked_deque (values.begin(), values.begin() + 100000);
+  std::mutex lock;
+  for (unsigned r = 0; r < readers; ++r)
+    threads.push_back(std::thread([&]() {
+      uint64_t count = 0;
+      for (int sum = 0; writing; ++count)
+      {
+        std::lock_guard<std::mutex> guard (lock);
+        sum += locked_deque.minimum() + locked_deque.maximum();
+      }
+      peeks += count;
+    }));
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < writes; ++i)
+  {
+    std::lock_guard<std::mutex> guard (lock);
+    locked_deque.push(values[100000 + i]);
+    locked_deque.pop_minimum();
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  writing = false;
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  std::cout << readers << " readers, " << writes << " writes: Locked: writer " << elapsed * 1e9 / writes << " ns/write, " << peeks << " peeks";
+
+  boost::container::published_priority_deque<int> published;
+  published.modify([&](boost::container::published_priority_deque<int>::deque_type & d) {
+    d.insert(values.begin(), values.begin() + 100000);
+  });
+  threads.clear();
+  peeks = 0;
+  writing = true;
+  for (unsigned r = 0; r < readers; ++r)
+    threads.push_back(std::thread([&]() {
+      uint64_t count = 0;
+      for (int sum = 0; writing; ++count)
+      {
+        const boost::container::published_priority_deque<int>::extremes seen = published.peek();
+        sum += seen.minimum + seen.maximum;
+      }
+      peeks += count;
+    }));
+  int popped;
+  begin = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < writes; ++i)
+  {
+    published.push(values[100000 + i]);
+    published.try_pop_minimum(popped);
+  }
+  elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  writing = false;
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  std::cout << "; Published: writer " << elapsed * 1e9 / writes << " ns/write, " << peeks << " peeks\n";
+}
+
+//    Compares exports that scan the deque, blocking the writer, with exports
+//  that scan a copy-on-write snapshot in another thread.
+void benchmark_snapshot (unsigned benchmark_elements, unsigned exports) {
+  std::vector<int> values;
+  for (unsigned n = benchmark_elements + 1000000; n--;)
+    values.push_back(rand());
+  typedef boost::container::priority_deque<int, boost::container::cow_vector<int> > cow_t;
+  clock_t bench_begin, bench_end;
+  {
+    boost::container::priority_deque<int> pd (values.begin(), values.begin() + benchmark_elements);
+    bench_begin = clock();
+    for (unsigned i = 0; i < 1000000; ++i)
+    {
+      pd.pop_minimum();
+      pd.push(values[benchmark_elements + i]);
+    }
+    bench_end = clock();
+  }
+  std::cout << benchmark_elements << " elements: Pop/push with std::vector: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC * 1e9 / 1000000 << " ns/op";
+  {
+    cow_t pd (values.begin(), values.begin() + benchmark_elements);
+    bench_begin = clock();
+    for (unsigned i = 0; i < 1000000; ++i)
+    {
+      pd.pop_minimum();
+      pd.push(values[benchmark_elements + i]);
+    }
+    bench_end = clock();
+  }
+  std::cout << "; with cow_vector: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC * 1e9 / 1000000 << " ns/op\n";
+
+  const unsigned interval = 1000000 / exports;
+  std::atomic<long> exported (0);
+  double longest = 0;
+  {
+    boost::container::priority_deque<int> pd (values.begin(), values.begin() + benchmark_elements);
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 1000000; ++i)
+    {
+      if (i % interval == 0)
+      {
+        std::chrono::steady_clock::time_point pause = std::chrono::steady_clock::now();
+        long sum = 0;
+        for (boost::container::priority_deque<int>::const_iterator it = pd.begin(); it != pd.end(); ++it)
+          sum += *it;
+        exported += sum;
+        longest = std::max(longest, std::chrono::duration<double>(std::chrono::steady_clock::now() - pause).count());
+      }
+      pd.pop_minimum();
+      pd.push(values[benchmark_elements + i]);
+    }
+    std::cout << "  " << exports << " exports: Scan in place: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() << "s, longest pause " << longest * 1e6 << " us";
+  }
+  longest = 0;
+  {
+    cow_t pd (values.begin(), values.begin() + benchmark_elements);
+    std::vector<std::thread> exporters;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 1000000; ++i)
+    {
+      if (i % interval == 0)
+      {
+        std::chrono::steady_clock::time_point pause = std::chrono::steady_clock::now();
+        cow_t snapshot = pd.snapshot();
+//  Starting the exporter is not part of the pause; a real one would be waiting.
+        longest = std::max(longest, std::chrono::duration<double>(std::chrono::steady_clock::now() - pause).count());
+        exporters.push_back(std::thread([snapshot, &exported]() {
+          long sum = 0;
+          for (cow_t::const_iterator it = snapshot.begin(); it != snapshot.end(); ++it)
+            sum += *it;
+          exported += sum;
+        }));
+      }
+      pd.pop_minimum();
+      pd.push(values[benchmark_elements + i]);
+    }
+    const double writer = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    for (std::size_t t = 0; t < exporters.size(); ++t)
+      exporters[t].join();
+    std::cout << "; Snapshot: writer " << writer << "s, longest pause " << longest * 1e6 << " us\n";
+  }
+}
+
+#if (__cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+//  Coroutine that starts at once, and destroys itself when done.
+struct detached_task
+{
+  struct promise_type
+  {
+    detached_task get_return_object (void) { return {}; }
+    std::suspend_never initial_suspend (void) noexcept { return {}; }
+    std::suspend_never final_suspend (void) noexcept { return {}; }
+    void return_void (void) {}
+    void unhandled_exception (void) { std::terminate(); }
+  };
+};
+
+detached_task consume_awaited (boost::container::awaitable_priority_deque<int> & deque, unsigned count, long & sum) {
+  for (unsigned i = 0; i < count; ++i)
+    sum += co_await deque.pop_maximum();
+}
+
+//    Compares a consumer thread that blocks on a condition variable with
+//  consumer coroutines that await an awaitable_priority_deque.
+void benchmark_awaitable (unsigned consumers, unsigned items) {
+  boost::container::priority_deque<int> locked_deque;
+  std::mutex lock;
+  std::condition_variable ready;
+  long sum = 0;
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned c = 0; c < consumers; ++c)
+    threads.push_back(std::thread([&]() {
+      long local = 0;
+      for (unsigned i = 0; i < items; ++i)
+      {
+        std::unique_lock<std::mutex> guard (lock);
+        ready.wait(guard, [&]() { return !locked_deque.empty(); });
+        local += locked_deque.maximum();
+        locked_deque.pop_maximum();
+      }
+      std::lock_guard<std::mutex> guard (lock);
+      sum += local;
+    }));
+  std::thread producer ([&]() {
+    for (unsigned i = 0; i < consumers * items; ++i)
+    {
+      {
+        std::lock_guard<std::mutex> guard (lock);
+        locked_deque.push(static_cast<int>(i));
+      }
+      ready.notify_one();
+    }
+  });
+  producer.join();
+  for (std::size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  std::cout << consumers << " consumers x " << items << " elements: Condition variable: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() << "s (" << sum << ")";
+
+  boost::container::awaitable_priority_deque<int> awaitable;
+  sum = 0;
+  begin = std::chrono::steady_clock::now();
+  for (unsigned c = 0; c < consumers; ++c)
+    consume_awaited(awaitable, items, sum);
+  std::thread awaited_producer ([&]() {
+    for (unsigned i = 0; i < consumers * items; ++i)
+      awaitable.push(static_cast<int>(i));
+  });
+  awaited_producer.join();
+  std::cout << "; Coroutines: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() << "s (" << sum << ", " << awaitable.handoffs() << " handed off)\n";
+}
+#endif
+
+//    Compares the pause of a bulk merge with pops served during a background
+//  one. As with a batch of future events, the batch follows the current keys.
+void benchmark_merge_async (unsigned heap_elements, unsigned batch_elements) {
+  std::vector<int> values, batch;
+  for (unsigned n = heap_elements; n--;)
+    values.push_back(rand() / 2);
+  for (unsigned n = batch_elements; n--;)
+    batch.push_back(rand() / 2 + RAND_MAX / 2);
+  clock_t bench_begin, bench_end;
+  boost::container::priority_deque<int> pd (values.begin(), values.end());
+  bench_begin = clock();
+  pd.merge(batch);
+  bench_end = clock();
+  std::cout << heap_elements << " + " << batch_elements << " elements: Merge: " << static_cast<double>(bench_end - bench_begin) / CLOCKS_PER_SEC << "s; Async: ";
+
+  boost::container::async_priority_deque<int> apd;
+  apd.merge_async(values.begin(), values.end());
+  apd.wait();
+//  clock() counts the worker's time too, so pauses are timed by the wall clock.
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+  apd.merge_async(batch.begin(), batch.end());
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  std::cout << "merge_async " << std::chrono::duration<double>(end - begin).count() << "s";
+  std::chrono::steady_clock::duration longest (0);
+  unsigned pops = 0;
+  for (; apd.merging(); ++pops)
+  {
+    begin = std::chrono::steady_clock::now();
+    apd.push(rand() / 2);
+    apd.pop_minimum();
+    end = std::chrono::steady_clock::now();
+    longest = std::max(longest, end - begin);
+  }
+  std::cout << ", " << pops << " push/pops during the merge, longest " << std::chrono::duration<double>(longest).count() << "s\n";
+}
+#endif
+
 int main() {
   std::cout << "__cplusplus = " << __cplusplus << "\n";
 #ifndef NDEBUG
@@ -234,6 +1202,135 @@ int main() {
   std::cout << "PQ: ";
   benchmark_priority_queue<priority_queue<benchmark_type> >(benchmark_elements);
 }
+{
+//  Larger sizes (1e8) are supported, but need several hundred megabytes.
+  std::cout << "Bulk-load (int):\n";
+  for (unsigned elements = 1000000; elements <= 10000000; elements *= 10)
+    benchmark_bulk_load<int>(elements);
+  std::cout << "Bulk-load (float):\n";
+  for (unsigned elements = 1000000; elements <= 10000000; elements *= 10)
+    benchmark_bulk_load<float>(elements);
+}
+{
+//  Heap-sorting times exclude building the heap.
+  std::cout << "Sorting (int):\n";
+  for (unsigned elements = 1000; elements <= 10000000; elements *= 10)
+    benchmark_sort<int>(elements);
+}
+{
+  std::cout << "Push/pop with indirect keys:\n";
+  for (unsigned elements = 100000; elements <= 1000000; elements *= 10)
+    benchmark_indirect(elements);
+}
+{
+  const unsigned elements = 1000000;
+  std::vector<double> doubles;
+  std::vector<std::pair<int, int> > pairs;
+  for (unsigned n = elements; n--;)
+  {
+    doubles.push_back(static_cast<double>(rand()) - RAND_MAX / 2);
+    pairs.push_back(std::make_pair(rand() % 16, rand()));
+  }
+  std::cout << "Normalized keys (double):\n";
+  benchmark_normalized(doubles);
+  std::cout << "Normalized keys (pair<int, int>):\n";
+  benchmark_normalized(pairs);
+}
+{
+  std::cout << "Push/pop with URL-like keys (6 hosts):\n";
+  for (unsigned elements = 100000; elements <= 1000000; elements *= 10)
+    benchmark_strings(elements, true);
+  std::cout << "Push/pop with URL-like keys (random hosts):\n";
+  for (unsigned elements = 100000; elements <= 1000000; elements *= 10)
+    benchmark_strings(elements, false);
+}
+{
+  std::cout << "Pushing timestamp-like keys (integer):\n";
+  for (unsigned elements = 1000000; elements <= 10000000; elements *= 10)
+    benchmark_monotone<intmax_t>(elements, &identity_key);
+  std::cout << "Pushing timestamp-like keys (string):\n";
+  for (unsigned elements = 100000; elements <= 1000000; elements *= 10)
+    benchmark_monotone<std::string>(elements, &format_stamp);
+}
+{
+  std::cout << "Three-way comparison with few distinct keys:\n";
+  for (unsigned distinct = 2; distinct <= 32; distinct *= 4)
+    benchmark_ties(1000000, distinct);
+}
+{
+  std::cout << "Incremental bulk insertion:\n";
+  for (unsigned elements = 1000000; elements <= 10000000; elements *= 10)
+    benchmark_incremental(elements, 4096);
+}
+{
+  std::cout << "Expiring a fraction of the elements:\n";
+  for (unsigned percent = 1; percent <= 64; percent *= 4)
+    benchmark_sweep(10000000, percent);
+}
+{
+  std::cout << "Hold model:\n";
+  benchmark_hold("Exponential", exponential_increment());
+  benchmark_hold("Uniform", uniform_increment());
+  benchmark_hold("Bimodal", bimodal_increment());
+  benchmark_hold("Triangular", triangular_increment());
+  std::cout << "Event simulation with a horizon:\n";
+  benchmark_simulation(100000, 1000000);
+  benchmark_simulation(1000000, 10000000);
+}
+#if (__cplusplus >= 201103L)
+{
+  std::cout << "Duplicate-heavy keys:\n";
+  benchmark_duplicates(10000000, 1000);
+  benchmark_duplicates(10000000, 100000);
+}
+{
+  std::cout << "Timers (100000 live, 200000 ticks): timer_queue: ";
+  benchmark_timers<boost::container::timer_queue<uint64_t, unsigned> >(100000, 200000);
+  std::cout << ", timing wheel: ";
+  benchmark_timers<timing_wheel<unsigned> >(100000, 200000);
+  std::cout << "\n";
+}
+{
+  std::cout << "Merging on a worker thread:\n";
+  benchmark_merge_async(1000000, 10000000);
+}
+{
+  std::cout << "Graph search:\n";
+  const search_graph grid = make_grid_graph(1000, 1000, 25, 1);
+  benchmark_search("Grid map", grid, false);
+  benchmark_search("Grid map", grid, true);
+  const search_graph roads = make_road_graph(1000, 2);
+  benchmark_search("Road network", roads, false);
+  benchmark_search("Road network", roads, true);
+}
+{
+  std::cout << "Work-stealing scheduler (200000 tasks):\n";
+  for (unsigned threads = 1; threads <= 64; threads *= 2)
+    benchmark_scheduler(threads, 200000);
+}
+{
+  std::cout << "Batched publication into a shared deque:\n";
+  benchmark_batched(16, 100000);
+  benchmark_batched(256, 4000);
+}
+{
+  std::cout << "Sharded priority deque:\n";
+  benchmark_sharded(10000000);
+  std::cout << "Published priority deque:\n";
+  for (unsigned readers = 1; readers <= 16; readers *= 4)
+    benchmark_published(readers, 2000000);
+  std::cout << "Copy-on-write snapshots:\n";
+  for (unsigned elements = 100000; elements <= 1000000; elements *= 10)
+    benchmark_snapshot(elements, 20);
+}
+#endif
+#if (__cplusplus >= 202002L) && defined(__cpp_impl_coroutine)
+{
+  std::cout << "Awaiting elements:\n";
+  for (unsigned consumers = 1; consumers <= 16; consumers *= 4)
+    benchmark_awaitable(consumers, 1000000 / consumers);
+}
+#endif
 #endif
 
   return 0;
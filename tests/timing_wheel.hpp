@@ -0,0 +1,158 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file timing_wheel.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    timing_wheel.hpp provides a hierarchical timing wheel (as described by
+//  Varghese and Lauck), against which timer_queue is benchmarked.
+//    Deadlines are integer ticks. Each level has 256 slots, each a doubly-
+//  linked list of timers. A timer is placed in the lowest level whose span
+//  covers its delay, and moves down a level each time the wheel above turns.
+//  Scheduling and cancelling are O(1); each tick costs O(1) plus the timers
+//  that expire or move down.
+*/
+
+#ifndef BOOST_CONTAINER_TESTS_TIMING_WHEEL_HPP_
+#define BOOST_CONTAINER_TESTS_TIMING_WHEEL_HPP_
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+template <typename Callback>
+class timing_wheel
+{
+ public:
+//  Node index in the low half; the node's generation in the high half.
+  typedef uint64_t token_type;
+
+  timing_wheel (void) : now_(0), free_(-1)
+  {
+    for (int i = 0; i < kLevels * kSlots; ++i)
+      heads_[i] = -1;
+  }
+//  Deadlines that have already passed expire at the next tick.
+  token_type schedule (uint64_t deadline, Callback callback)
+  {
+    int32_t index = free_;
+    if (index < 0) {
+      index = static_cast<int32_t>(nodes_.size());
+      nodes_.push_back(node());
+      nodes_.back().generation = 0;
+    } else
+      free_ = nodes_[index].next;
+    node & n = nodes_[index];
+    n.deadline = (deadline > now_) ? deadline : (now_ + 1);
+    n.callback = std::move(callback);
+    link(index);
+    return (static_cast<token_type>(n.generation) << 32) |
+           static_cast<uint32_t>(index);
+  }
+  bool cancel (token_type token)
+  {
+    const int32_t index = static_cast<int32_t>(token & 0xFFFFFFFFu);
+    if ((index >= static_cast<int32_t>(nodes_.size())) ||
+        (nodes_[index].slot < 0) ||
+        (nodes_[index].generation != static_cast<uint32_t>(token >> 32)))
+      return false;
+    unlink(index);
+    release(index);
+    return true;
+  }
+//  Advances to @a now, passing the callback of each expired timer to @a f.
+  template <typename Function>
+  std::size_t expire_until (uint64_t now, Function f)
+  {
+    std::size_t expired = 0;
+    std::vector<Callback> due;
+    while (now_ < now) {
+      ++now_;
+//  Turn the upper wheels first, so that their timers are placed below.
+      int level = 1;
+      while ((level < kLevels) &&
+             (((now_ >> (kBits * (level - 1))) & (kSlots - 1)) == 0))
+        ++level;
+      while (--level > 0)
+        cascade(level, (now_ >> (kBits * level)) & (kSlots - 1));
+      int32_t & head = heads_[now_ & (kSlots - 1)];
+      while (head >= 0) {
+        const int32_t index = head;
+        unlink(index);
+        due.push_back(std::move(nodes_[index].callback));
+        release(index);
+      }
+    }
+    for (typename std::vector<Callback>::iterator it = due.begin();
+         it != due.end(); ++it)
+      f(*it);
+    expired += due.size();
+    return expired;
+  }
+
+ private:
+  static const int kBits = 8;
+  static const int kSlots = 1 << kBits;
+  static const int kLevels = 4;
+  struct node
+  {
+    uint64_t deadline;
+    Callback callback;
+    int32_t prev, next, slot;
+    uint32_t generation;
+  };
+  void link (int32_t index)
+  {
+    node & n = nodes_[index];
+    const uint64_t delay = n.deadline - now_;
+    int level = 0;
+    while ((level + 1 < kLevels) && (delay >> (kBits * (level + 1))))
+      ++level;
+    n.slot = level * kSlots +
+             static_cast<int32_t>((n.deadline >> (kBits * level)) &
+                                  (kSlots - 1));
+    n.prev = -1;
+    n.next = heads_[n.slot];
+    if (n.next >= 0)
+      nodes_[n.next].prev = index;
+    heads_[n.slot] = index;
+  }
+  void unlink (int32_t index)
+  {
+    node & n = nodes_[index];
+    if (n.prev >= 0)
+      nodes_[n.prev].next = n.next;
+    else
+      heads_[n.slot] = n.next;
+    if (n.next >= 0)
+      nodes_[n.next].prev = n.prev;
+  }
+  void release (int32_t index)
+  {
+    node & n = nodes_[index];
+    n.slot = -1;
+    ++n.generation;
+    n.next = free_;
+    free_ = index;
+  }
+  void cascade (int level, uint64_t slot)
+  {
+    int32_t index = heads_[level * kSlots + slot];
+    heads_[level * kSlots + slot] = -1;
+    while (index >= 0) {
+      const int32_t next = nodes_[index].next;
+      link(index);
+      index = next;
+    }
+  }
+
+  std::vector<node> nodes_;
+  int32_t heads_[kLevels * kSlots];
+  uint64_t now_;
+  int32_t free_;
+};
+
+#endif
@@ -0,0 +1,272 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file timer_queue.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    timer_queue.hpp provides the class timer_queue, a queue of deadlines and
+//  the callbacks to run when they pass.
+//    Each timer is identified by a token, which the queue indexes (as does
+//  unique_priority_deque), so that a timer can be cancelled or rescheduled in
+//  O(log n). Both ends of the queue are available: the earliest deadline, to
+//  decide how long to sleep, and the latest, to shed timers under load.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for unique_priority_deque.
+*/
+
+#ifndef BOOST_CONTAINER_TIMER_QUEUE_HPP_
+#define BOOST_CONTAINER_TIMER_QUEUE_HPP_
+
+#ifndef __cplusplus
+#error timer_queue.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error timer_queue.hpp requires C++11 (for std::function).
+#endif
+
+//  Default callback type (std::function).
+#include <functional>
+//  Grab std::back_inserter.
+#include <iterator>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "unique_priority_deque.hpp"
+
+namespace boost {
+namespace container {
+/// \cond false
+namespace timer_queue_internal {
+template <typename Deadline, typename Callback>
+struct timer
+{
+  Deadline deadline;
+  uint64_t token;
+  Callback callback;
+};
+
+struct token_of
+{
+  template <typename Timer>
+  uint64_t operator() (Timer const & t) const { return t.token; }
+};
+
+//  Timers with equal deadlines expire in the order in which they were made.
+template <typename Compare>
+struct timer_compare
+{
+  explicit timer_compare (Compare const & comp) : compare(comp) {}
+  template <typename Timer>
+  bool operator() (Timer const & lhs, Timer const & rhs) const
+  {
+    if (compare(lhs.deadline, rhs.deadline))
+      return true;
+    if (compare(rhs.deadline, lhs.deadline))
+      return false;
+    return lhs.token < rhs.token;
+  }
+  Compare compare;
+};
+} //  Namespace timer_queue_internal
+/// \endcond
+
+//----------------------------Timer Queue Class--------------------------------|
+/*! @brief Queue of deadlines, with cancellable and reschedulable timers.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Deadline Type of deadlines, such as a time point or a tick count.
+ *  @param Callback Type of the callbacks. Defaults to std::function<void()>.
+ *  Must be movable.
+ *  @param Compare Comparison of deadlines. Earlier deadlines are ordered first.
+ *  Defaults to std::less<Deadline>.
+ *  @details A timer is due once @a now is not ordered before its deadline.
+ *  Timers with equal deadlines expire in the order they were scheduled.
+ *  @see unique_priority_deque
+ */
+template <typename Deadline, typename Callback =::std::function<void()>,
+          typename Compare =::std::less<Deadline> >
+class timer_queue
+  : private unique_priority_deque<
+      timer_queue_internal::timer<Deadline, Callback>,
+      timer_queue_internal::token_of,
+      timer_queue_internal::timer_compare<Compare> >
+{
+  typedef timer_queue_internal::timer<Deadline, Callback>           timer;
+  typedef unique_priority_deque<timer, timer_queue_internal::token_of,
+            timer_queue_internal::timer_compare<Compare> >          base_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Deadline                                    deadline_type;
+  typedef Callback                                    callback_type;
+  typedef Compare                                     deadline_compare;
+  typedef typename base_type::size_type               size_type;
+//! @brief Identifies a timer. Never 0, and never reused by a queue.
+  typedef uint64_t                                    token_type;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty timer queue.
+  explicit timer_queue                (Compare const & comp =Compare())
+    : base_type(timer_queue_internal::timer_compare<Compare>(comp)),
+      compare_(comp), next_token_(1) {}
+//---------------------------------Timers--------------------------------------|
+/** @brief Adds a timer.
+//  @return A token, with which the timer may be cancelled or rescheduled.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the number of timers (amortized).
+//  @par  Exception safety:
+//    Strong.
+*/
+  token_type              schedule    (deadline_type const & deadline,
+                                       callback_type callback)
+  {
+    timer added = { deadline, next_token_, std::move(callback) };
+    base_type::push(std::move(added));
+    return next_token_++;
+  }
+/** @brief Removes a timer without running it.
+//  @return True if the timer was pending; false if it had expired, or had
+//  already been cancelled.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the number of timers.
+*/
+  bool                    cancel      (token_type token)
+  {
+    return base_type::erase(token);
+  }
+/** @brief Changes the deadline of a pending timer.
+//  @return True if the timer was pending.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the number of timers.
+*/
+  bool                    reschedule  (token_type token,
+                                       deadline_type const & deadline);
+//! @brief Returns true if the timer has neither expired nor been cancelled.
+  bool                    pending     (token_type token) const
+  {
+    return base_type::contains(token);
+  }
+/** @brief Removes every due timer, then passes each callback to @a f.
+//  @param now The current time. Timers whose deadlines are not after @a now
+//  are due.
+//  @param f Called as @a f(callback), in order of deadline.
+//  @return The number of timers that expired.
+//  @details All due timers are removed before the first call, so @a f may
+//  schedule or cancel timers freely. Timers it schedules are not run by this
+//  call, even if they are already due.
+//  @par  Complexity:
+//    O(k log n) for k due timers.
+//  @par  Exception safety:
+//    If @a f throws, the due timers not yet passed to it are restored, with
+//  their tokens and deadlines, and the exception propagates. Cancelling one of
+//  them from within @a f has no effect, as it is not pending at that time.
+*/
+  template <typename Function>
+  size_type               expire_until(deadline_type const & now, Function f);
+//! @brief Runs every due timer. @see expire_until
+  size_type               expire_until(deadline_type const & now)
+  {
+    return expire_until(now, invoke());
+  }
+//! @brief The earliest deadline. The queue must not be empty.
+  deadline_type const &   next_deadline   (void) const
+  {
+    return base_type::minimum().deadline;
+  }
+//! @brief The latest deadline. The queue must not be empty.
+  deadline_type const &   latest_deadline (void) const
+  {
+    return base_type::maximum().deadline;
+  }
+/** @brief Removes the timer with the latest deadline, without running it.
+//  @return Its callback.
+//  @details Useful for shedding load: the timer furthest in the future is
+//  the one whose loss is noticed last.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the number of timers.
+*/
+  callback_type           shed_latest (void)
+  {
+    std::vector<timer> shed;
+    shed.reserve(1);
+    base_type::pop_maximum_n(1, std::back_inserter(shed));
+    return std::move(shed.front().callback);
+  }
+
+  using base_type::empty;
+  using base_type::size;
+  using base_type::clear;
+//! @brief Exchanges the timers of two queues.
+  void                    swap        (timer_queue & other)
+  {
+    using std::swap;
+    base_type::swap(other);
+    swap(compare_, other.compare_);
+    swap(next_token_, other.next_token_);
+  }
+//---------------------------------Private-------------------------------------|
+ private:
+  struct invoke
+  {
+    void operator() (callback_type & callback) const { callback(); }
+  };
+
+  Compare compare_;
+  token_type next_token_;
+};
+
+template <typename D, typename F, typename C>
+bool timer_queue<D, F, C>::reschedule (token_type token,
+                                       deadline_type const & deadline)
+{
+  typename base_type::entry_type * found = base_type::find_entry(token);
+  if (!found)
+    return false;
+//  The token is unchanged, so the index still refers to the right entry.
+  found->value.deadline = deadline;
+  base_type::update_at(found);
+  return true;
+}
+
+template <typename D, typename F, typename C>
+template <typename Function>
+typename timer_queue<D, F, C>::size_type
+  timer_queue<D, F, C>::expire_until (deadline_type const & now, Function f)
+{
+  std::vector<timer> due;
+  while (!empty() && !compare_(now, next_deadline()))
+    base_type::pop_minimum_n(1, std::back_inserter(due));
+  typename std::vector<timer>::iterator it = due.begin();
+  try {
+    for (; it != due.end(); ++it)
+      f(it->callback);
+  } catch (...) {
+//  The callback that threw has run; the ones after it have not.
+    for (++it; it != due.end(); ++it)
+      base_type::push(std::move(*it));
+    throw;
+  }
+  return due.size();
+}
+
+/** @brief Swaps the timers of two timer queues.
+// @relates timer_queue
+*/
+template <typename D, typename F, typename C>
+inline void swap (timer_queue<D, F, C> & queue1, timer_queue<D, F, C> & queue2)
+{
+  queue1.swap(queue2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
@@ -0,0 +1,628 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file unique_priority_deque.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    unique_priority_deque.hpp provides the class unique_priority_deque, a
+//  priority deque that holds at most one element per key.
+//    An open-addressing hash index maps each key to its element's position in
+//  the interval heap. Each element records the index slot that refers to it,
+//  and updates that slot whenever the heap moves the element, so the index is
+//  always exact.
+//  @par  Thread safety:
+//    No static variables are modified by any operation.  \n
+//    Simultaneous const operations are safe.  \n
+//    Using any non-const operation without synchronization causes undefined
+//  behavior.
+//  @par Exception safety:
+//    As for priority_deque, if moving an element does not throw. Hashing and
+//  key comparison should not throw.
+*/
+
+#ifndef BOOST_CONTAINER_UNIQUE_PRIORITY_DEQUE_HPP_
+#define BOOST_CONTAINER_UNIQUE_PRIORITY_DEQUE_HPP_
+
+#ifndef __cplusplus
+#error unique_priority_deque.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error unique_priority_deque.hpp requires C++11 (for std::hash).
+#endif
+
+//  Default hash function.
+#include <functional>
+//  Grab std::move and std::declval.
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <stdint.h>
+
+#include "priority_deque.hpp"
+//  Grab the iterator adaptor, which hides the index bookkeeping.
+#include "projected_priority_deque.hpp"
+
+namespace boost {
+namespace container {
+//! @brief Key extractor for elements that are their own keys.
+struct identity_key
+{
+  template <typename Type>
+  Type const & operator() (Type const & value) const { return value; }
+};
+
+/// \cond false
+namespace unique_priority_deque_internal {
+/*! @brief Element of the heap, which keeps its index slot up to date.
+//  @details Entries may be moved, but not copied; a copy would leave two
+//  entries claiming one slot.
+*/
+template <typename Type>
+struct entry
+{
+  Type value;
+  std::size_t hash;
+//  Slot of the hash index that refers to this entry, or null if none does.
+  entry ** cell;
+
+  entry (Type const & val, std::size_t h, entry ** c)
+    : value(val), hash(h), cell(c)
+  {
+    if (cell)
+      *cell = this;
+  }
+  entry (Type && val, std::size_t h, entry ** c)
+    : value(std::move(val)), hash(h), cell(c)
+  {
+    if (cell)
+      *cell = this;
+  }
+  entry (entry && other)
+    noexcept(std::is_nothrow_move_constructible<Type>::value)
+    : value(std::move(other.value)), hash(other.hash), cell(other.cell)
+  {
+    if (cell)
+      *cell = this;
+  }
+  entry & operator= (entry && other)
+    noexcept(std::is_nothrow_move_assignable<Type>::value)
+  {
+    value = std::move(other.value);
+    hash = other.hash;
+    cell = other.cell;
+    if (cell)
+      *cell = this;
+    return *this;
+  }
+  entry (entry const &) = delete;
+  entry & operator= (entry const &) = delete;
+};
+
+template <typename Type, typename Compare>
+struct entry_compare
+{
+  explicit entry_compare (Compare const & comp) : compare(comp) {}
+  bool operator() (entry<Type> const & lhs, entry<Type> const & rhs) const
+  {
+    return compare(lhs.value, rhs.value);
+  }
+  Compare compare;
+};
+
+template <typename Type>
+struct entry_traits
+{
+  static Type const & value (entry<Type> const & element)
+  {
+    return element.value;
+  }
+};
+
+/*! @brief Open-addressing (linear probing) index from keys to entries.
+//  @details The table is at most half full. Removal shifts later entries of a
+//  probe sequence back, rather than leaving markers, so lookups stay short.
+*/
+template <typename Type, typename KeyOf, typename Hash, typename KeyEqual>
+class hash_index
+{
+ public:
+  typedef entry<Type> entry_type;
+  typedef typename std::decay<decltype(std::declval<KeyOf const &>()(
+                              std::declval<Type const &>()))>::type key_type;
+
+  hash_index (KeyOf const & key, Hash const & hash, KeyEqual const & equal)
+    : table_(), key_of_(key), hash_(hash), equal_(equal) {}
+
+//  Standard hashes of integers are often the identity, which would form long
+//  runs of occupied slots. Mix the bits (as in MurmurHash3's finalizer).
+  std::size_t hash (key_type const & key) const
+  {
+    uint64_t h = static_cast<uint64_t>(hash_(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+  }
+  std::size_t capacity (void) const { return table_.size(); }
+  KeyOf const & key_of (void) const { return key_of_; }
+
+//! @brief Returns the slot holding the key, or an empty slot for it.
+  entry_type ** find (key_type const & key, std::size_t h)
+  {
+    if (table_.empty())
+      return nullptr;
+    const std::size_t mask = table_.size() - 1;
+    for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+      entry_type * found = table_[i];
+      if (!found || ((found->hash == h) && equal_(key_of_(found->value), key)))
+        return &table_[i];
+    }
+  }
+  entry_type const * const * find (key_type const & key, std::size_t h) const
+  {
+    return const_cast<hash_index *>(this)->find(key, h);
+  }
+//! @brief Ensures that the table may hold the given number of entries.
+//! @details Invalidates slots; @a first to @a last are re-indexed.
+  template <typename Iterator>
+  void reserve (std::size_t count, Iterator first, Iterator last)
+  {
+    if (count * 2 <= table_.size())
+      return;
+    std::size_t capacity = 16;
+    while (capacity < count * 2)
+      capacity *= 2;
+    rebuild(capacity, first, last);
+  }
+//! @brief Re-indexes entries, in a table of the given capacity.
+  template <typename Iterator>
+  void rebuild (std::size_t capacity, Iterator first, Iterator last)
+  {
+    std::vector<entry_type *> table (capacity, nullptr);
+    table_.swap(table);
+    const std::size_t mask = table_.size() - 1;
+    for (; first != last; ++first) {
+      std::size_t i = first->hash & mask;
+      while (table_[i])
+        i = (i + 1) & mask;
+      table_[i] = &*first;
+      first->cell = &table_[i];
+    }
+  }
+//! @brief Empties a slot, moving later entries of its probe sequence back.
+  void remove (entry_type ** cell)
+  {
+    const std::size_t mask = table_.size() - 1;
+    std::size_t hole = static_cast<std::size_t>(cell - &table_[0]);
+    for (std::size_t i = (hole + 1) & mask; table_[i]; i = (i + 1) & mask) {
+      const std::size_t home = table_[i]->hash & mask;
+//  The entry may fill the hole if its home is not cyclically in (hole, i].
+      const bool movable = (hole <= i) ? ((home <= hole) || (home > i))
+                                       : ((home <= hole) && (home > i));
+      if (movable) {
+        table_[hole] = table_[i];
+        table_[hole]->cell = &table_[hole];
+        hole = i;
+      }
+    }
+    table_[hole] = nullptr;
+  }
+  void clear (void)
+  {
+    std::fill(table_.begin(), table_.end(), nullptr);
+  }
+  void swap (hash_index & other)
+  {
+    using std::swap;
+    table_.swap(other.table_);
+    swap(key_of_, other.key_of_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+  }
+ private:
+  std::vector<entry_type *> table_;
+  KeyOf key_of_;
+  Hash hash_;
+  KeyEqual equal_;
+};
+
+template <typename Type, typename KeyOf>
+struct key_of
+{
+  typedef typename std::decay<decltype(std::declval<KeyOf const &>()(
+                              std::declval<Type const &>()))>::type type;
+};
+} //  Namespace unique_priority_deque_internal
+/// \endcond
+
+//-----------------------Unique Priority Deque Class----------------------------|
+/*! @brief Double-ended priority queue holding at most one element per key.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Type Type of elements in the priority deque.
+ *  @param KeyOf Key extractor. %KeyOf(A) returns the key of element %A.
+ *  Defaults to identity_key, for elements that are their own keys.
+ *  @param Compare Comparison class for elements (not keys).
+ *  @param Hash Hash function for keys. Defaults to std::hash.
+ *  @param KeyEqual Equality of keys. Defaults to std::equal_to.
+ *  @details Pushing an element whose key is already present keeps whichever
+ *  of the two elements is greater (is ordered later by @a Compare), restoring
+ *  the heap in O(log n). Use @a update to replace an element regardless.
+ *  @see priority_deque
+ */
+template <typename Type, typename KeyOf = identity_key,
+          typename Compare =::std::less<Type>,
+          typename Hash =::std::hash<
+            typename unique_priority_deque_internal::key_of<Type, KeyOf>::type>,
+          typename KeyEqual =::std::equal_to<
+            typename unique_priority_deque_internal::key_of<Type, KeyOf>::type>>
+class unique_priority_deque
+  : private priority_deque<unique_priority_deque_internal::entry<Type>,
+      std::vector<unique_priority_deque_internal::entry<Type>>,
+      unique_priority_deque_internal::entry_compare<Type, Compare>>
+{
+  typedef unique_priority_deque_internal::entry_compare<Type, Compare>
+                                                                entry_compare;
+  typedef priority_deque<unique_priority_deque_internal::entry<Type>,
+            std::vector<unique_priority_deque_internal::entry<Type>>,
+            entry_compare>                                          base_type;
+  typedef unique_priority_deque_internal::hash_index<Type, KeyOf, Hash,
+                                                     KeyEqual>      index_type;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Type                                        value_type;
+  typedef typename index_type::key_type               key_type;
+  typedef Compare                                     value_compare;
+  typedef KeyOf                                       key_extractor;
+  typedef typename base_type::size_type               size_type;
+  typedef Type const &                                const_reference;
+  typedef projected_priority_deque_internal::const_iterator<Type,
+            typename base_type::const_iterator,
+            unique_priority_deque_internal::entry_traits<Type>> const_iterator;
+//-------------------------------Constructors----------------------------------|
+//! @brief Constructs an empty priority deque.
+  explicit unique_priority_deque      (Compare const & comp =Compare(),
+                                       KeyOf const & key =KeyOf(),
+                                       Hash const & hash =Hash(),
+                                       KeyEqual const & equal =KeyEqual())
+    : base_type(entry_compare(comp)), index_(key, hash, equal) {}
+//! @brief Copies a priority deque, building a new index.
+  unique_priority_deque               (unique_priority_deque const &);
+//! @details Moving preserves the addresses of entries and index slots.
+  unique_priority_deque               (unique_priority_deque &&) = default;
+  unique_priority_deque & operator=   (unique_priority_deque const & other)
+  {
+    unique_priority_deque copy (other);
+    swap(copy);
+    return *this;
+  }
+  unique_priority_deque & operator=   (unique_priority_deque &&) = default;
+//-----------------------------Restricted Access-------------------------------|
+/** @brief Adds an element, or improves the element with the same key.
+//  @param value Element to insert into the priority deque.
+//  @return True if @a value was added, or replaced an element with the same
+//  key that is ordered before it; false if the deque is unchanged.
+//  @post All iterators and references are invalidated.
+//
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the deque (amortized).
+//  @par  Exception safety:
+//    Strong if no element has the same key; basic otherwise.
+*/
+  bool                    push        (value_type const & value)
+  {
+    return insert_or_assign(value, true);
+  }
+//!@overload
+  bool                    push        (value_type && value)
+  {
+    return insert_or_assign(std::move(value), true);
+  }
+/** @brief Adds an element, or replaces the element with the same key.
+//  @return True if @a value was added, false if it replaced an element.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the deque (amortized).
+//  @par  Exception safety:
+//    Strong if no element has the same key; basic otherwise.
+*/
+  bool                    update      (value_type const & value)
+  {
+    return insert_or_assign(value, false);
+  }
+//!@overload
+  bool                    update      (value_type && value)
+  {
+    return insert_or_assign(std::move(value), false);
+  }
+//! @brief Accesses a maximal element in the deque.
+  inline const_reference  maximum     (void) const
+  {
+    return base_type::maximum().value;
+  }
+//! @brief Accesses a minimal element in the deque.
+  inline const_reference  minimum     (void) const
+  {
+    return base_type::minimum().value;
+  }
+//! @details Identical to std::priority_queue top(). @see @a maximum
+  inline const_reference  top         (void) const  { return maximum(); }
+//! @brief Removes a maximal element from the deque.
+  void                    pop_maximum (void);
+//! @brief Removes a minimal element from the deque.
+  void                    pop_minimum (void);
+//! @details Identical to std::priority_queue pop(). @see @a pop_maximum
+  inline void             pop         (void)        { pop_maximum(); }
+//------------------------------Keyed Access-----------------------------------|
+/** @brief Checks whether an element with the specified key is present.
+//  @par  Complexity:
+//    O(1) - Constant on average.
+*/
+  bool                    contains    (key_type const & key) const
+  {
+    return find(key) != nullptr;
+  }
+/** @brief Finds the element with the specified key.
+//  @return Pointer to the element, or null if none has the key.
+//  @par  Complexity:
+//    O(1) - Constant on average.
+*/
+  value_type const *      find        (key_type const & key) const;
+/** @brief Removes the element with the specified key, if any.
+//  @return True if an element was removed.
+//  @post All iterators and references are invalidated.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the size of the deque.
+*/
+  bool                    erase       (key_type const & key);
+
+  using base_type::empty;
+  using base_type::size;
+  using base_type::max_size;
+//! @brief Removes all elements from the priority deque.
+  void                    clear       (void)
+  {
+    base_type::clear();
+    index_.clear();
+  }
+//! @brief Exchanges the elements of two unique priority deques.
+  void                    swap        (unique_priority_deque & other)
+  {
+    base_type::swap(other);
+    index_.swap(other.index_);
+  }
+//-------------------------------Random Access---------------------------------|
+//! @brief Returns a const iterator at the beginning of the sequence.
+  inline const_iterator   begin       (void) const
+  {
+    return const_iterator(base_type::begin());
+  }
+//! @brief Returns a const iterator past the end of the sequence.
+  inline const_iterator   end         (void) const
+  {
+    return const_iterator(base_type::end());
+  }
+
+//---------------------------Boost.Heap Concepts-------------------------------|
+  static const bool constant_time_size    = true;
+  static const bool has_ordered_iterators = false;
+  static const bool is_mergable           = false;
+  static const bool is_stable             = false;
+  static const bool has_reserve           = false;
+//--------------------------------Protected------------------------------------|
+ protected:
+//  Derived deques (such as counted_priority_deque) may adjust elements in
+//  place, then restore the heap with update_at.
+  typedef unique_priority_deque_internal::entry<Type>               entry_type;
+  using base_type::sequence;
+  using base_type::compare;
+//! @brief Finds the heap entry for a key, or null.
+  entry_type *            find_entry  (key_type const & key)
+  {
+    const std::size_t h = index_.hash(key);
+    entry_type ** cell = index_.find(key, h);
+    return (cell && *cell) ? *cell : nullptr;
+  }
+//! @brief Accesses the root entry holding a maximal element.
+  entry_type &            maximal_entry (void)
+  {
+    typename base_type::container_type & seq = sequence();
+    return (seq.size() > 1) ? seq[1] : seq.front();
+  }
+//! @brief Accesses the root entry holding a minimal element.
+  entry_type &            minimal_entry (void)
+  {
+    return sequence().front();
+  }
+/** @brief Removes the @a n minimal elements, moving each into @a out.
+//  @details As priority_deque::pop_minimum_n. Each element leaves the index as
+//  it is written.
+*/
+  template <typename OutputIterator>
+  OutputIterator          pop_minimum_n (size_type n, OutputIterator out)
+  {
+    return pop_n(n, out, true);
+  }
+//! @brief Removes the @a n maximal elements. @see pop_minimum_n
+  template <typename OutputIterator>
+  OutputIterator          pop_maximum_n (size_type n, OutputIterator out)
+  {
+    return pop_n(n, out, false);
+  }
+//! @brief Restores the heap property after the value at @a ptr changed.
+  void                    update_at   (entry_type * ptr)
+  {
+    typename base_type::container_type & seq = sequence();
+    heap::update_interval_heap(seq.begin(), seq.end(), ptr - &seq.front(),
+                               compare());
+  }
+//---------------------------------Private-------------------------------------|
+ private:
+  template <typename Value>
+  bool insert_or_assign (Value && value, bool keep_greater);
+  void remove_at (entry_type & target, bool from_min);
+  template <typename OutputIterator>
+  OutputIterator pop_n (size_type n, OutputIterator out, bool from_min);
+//  Output iterator that unindexes each popped entry, then moves its value on.
+  template <typename OutputIterator>
+  struct unindexer
+  {
+    index_type * index;
+    OutputIterator out;
+    unindexer & operator* (void) { return *this; }
+    unindexer & operator++ (void)
+    {
+      ++out;
+      return *this;
+    }
+    unindexer & operator= (entry_type && popped)
+    {
+      index->remove(popped.cell);
+      popped.cell = nullptr;
+      *out = std::move(popped.value);
+      return *this;
+    }
+  };
+
+  index_type index_;
+};
+
+//-------------------------------Constructors----------------------------------|
+template <typename T, typename K, typename C, typename H, typename E>
+unique_priority_deque<T, K, C, H, E>::unique_priority_deque (
+                                          unique_priority_deque const & other)
+  : base_type(other.compare()), index_(other.index_)
+{
+//  The copied index refers to the other deque's entries until rebuilt.
+  typename base_type::container_type & seq = sequence();
+  seq.reserve(other.size());
+  for (typename base_type::const_iterator it = other.base_type::begin();
+       it != other.base_type::end(); ++it)
+    seq.push_back(entry_type(it->value, it->hash, nullptr));
+  index_.rebuild(index_.capacity(), seq.begin(), seq.end());
+}
+
+//------------------------------------Insert-----------------------------------|
+template <typename T, typename K, typename C, typename H, typename E>
+template <typename Value>
+bool unique_priority_deque<T, K, C, H, E>::insert_or_assign (Value && value,
+                                                            bool keep_greater)
+{
+  typename base_type::container_type & seq = sequence();
+  const key_type & key = index_.key_of()(value);
+  const std::size_t h = index_.hash(key);
+  entry_type ** cell = index_.find(key, h);
+  if (cell && *cell) {
+    entry_type & existing = **cell;
+    if (keep_greater && !compare().compare(existing.value, value))
+      return false;
+    existing.value = std::forward<Value>(value);
+    update_at(&existing);
+    return keep_greater;
+  }
+//  Growing the index moves its slots; find the key's slot again.
+  index_.reserve(size() + 1, seq.begin(), seq.end());
+  cell = index_.find(key, h);
+  try {
+    base_type::push(entry_type(std::forward<Value>(value), h, cell));
+  } catch (...) {
+    index_.remove(cell);
+    throw;
+  }
+  return true;
+}
+
+//-----------------------------------Remove------------------------------------|
+template <typename T, typename K, typename C, typename H, typename E>
+void unique_priority_deque<T, K, C, H, E>::remove_at (entry_type & target,
+                                                      bool from_min)
+{
+  entry_type ** cell = target.cell;
+  index_.remove(cell);
+  target.cell = nullptr;
+  try {
+    if (from_min)
+      base_type::pop_minimum();
+    else
+      base_type::pop_maximum();
+  } catch (...) {
+//  The heap was restored, with the element unindexed. Index it again.
+    index_.rebuild(index_.capacity(), sequence().begin(), sequence().end());
+    throw;
+  }
+}
+
+template <typename T, typename K, typename C, typename H, typename E>
+template <typename OutputIterator>
+OutputIterator unique_priority_deque<T, K, C, H, E>::pop_n (size_type n,
+                                                            OutputIterator out,
+                                                            bool from_min)
+{
+  unindexer<OutputIterator> writer = { &index_, out };
+  try {
+    return (from_min ? base_type::pop_minimum_n(n, writer)
+                     : base_type::pop_maximum_n(n, writer)).out;
+  } catch (...) {
+//  Entries may have been dropped while still indexed. Index the rest again.
+    index_.rebuild(index_.capacity(), sequence().begin(), sequence().end());
+    throw;
+  }
+}
+
+template <typename T, typename K, typename C, typename H, typename E>
+void unique_priority_deque<T, K, C, H, E>::pop_maximum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no maximal element. Removal undefined.");
+  remove_at(maximal_entry(), false);
+}
+
+template <typename T, typename K, typename C, typename H, typename E>
+void unique_priority_deque<T, K, C, H, E>::pop_minimum (void)
+{
+  BOOST_CONTAINER_PRIORITY_DEQUE_ASSERT(!empty(),
+    "Empty priority deque has no minimal element. Removal undefined.");
+  remove_at(minimal_entry(), true);
+}
+
+//------------------------------Keyed Access-----------------------------------|
+template <typename T, typename K, typename C, typename H, typename E>
+typename unique_priority_deque<T, K, C, H, E>::value_type const *
+  unique_priority_deque<T, K, C, H, E>::find (key_type const & key) const
+{
+  entry_type const * const * cell = index_.find(key, index_.hash(key));
+  return (cell && *cell) ? &(*cell)->value : nullptr;
+}
+
+template <typename T, typename K, typename C, typename H, typename E>
+bool unique_priority_deque<T, K, C, H, E>::erase (key_type const & key)
+{
+  entry_type * target = find_entry(key);
+  if (!target)
+    return false;
+  typename base_type::container_type & seq = sequence();
+  const typename base_type::difference_type index = target - &seq.front();
+  index_.remove(target->cell);
+  target->cell = nullptr;
+  base_type::erase(base_type::begin() + index);
+  return true;
+}
+
+/** @brief Swaps the elements of two unique priority deques.
+// @relates unique_priority_deque
+*/
+template <typename T, typename K, typename C, typename H, typename E>
+inline void swap (unique_priority_deque<T, K, C, H, E> & deque1,
+                  unique_priority_deque<T, K, C, H, E> & deque2)
+{
+  deque1.swap(deque2);
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif
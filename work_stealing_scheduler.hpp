@@ -0,0 +1,324 @@
+/*----------------------------------------------------------------------------*\
+|   Copyright (C) 2012-2013 Nathaniel J. McClatchey                            |
+|   Released under the Boost Software License Version 1.0, which may be found  |
+| at http://www.boost.org/LICENSE_1_0.txt                                      |
+\*----------------------------------------------------------------------------*/
+
+/*! @file work_stealing_scheduler.hpp
+//  @author Nathaniel J. McClatchey, PhD
+//
+//    work_stealing_scheduler.hpp provides the class work_stealing_scheduler,
+//  a pool of threads, each of which owns a priority deque of tasks.
+//    A worker runs its own highest-priority task, from the max end of its
+//  deque. An idle worker steals half of another worker's tasks, the lowest-
+//  priority ones, from the min end (with pop_minimum_n). The owner and its
+//  thieves thus take from opposite ends, and a thief takes the tasks whose
+//  delay matters least.
+//  @par  Thread safety:
+//    All member functions except the destructor may be called from any
+//  thread, including from within tasks.
+//  @par Exception safety:
+//    If a task throws, the first such exception is rethrown by wait.
+*/
+
+#ifndef BOOST_CONTAINER_WORK_STEALING_SCHEDULER_HPP_
+#define BOOST_CONTAINER_WORK_STEALING_SCHEDULER_HPP_
+
+#ifndef __cplusplus
+#error work_stealing_scheduler.hpp requires a C++ compiler.
+#endif
+#if (__cplusplus < 201103L)
+#error work_stealing_scheduler.hpp requires C++11 (for std::thread).
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+//  Default task type (std::function).
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "priority_deque.hpp"
+
+namespace boost {
+namespace container {
+/// \cond false
+namespace work_stealing_internal {
+template <typename Priority, typename Task>
+struct job
+{
+  Priority priority;
+  uint64_t sequence;
+  Task task;
+};
+
+//  Of tasks with equal priority, the one submitted first is run first.
+template <typename Compare>
+struct job_compare
+{
+  explicit job_compare (Compare const & comp) : compare(comp) {}
+  template <typename Job>
+  bool operator() (Job const & lhs, Job const & rhs) const
+  {
+    if (compare(lhs.priority, rhs.priority))
+      return true;
+    if (compare(rhs.priority, lhs.priority))
+      return false;
+    return lhs.sequence > rhs.sequence;
+  }
+  Compare compare;
+};
+} //  Namespace work_stealing_internal
+/// \endcond
+
+//-------------------------Work-Stealing Scheduler Class-----------------------|
+/*! @brief Pool of threads running prioritized tasks, with work stealing.
+ *  @author Nathaniel McClatchey
+ *  @copyright Boost Software License Version 1.0
+ *  @param Priority Type of task priorities.
+ *  @param Task Type of tasks. Defaults to std::function<void()>. Must be
+ *  movable and callable with no arguments.
+ *  @param Compare Comparison of priorities. Tasks ordered later run first.
+ *  Defaults to std::less<Priority>.
+ *  @details Priorities are respected within each worker, not across the pool:
+ *  a worker may run a task while another worker holds one of higher priority.
+ *  Tasks submitted from within a task go to the submitting worker's deque;
+ *  others are dealt to the workers in turn.
+ *  @see priority_deque
+ */
+template <typename Priority, typename Task =::std::function<void()>,
+          typename Compare =::std::less<Priority> >
+class work_stealing_scheduler
+{
+  typedef work_stealing_internal::job<Priority, Task>                 job;
+  typedef work_stealing_internal::job_compare<Compare>                job_compare;
+//----------------------------------Public-------------------------------------|
+ public:
+//---------------------------------Typedefs------------------------------------|
+  typedef Priority                                    priority_type;
+  typedef Task                                        task_type;
+  typedef Compare                                     priority_compare;
+  typedef std::size_t                                 size_type;
+//-------------------------------Constructors----------------------------------|
+/** @brief Starts the workers.
+//  @param workers Number of worker threads. If 0, one per hardware thread.
+*/
+  explicit work_stealing_scheduler    (unsigned workers = 0,
+                                       Compare const & comp = Compare());
+/** @brief Stops the workers, once their current tasks are done.
+//  @details Tasks that have not started are discarded. Call wait first to
+//  run them.
+*/
+  ~work_stealing_scheduler            (void);
+  work_stealing_scheduler             (work_stealing_scheduler const &) =delete;
+  work_stealing_scheduler & operator= (work_stealing_scheduler const &) =delete;
+//----------------------------------Tasks--------------------------------------|
+/** @brief Submits a task.
+//  @par  Complexity:
+//    O(log n) - Logarithmic on the number of tasks held by one worker.
+*/
+  void                    submit      (priority_type const & priority,
+                                       task_type task);
+/** @brief Blocks until every submitted task has run.
+//  @details Must not be called from within a task. If any task threw, the
+//  first exception thrown is rethrown (once).
+*/
+  void                    wait        (void);
+//! @brief Returns the number of worker threads.
+  unsigned                workers     (void) const
+  {
+    return static_cast<unsigned>(workers_.size());
+  }
+//! @brief Returns the number of successful steals.
+  size_type               steals      (void) const { return steals_; }
+//! @brief Returns the number of tasks moved by steals.
+  size_type               stolen      (void) const { return stolen_; }
+//---------------------------------Private-------------------------------------|
+ private:
+  struct worker
+  {
+    std::mutex lock;
+    priority_deque<job, std::vector<job>, job_compare> tasks;
+    std::thread thread;
+    explicit worker (job_compare const & comp) : tasks(comp) {}
+  };
+//  The scheduler and worker that the calling thread belongs to, if any.
+  static std::pair<work_stealing_scheduler *, unsigned> & current (void)
+  {
+    static thread_local std::pair<work_stealing_scheduler *, unsigned>
+      owner (nullptr, 0);
+    return owner;
+  }
+  void run      (unsigned index);
+  bool take     (unsigned index, std::vector<job> & batch);
+  bool steal    (unsigned index, std::vector<job> & batch);
+  void execute  (job & next);
+
+  std::vector<std::unique_ptr<worker> > workers_;
+  std::mutex idle_lock_;
+  std::condition_variable idle_, done_;
+  std::atomic<size_type> queued_, unfinished_, sleepers_;
+  std::atomic<size_type> steals_, stolen_;
+  std::atomic<uint64_t> sequence_;
+  std::atomic<unsigned> next_;
+  std::atomic<bool> stop_;
+  std::exception_ptr error_;
+};
+
+template <typename P, typename T, typename C>
+work_stealing_scheduler<P, T, C>::work_stealing_scheduler (unsigned workers,
+                                                           C const & comp)
+  : queued_(0), unfinished_(0), sleepers_(0), steals_(0), stolen_(0),
+    sequence_(0), next_(0), stop_(false)
+{
+  if (workers == 0)
+    workers = std::thread::hardware_concurrency();
+  if (workers == 0)
+    workers = 1;
+  for (unsigned i = 0; i < workers; ++i)
+    workers_.push_back(std::unique_ptr<worker>(new worker(job_compare(comp))));
+//  Every worker exists before any thread may try to steal from it.
+  for (unsigned i = 0; i < workers; ++i)
+    workers_[i]->thread = std::thread(&work_stealing_scheduler::run, this, i);
+}
+
+template <typename P, typename T, typename C>
+work_stealing_scheduler<P, T, C>::~work_stealing_scheduler (void)
+{
+  {
+    std::lock_guard<std::mutex> lock (idle_lock_);
+    stop_ = true;
+  }
+  idle_.notify_all();
+  for (std::size_t i = 0; i < workers_.size(); ++i)
+    workers_[i]->thread.join();
+}
+
+template <typename P, typename T, typename C>
+void work_stealing_scheduler<P, T, C>::submit (priority_type const & priority,
+                                               task_type task)
+{
+  std::pair<work_stealing_scheduler *, unsigned> const & owner = current();
+  const unsigned index = (owner.first == this) ? owner.second
+                         : (next_++ % static_cast<unsigned>(workers_.size()));
+  job added = { priority, sequence_++, std::move(task) };
+  ++unfinished_;
+  {
+    std::lock_guard<std::mutex> lock (workers_[index]->lock);
+    workers_[index]->tasks.push(std::move(added));
+  }
+  ++queued_;
+//  A sleeper counts itself before checking queued_, so it cannot be missed.
+  if (sleepers_ > 0)
+  {
+    std::lock_guard<std::mutex> lock (idle_lock_);
+    idle_.notify_one();
+  }
+}
+
+template <typename P, typename T, typename C>
+void work_stealing_scheduler<P, T, C>::wait (void)
+{
+  std::unique_lock<std::mutex> lock (idle_lock_);
+  done_.wait(lock, [this]() { return unfinished_ == 0; });
+  if (error_)
+  {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename P, typename T, typename C>
+void work_stealing_scheduler<P, T, C>::run (unsigned index)
+{
+  current() = std::make_pair(this, index);
+  std::vector<job> batch;
+  while (!stop_)
+  {
+    if (take(index, batch) || steal(index, batch))
+    {
+      execute(batch.front());
+      batch.clear();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock (idle_lock_);
+    ++sleepers_;
+//  Tasks that are queued but could not be taken are being taken by others.
+    if (queued_ == 0)
+      idle_.wait(lock, [this]() { return stop_ || (queued_ > 0); });
+    --sleepers_;
+    lock.unlock();
+    std::this_thread::yield();
+  }
+}
+
+template <typename P, typename T, typename C>
+bool work_stealing_scheduler<P, T, C>::take (unsigned index,
+                                             std::vector<job> & batch)
+{
+  worker & self = *workers_[index];
+  std::lock_guard<std::mutex> lock (self.lock);
+  if (self.tasks.empty())
+    return false;
+  self.tasks.pop_maximum_n(1, std::back_inserter(batch));
+  --queued_;
+  return true;
+}
+
+template <typename P, typename T, typename C>
+bool work_stealing_scheduler<P, T, C>::steal (unsigned index,
+                                              std::vector<job> & batch)
+{
+  const unsigned count = static_cast<unsigned>(workers_.size());
+  for (unsigned i = 1; i < count; ++i)
+  {
+    worker & victim = *workers_[(index + i) % count];
+    {
+      std::lock_guard<std::mutex> lock (victim.lock);
+      victim.tasks.pop_minimum_n((victim.tasks.size() + 1) / 2,
+                                 std::back_inserter(batch));
+    }
+    if (batch.empty())
+      continue;
+    ++steals_;
+    stolen_ += batch.size();
+    {
+      worker & self = *workers_[index];
+      std::lock_guard<std::mutex> lock (self.lock);
+      self.tasks.insert(std::make_move_iterator(batch.begin()),
+                        std::make_move_iterator(batch.end()));
+    }
+    batch.clear();
+    return take(index, batch);
+  }
+  return false;
+}
+
+template <typename P, typename T, typename C>
+void work_stealing_scheduler<P, T, C>::execute (job & next)
+{
+  try {
+    next.task();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock (idle_lock_);
+    if (!error_)
+      error_ = std::current_exception();
+  }
+  if (--unfinished_ == 0)
+  {
+    std::lock_guard<std::mutex> lock (idle_lock_);
+    done_.notify_all();
+  }
+}
+
+} //  Namespace boost::container
+} //  Namespace boost
+
+#endif